@@ -0,0 +1,90 @@
+#ifndef CIRCUITC_bench_included
+#define CIRCUITC_bench_included
+
+#include "stdio.h"              // snprintf, printf
+#include "stdlib.h"             // dynamic memory ops
+#include "stdint.h"             // types
+#include "string.h"             // memcpy
+#include "time.h"               // clock_gettime
+
+// shared by the benchmark drivers in this directory: a clock, a seeded generator, and a generator of CircuitC source.
+// every driver is a single translation unit built against the headers in ../lexer, e.g.
+//      cc -O2 -I../lexer bench_tokeniser.c -o bench_tokeniser -lpthread -lm
+// timings are the fastest of a number of runs, as the slower ones only tell how busy the machine was.
+
+#define CIRCUITC_BENCH_RUNS     7
+
+// seconds since some fixed point
+double CIRCUITC_bench_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+}
+
+// xorshift64; same seed, same numbers, so that every run of a driver measures the same thing
+uint64_t CIRCUITC_bench_state = 88172645463325252ULL;
+
+uint64_t CIRCUITC_bench_random(){
+    CIRCUITC_bench_state ^= CIRCUITC_bench_state << 13;
+    CIRCUITC_bench_state ^= CIRCUITC_bench_state >> 7;
+    CIRCUITC_bench_state ^= CIRCUITC_bench_state << 17;
+    return CIRCUITC_bench_state;
+}
+
+// times body run CIRCUITC_BENCH_RUNS times, keeps the fastest run in seconds
+#define CIRCUITC_BENCH_MIN(seconds, body) do{                                   \
+    (seconds) = 1e300;                                                          \
+    for(int bench_run = 0; bench_run < CIRCUITC_BENCH_RUNS; bench_run++){       \
+        const double bench_start = CIRCUITC_bench_now();                        \
+        body;                                                                   \
+        const double bench_time = CIRCUITC_bench_now() - bench_start;           \
+        if(bench_time < (seconds)) (seconds) = bench_time;                      \
+    }                                                                           \
+} while(0)
+
+// sets count to how many times body has to run for the runs together to take some tens of milliseconds, whatever a run costs;
+// for work whose cost is known only once it is run, such as code from an earlier commit
+#define CIRCUITC_BENCH_CALIBRATE(count, body) do{                               \
+    for((count) = 1;; (count) *= 2){                                            \
+        const double bench_start = CIRCUITC_bench_now();                        \
+        for(uint64_t bench_i = 0; bench_i < (count); bench_i++){ body; }        \
+        if(CIRCUITC_bench_now() - bench_start > 0.05) break;                    \
+    }                                                                           \
+} while(0)
+
+// keeps the compiler from throwing away results that are never looked at
+volatile uint64_t CIRCUITC_bench_sink;
+
+// about length bytes of CircuitC source that lexes without errors: wire declarations, names, decimal/hex/binary values,
+// whitespace, newlines and both kinds of comments, in roughly the proportions of hand-written code. to be freed by user.
+char* CIRCUITC_bench_source(const size_t length, size_t* source_length){
+    char* source = malloc(length + 256);
+    size_t size = 0;
+
+    while(size < length){
+        char piece[128];
+        int piece_length;
+
+        switch(CIRCUITC_bench_random()%16){
+            case 0: case 1: case 2:     piece_length = snprintf(piece, sizeof(piece), "w "); break;
+            case 3: case 4: case 5:
+            case 6:                     piece_length = snprintf(piece, sizeof(piece), "wire%u ", (unsigned)(CIRCUITC_bench_random()%4096)); break;
+            case 7: case 8:             piece_length = snprintf(piece, sizeof(piece), "%u ", (unsigned)CIRCUITC_bench_random()); break;
+            case 9:                     piece_length = snprintf(piece, sizeof(piece), "0x%llx ", (unsigned long long)CIRCUITC_bench_random()); break;
+            case 10:                    piece_length = snprintf(piece, sizeof(piece), "0b%u%u%u%u ", (unsigned)(CIRCUITC_bench_random()&1), 1U, 0U, (unsigned)(CIRCUITC_bench_random()&1)); break;
+            case 11: case 12:           piece_length = snprintf(piece, sizeof(piece), "\n    "); break;
+            case 13:                    piece_length = snprintf(piece, sizeof(piece), "\t"); break;
+            case 14:                    piece_length = snprintf(piece, sizeof(piece), "// wire w%u is driven below\n", (unsigned)(CIRCUITC_bench_random()%4096)); break;
+            default:                    piece_length = snprintf(piece, sizeof(piece), "/* carry chain\n   of adder %u */\n", (unsigned)(CIRCUITC_bench_random()%64)); break;
+        }
+
+        memcpy(source + size, piece, (size_t)piece_length);
+        size += (size_t)piece_length;
+    }
+
+    source[size] = '\x00';
+    if(source_length) *source_length = size;
+    return source;
+}
+
+#endif
@@ -0,0 +1,102 @@
+// calls to malloc, calloc and realloc made by the lexer and by the decimal parser, with and without an arena, along with the time they take,
+// and by turning the values in a token table's literal pool into NOAHZK_variable_width_t's.
+//      cc -O2 -I../lexer bench_allocations.c -o bench_allocations -lpthread -lm
+//      ./bench_allocations [kilobytes of source]
+// everything in ../lexer lives in headers, so defining malloc, calloc and realloc as macros before including them routes every call they make
+// through the counters below.
+
+#include "bench.h"              // timing, source generator
+
+uint64_t CIRCUITC_bench_allocations;
+
+void* CIRCUITC_bench_malloc(const size_t size){
+    CIRCUITC_bench_allocations++;
+    return malloc(size);
+}
+
+void* CIRCUITC_bench_calloc(const size_t count, const size_t size){
+    CIRCUITC_bench_allocations++;
+    return calloc(count, size);
+}
+
+void* CIRCUITC_bench_realloc(void* allocation, const size_t size){
+    CIRCUITC_bench_allocations++;
+    return realloc(allocation, size);
+}
+
+#define malloc(size)            CIRCUITC_bench_malloc(size)
+#define calloc(count, size)     CIRCUITC_bench_calloc(count, size)
+#define realloc(ptr, size)      CIRCUITC_bench_realloc(ptr, size)
+
+#include "lexer.h"              // lexer, decimal parser, arenas
+#include "token_table.h"        // literal pool
+
+// prints the fastest of a number of runs of body, along with the calls the last of them made, per each of 'per' things done by a run.
+// time is printed in seconds times scale, as unit.
+#define CIRCUITC_BENCH_COUNTED(name, per, scale, unit, body) do{                                                                       \
+    double counted_seconds;                                                                                                     \
+    uint64_t counted_calls = 0;                                                                                                 \
+    CIRCUITC_BENCH_MIN(counted_seconds, counted_calls = CIRCUITC_bench_allocations; body; counted_calls = CIRCUITC_bench_allocations - counted_calls); \
+    printf("    %-26s %10.1f %s  %9.1f calls\n", name, counted_seconds*(scale)/(double)(per), unit, (double)counted_calls/(double)(per));  \
+} while(0)
+
+int main(int argc, char** argv){
+    const size_t kilobytes = argc > 1? (size_t)atoi(argv[1]): 1024;
+    size_t length;
+    char* source = CIRCUITC_bench_source(kilobytes << 10, &length);
+    CIRCUITC_lexer_error_t error_code;
+    CIRCUITC_arena_t arena; CIRCUITC_arena_init(&arena);
+
+    printf("lexing %zu bytes of generated source, per run:\n", length);
+    CIRCUITC_BENCH_COUNTED("no arena", 1, 1e3, "ms", free(CIRCUITC_lexer(source, &error_code)));
+    if(error_code != CIRCUITC_LEXER_ERROR_NONE){ printf("generated source doesn't lex\n"); free(source); return 1; }
+// the arena keeps its newest block across resets, so runs after the first go to malloc only for what outgrows it
+    CIRCUITC_BENCH_COUNTED("arena, reset after", 1, 1e3, "ms", CIRCUITC_lexer_with_arena(source, CIRCUITC_lexer_copy_names, &arena, &error_code); CIRCUITC_arena_reset(&arena));
+
+    printf("decimal values, per value:\n");
+    for(size_t digits = 20; digits <= 300; digits *= 15){
+        char string[300];
+        for(size_t i = 0; i < digits; i++) string[i] = (char)('0' + CIRCUITC_bench_random()%10);
+        char name[32];
+
+        CIRCUITC_array_t array; CIRCUITC_array_init(&array);
+        uint64_t values;
+        CIRCUITC_BENCH_CALIBRATE(values, array.size = 0; CIRCUITC_lexer_string_decimal_to_integer(&array, string, digits));
+        snprintf(name, sizeof(name), "%zu digits, no arena", digits);
+        CIRCUITC_BENCH_COUNTED(name, values, 1e9, "ns", for(uint64_t i = 0; i < values; i++){ array.size = 0; CIRCUITC_lexer_string_decimal_to_integer(&array, string, digits); });
+        CIRCUITC_array_destroy(&array, CIRCUITC_array_keep_ctx);
+
+        CIRCUITC_array_init_from(&array, &arena);
+        CIRCUITC_BENCH_CALIBRATE(values, array.size = 0; CIRCUITC_lexer_string_decimal_to_integer(&array, string, digits));
+        snprintf(name, sizeof(name), "%zu digits, arena", digits);
+        CIRCUITC_BENCH_COUNTED(name, values, 1e9, "ns", for(uint64_t i = 0; i < values; i++){ array.size = 0; CIRCUITC_lexer_string_decimal_to_integer(&array, string, digits); });
+        CIRCUITC_arena_reset(&arena);
+    }
+
+// every value is made into a variable-width value and has one added to it, as folding constants would
+    CIRCUITC_token_table_t table;
+    CIRCUITC_lexer_table(source, &table, &error_code);
+    NOAHZK_variable_width_t one; NOAHZK_variable_width_init_constant(&one, 1);
+    uint64_t small_literals = 0;
+    for(uint32_t i = 0; i < table.number_of_literals; i++){
+        size_t literal_length;
+        CIRCUITC_token_table_literal(&table, i, &literal_length);
+        small_literals += literal_length <= 16;
+    }
+    printf("%u literals in the token table, %llu of them at most 128 bits, per literal:\n", table.number_of_literals, (unsigned long long)small_literals);
+    CIRCUITC_BENCH_COUNTED("to variable width, add", table.number_of_literals, 1e9, "ns", for(uint32_t i = 0; i < table.number_of_literals; i++){
+        size_t literal_length;
+        const void* literal = CIRCUITC_token_table_literal(&table, i, &literal_length);
+        NOAHZK_variable_width_t value; NOAHZK_variable_width_init_arr(&value, (void*)literal, literal_length);
+        NOAHZK_variable_width_add_and_resize(&value, &value, &one);
+        NOAHZK_variable_width_destroy(&value, NOAHZK_variable_width_keep_ptr);
+    });
+    NOAHZK_variable_width_destroy(&one, NOAHZK_variable_width_keep_ptr);
+    CIRCUITC_token_table_destroy(&table, CIRCUITC_token_table_keep_ctx);
+
+    printf("arena: %llu allocations served from %llu blocks\n", (unsigned long long)arena.stats.allocations, (unsigned long long)arena.stats.blocks);
+
+    CIRCUITC_arena_destroy(&arena, CIRCUITC_arena_keep_ctx);
+    free(source);
+    return 0;
+}
@@ -0,0 +1,94 @@
+// batched add, mul and compare (scalar, AVX2 and AVX-512 versions), against calling the per-operand ops once per operand.
+//      cc -O2 -I../lexer bench_batch.c -o bench_batch -lpthread -lm
+//      ./bench_batch [operands]
+// the per-operand loops work on operands laid out one after the other as byte arrays; the batches on the same operands as structs of arrays.
+// versions the CPU doesn't support are left out. there is no per-operand compare in the library, so compare is only timed batched.
+
+#include "bench.h"              // timing
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library, batches
+
+typedef struct{
+    const char* name;
+    NOAHZK_variable_width_batch_t batch;
+} CIRCUITC_bench_batch_version_t;
+
+void CIRCUITC_bench_fill(uint8_t* bytes, const uint64_t width){
+    for(uint64_t i = 0; i < width; i++) bytes[i] = (uint8_t)CIRCUITC_bench_random();
+}
+
+int main(int argc, char** argv){
+    const uint64_t count = argc > 1? (uint64_t)atoll(argv[1]): 1000;
+    CIRCUITC_bench_batch_version_t versions[3];
+    size_t number_of_versions = 0;
+
+    versions[number_of_versions++] = (CIRCUITC_bench_batch_version_t){ "scalar", { NOAHZK_variable_width_batch_add_scalar, NOAHZK_variable_width_batch_sub_scalar, NOAHZK_variable_width_batch_mul_scalar, NOAHZK_variable_width_batch_compare_scalar } };
+#ifdef NOAHZK_BATCH_X86_64
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        versions[number_of_versions++] = (CIRCUITC_bench_batch_version_t){ "avx2", { NOAHZK_variable_width_batch_add_avx2, NOAHZK_variable_width_batch_sub_avx2, NOAHZK_variable_width_batch_mul_avx2, NOAHZK_variable_width_batch_compare_avx2 } };
+    if(__builtin_cpu_supports("avx512f"))
+        versions[number_of_versions++] = (CIRCUITC_bench_batch_version_t){ "avx512", { NOAHZK_variable_width_batch_add_avx512, NOAHZK_variable_width_batch_sub_avx512, NOAHZK_variable_width_batch_mul_avx512, NOAHZK_variable_width_batch_compare_avx512 } };
+#endif
+
+    printf("%llu operands, ns per operand:\n", (unsigned long long)count);
+    printf("    %-4s %6s  %10s", "op", "bits", "per-operand");
+    for(size_t v = 0; v < number_of_versions; v++) printf("  %8s", versions[v].name);
+    printf("\n");
+
+    for(uint64_t bits = 64; bits <= 1024; bits *= 2){
+        const uint64_t width = bits/BITS_IN_UINT8_T, words = NOAHZK_GET_WORD_WIDTH_FROM_INT(width);
+        uint8_t* rs0 = malloc(count*width);
+        uint8_t* rs1 = malloc(count*width);
+        uint8_t* dst = malloc(2*count*width);
+        NOAHZK_word_t* batch0 = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(count*words));
+        NOAHZK_word_t* batch1 = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(count*words));
+        NOAHZK_word_t* batch_dst = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*count*words));
+        int8_t* order = malloc(count);
+        CIRCUITC_bench_fill(rs0, count*width);
+        CIRCUITC_bench_fill(rs1, count*width);
+// half of the pairs are equal save for their lowest byte, so that compare goes through every word of them
+        for(uint64_t j = 0; j < count; j += 2) memcpy(rs1 + j*width + 1, rs0 + j*width + 1, width - 1);
+        for(uint64_t j = 0; j < count; j++){
+            NOAHZK_variable_width_batch_set_byte(batch0, words, count, j, rs0 + j*width, width);
+            NOAHZK_variable_width_batch_set_byte(batch1, words, count, j, rs1 + j*width, width);
+        }
+// enough repetitions per run that a run takes some milliseconds
+        const uint64_t repetitions = NOAHZK_MAX((uint64_t)1, ((uint64_t)1 << 22)/(count*words*words));
+        const double per_operand = 1e9/(double)(repetitions*count);
+        double seconds;
+
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t r = 0; r < repetitions; r++) for(uint64_t j = 0; j < count; j++) NOAHZK_variable_width_add_byte(dst + j*width, rs0 + j*width, rs1 + j*width, width, width, width));
+        printf("    %-4s %6llu  %10.2f", "add", (unsigned long long)bits, seconds*per_operand);
+        for(size_t v = 0; v < number_of_versions; v++){
+            CIRCUITC_BENCH_MIN(seconds, for(uint64_t r = 0; r < repetitions; r++) versions[v].batch.add(batch_dst, batch0, batch1, words, count));
+            printf("  %8.2f", seconds*per_operand);
+        }
+        printf("\n");
+
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t r = 0; r < repetitions; r++) for(uint64_t j = 0; j < count; j++) NOAHZK_variable_width_mul_byte(dst + 2*j*width, rs0 + j*width, rs1 + j*width, width, width));
+        printf("    %-4s %6llu  %10.2f", "mul", (unsigned long long)bits, seconds*per_operand);
+        for(size_t v = 0; v < number_of_versions; v++){
+            CIRCUITC_BENCH_MIN(seconds, for(uint64_t r = 0; r < repetitions; r++) versions[v].batch.mul(batch_dst, batch0, batch1, words, count));
+            printf("  %8.2f", seconds*per_operand);
+        }
+        printf("\n");
+
+        printf("    %-4s %6llu  %10s", "cmp", (unsigned long long)bits, "-");
+        for(size_t v = 0; v < number_of_versions; v++){
+            CIRCUITC_BENCH_MIN(seconds, for(uint64_t r = 0; r < repetitions; r++) versions[v].batch.compare(order, batch0, batch1, words, count));
+            printf("  %8.2f", seconds*per_operand);
+        }
+        printf("\n");
+
+        free(rs0);
+        free(rs1);
+        free(dst);
+        free(batch0);
+        free(batch1);
+        free(batch_dst);
+        free(order);
+    }
+
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
@@ -0,0 +1,123 @@
+// division, modular multiplication and division by a single word.
+//      cc -O2 -I../lexer bench_div.c -o bench_div -lpthread -lm
+//      ./bench_div
+// - 2n-by-n bit division through Knuth's algorithm D (NOAHZK_variable_width_divrem_byte) and through constant-time binary long division
+//   (NOAHZK_variable_width_divrem_ct_byte)
+// - products modulo the same modulus, by multiplying then dividing, by multiplying then Barrett-reducing, and by Montgomery multiplication
+// - division by a single word through its reciprocal (NOAHZK_variable_width_divrem_1_words), and through the compiler's double-word division
+
+#include "bench.h"              // timing
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+void CIRCUITC_bench_fill(uint8_t* bytes, const uint64_t width){
+    for(uint64_t i = 0; i < width; i++) bytes[i] = (uint8_t)CIRCUITC_bench_random();
+}
+
+// enough calls per run that a run takes some milliseconds, given roughly how many word operations a call takes
+uint64_t CIRCUITC_bench_calls(const uint64_t work){
+    return NOAHZK_MAX((uint64_t)1, ((uint64_t)1 << 24)/(work + 1));
+}
+
+// quotient of src (width words) by d, a word at a time through the compiler's division; returns the remainder
+NOAHZK_word_t CIRCUITC_bench_divrem_1_dword(NOAHZK_word_t* quot, const NOAHZK_word_t* src, const uint64_t width, const NOAHZK_word_t d){
+    NOAHZK_dword_t rem = 0;
+
+    for(uint64_t i = width; i-- > 0;){
+        const NOAHZK_dword_t dividend = rem << BITS_IN_NOAHZK_WORD | src[i];
+        quot[i] = (NOAHZK_word_t)(dividend/d);
+        rem = dividend%d;
+    }
+
+    return (NOAHZK_word_t)rem;
+}
+
+int main(){
+    double seconds;
+
+    printf("2n-by-n bit division, ns per call:\n");
+    printf("    %12s  %12s  %12s\n", "bits", "knuth d", "binary");
+    for(uint64_t bits = 256; bits <= 16384; bits *= 4){
+        const uint64_t width = bits/BITS_IN_UINT8_T;
+        uint8_t* dividend = malloc(2*width);
+        uint8_t* divisor = malloc(width);
+        uint8_t* quot = malloc(2*width);
+        uint8_t* rem = malloc(width);
+        CIRCUITC_bench_fill(dividend, 2*width);
+        CIRCUITC_bench_fill(divisor, width);
+        divisor[width - 1] |= 1;
+
+        const uint64_t words = NOAHZK_GET_WORD_WIDTH_FROM_INT(width);
+        uint64_t calls = CIRCUITC_bench_calls(words*words);
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_divrem_byte(quot, rem, dividend, divisor, 2*width, width));
+        const double knuth_ns = seconds*1e9/(double)calls;
+// binary long division takes a pass over the divisor per bit of the dividend
+        calls = CIRCUITC_bench_calls(2*bits*words*8);
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_divrem_ct_byte(quot, rem, dividend, divisor, 2*width, width));
+        printf("    %5llu/%-6llu  %12.0f  %12.0f\n", (unsigned long long)(2*bits), (unsigned long long)bits, knuth_ns, seconds*1e9/(double)calls);
+
+        free(dividend);
+        free(divisor);
+        free(quot);
+        free(rem);
+    }
+
+    printf("products modulo an odd modulus, ns per product:\n");
+    printf("    %8s  %12s  %14s  %12s\n", "bits", "mul+mod", "mul+barrett", "montgomery");
+    for(uint64_t bits = 256; bits <= 4096; bits *= 4){
+        const uint64_t width = bits/BITS_IN_UINT8_T;
+        uint8_t* modulus = malloc(width);
+        uint8_t* rs0 = malloc(width);
+        uint8_t* rs1 = malloc(width);
+        uint8_t* product = malloc(2*width);
+        uint8_t* dst = malloc(width);
+        CIRCUITC_bench_fill(modulus, width);
+        CIRCUITC_bench_fill(rs0, width);
+        CIRCUITC_bench_fill(rs1, width);
+// operands below the modulus
+        modulus[0] |= 1;
+        modulus[width - 1] |= 0x80;
+        rs0[width - 1] &= 0x7f;
+        rs1[width - 1] &= 0x7f;
+
+        NOAHZK_barrett_ctx_t barrett; NOAHZK_variable_width_barrett_init(&barrett, modulus, width);
+        NOAHZK_montgomery_ctx_t montgomery; NOAHZK_variable_width_montgomery_init(&montgomery, modulus, width);
+        const uint64_t words = NOAHZK_GET_WORD_WIDTH_FROM_INT(width);
+        const uint64_t calls = CIRCUITC_bench_calls(2*words*words);
+
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++){ NOAHZK_variable_width_mul_byte(product, rs0, rs1, width, width); NOAHZK_variable_width_mod_byte(dst, product, modulus, 2*width, width); });
+        const double mod_ns = seconds*1e9/(double)calls;
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++){ NOAHZK_variable_width_mul_byte(product, rs0, rs1, width, width); NOAHZK_variable_width_barrett_reduce_byte(&barrett, dst, product, 2*width); });
+        const double barrett_ns = seconds*1e9/(double)calls;
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_montgomery_mul_byte(&montgomery, dst, rs0, rs1));
+        printf("    %8llu  %12.0f  %14.0f  %12.0f\n", (unsigned long long)bits, mod_ns, barrett_ns, seconds*1e9/(double)calls);
+
+        NOAHZK_variable_width_barrett_destroy(&barrett, NOAHZK_variable_width_keep_ptr);
+        NOAHZK_variable_width_montgomery_destroy(&montgomery, NOAHZK_variable_width_keep_ptr);
+        free(modulus);
+        free(rs0);
+        free(rs1);
+        free(product);
+        free(dst);
+    }
+
+    printf("division by one word, ns per call:\n");
+    printf("    %8s  %12s  %12s\n", "words", "reciprocal", "dword '/'");
+    for(uint64_t words = 4; words <= 1024; words *= 16){
+        NOAHZK_word_t* src = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(words));
+        NOAHZK_word_t* quot = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(words));
+        CIRCUITC_bench_fill((uint8_t*)src, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(words));
+        const NOAHZK_word_t d = (NOAHZK_word_t)CIRCUITC_bench_random() | 1;
+        const uint64_t calls = CIRCUITC_bench_calls(16*words);
+
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += NOAHZK_variable_width_divrem_1_words(quot, src, words, d));
+        const double reciprocal_ns = seconds*1e9/(double)calls;
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += CIRCUITC_bench_divrem_1_dword(quot, src, words, d));
+        printf("    %8llu  %12.0f  %12.0f\n", (unsigned long long)words, reciprocal_ns, seconds*1e9/(double)calls);
+
+        free(src);
+        free(quot);
+    }
+
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
@@ -0,0 +1,59 @@
+// CIRCUITC_lexer, which lexes into a string of tokens, against CIRCUITC_lexer_table, which lexes into a token table.
+//      cc -O2 -I../lexer bench_lexer.c -o bench_lexer -lpthread -lm
+//      ./bench_lexer [megabytes]
+// over three sources: bench.h's generated source; short names one per line, where interning names is most of the work;
+// and the same with every third line the keyword w, which is looked up as a name would be.
+
+#include "bench.h"              // timing, source generator
+#include "lexer.h"              // string of tokens
+#include "token_table.h"        // token table
+
+// about length bytes of names, one per line, drawn from 65536 of them so that most are seen more than once. to be freed by user.
+// if keywords is set, every third line is the keyword w instead.
+char* CIRCUITC_bench_names(const size_t length, const bool keywords, size_t* source_length){
+    char* source = malloc(length + 32);
+    size_t size = 0;
+
+    for(size_t line = 0; size < length; line++){
+        if(keywords && line%3 == 2) size += (size_t)snprintf(source + size, 32, "w\n");
+        else size += (size_t)snprintf(source + size, 32, "name%u\n", (unsigned)(CIRCUITC_bench_random()%65536));
+    }
+
+    if(source_length) *source_length = size;
+    return source;
+}
+
+// lexes source both ways, prints MB/s of each
+int CIRCUITC_bench_lexer_case(const char* name, char* source, const size_t length){
+    CIRCUITC_lexer_error_t error_code;
+    CIRCUITC_token_table_t table;
+    double string_seconds, table_seconds;
+
+    CIRCUITC_BENCH_MIN(string_seconds, free(CIRCUITC_lexer(source, &error_code)));
+    if(error_code != CIRCUITC_LEXER_ERROR_NONE) return 1;
+    CIRCUITC_BENCH_MIN(table_seconds, CIRCUITC_lexer_table(source, &table, &error_code); CIRCUITC_token_table_destroy(&table, CIRCUITC_token_table_keep_ctx));
+
+    printf("%-10s %9zu bytes   string of tokens %7.1f MB/s   token table %7.1f MB/s\n", name, length, (double)length/string_seconds/1e6, (double)length/table_seconds/1e6);
+    return 0;
+}
+
+int main(int argc, char** argv){
+    const size_t megabytes = argc > 1? (size_t)atoi(argv[1]): 32;
+    size_t length;
+    int failed;
+
+    char* source = CIRCUITC_bench_source(megabytes << 20, &length);
+    failed = CIRCUITC_bench_lexer_case("generated", source, length);
+    free(source);
+
+    source = CIRCUITC_bench_names(megabytes << 20, false, &length);
+    failed |= CIRCUITC_bench_lexer_case("names", source, length);
+    free(source);
+
+    source = CIRCUITC_bench_names(megabytes << 20, true, &length);
+    failed |= CIRCUITC_bench_lexer_case("keywords", source, length);
+    free(source);
+
+    if(failed) printf("source doesn't lex\n");
+    return failed;
+}
@@ -0,0 +1,47 @@
+// CIRCUITC_lexer_parallel from 1 to N threads, against CIRCUITC_lexer, over generated source.
+//      cc -O2 -I../lexer bench_lexer_parallel.c -o bench_lexer_parallel -lpthread -lm
+//      ./bench_lexer_parallel [megabytes] [max threads]
+// max threads defaults to the number of online CPUs. the pass that splits the source into pieces is timed on its own too, as it is the part that doesn't scale.
+
+#include "unistd.h"             // sysconf
+#include "bench.h"              // timing, source generator
+#include "lexer.h"              // sequential lexer
+#include "lexer_parallel.h"     // parallel lexer
+
+int main(int argc, char** argv){
+    const size_t megabytes = argc > 1? (size_t)atoi(argv[1]): 64;
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    const size_t max_threads = argc > 2? (size_t)atoi(argv[2]): (size_t)(cpus > 0? cpus: 1);
+    size_t length;
+    char* source = CIRCUITC_bench_source(megabytes << 20, &length);
+    CIRCUITC_lexer_error_t error_code;
+    double seconds;
+
+    printf("source: %zu bytes, %ld cpus online\n", length, cpus);
+
+    CIRCUITC_BENCH_MIN(seconds, free(CIRCUITC_lexer_with_names(source, CIRCUITC_lexer_reference_names, &error_code)));
+    if(error_code != CIRCUITC_LEXER_ERROR_NONE){ printf("generated source doesn't lex\n"); free(source); return 1; }
+    const double sequential_seconds = seconds;
+    printf("sequential:        %8.1f MB/s\n", (double)length/seconds/1e6);
+// the split pass on its own, as many pieces as the most threads would ask for
+    {
+        CIRCUITC_tokeniser_t tokeniser; CIRCUITC_tokeniser_init(&tokeniser);
+        const size_t number_of_pieces = max_threads*CIRCUITC_LEXER_PARALLEL_PIECES_PER_THREAD;
+        char** starts = malloc(number_of_pieces*sizeof(*starts));
+        size_t pieces_found = 0;
+
+        CIRCUITC_BENCH_MIN(seconds, pieces_found = CIRCUITC_lexer_parallel_split(source, length, starts, number_of_pieces, &tokeniser));
+        printf("split (%3zu pieces): %7.1f MB/s\n", pieces_found, (double)length/seconds/1e6);
+
+        free(starts);
+        CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
+    }
+
+    for(size_t threads = 1; threads <= max_threads; threads++){
+        CIRCUITC_BENCH_MIN(seconds, free(CIRCUITC_lexer_parallel(source, CIRCUITC_lexer_reference_names, threads, &error_code)));
+        printf("%3zu threads:       %8.1f MB/s  %5.2fx sequential\n", threads, (double)length/seconds/1e6, sequential_seconds/seconds);
+    }
+
+    free(source);
+    return 0;
+}
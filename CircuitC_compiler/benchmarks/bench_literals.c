@@ -0,0 +1,69 @@
+// turning decimal values of 20 to 100000 digits, and hex and binary values of 16 to 65536 digits, into integers.
+//      cc -O2 -I../lexer bench_literals.c -o bench_literals -lpthread -lm
+//      ./bench_literals
+// values are converted both through CIRCUITC_lexer_string_decimal_to_integer, as the lexer does, and through CIRCUITC_lexer_decimal_to_limbs alone,
+// which converts a chunk of digits at a time into an integer sized by CIRCUITC_lexer_decimal_width.
+// hex and binary values are converted through CIRCUITC_lexer_string_hex_to_integer and CIRCUITC_lexer_string_binary_to_integer, prefix left out.
+
+#include "bench.h"              // timing
+#include "lexer.h"              // value parsing
+
+int main(){
+    const size_t lengths[] = { 20, 300, 1000, 10000, 100000 };
+    double seconds;
+
+    printf("decimal values, ns per value:\n");
+    printf("    %8s  %16s  %16s\n", "digits", "chunk at a time", "lexer");
+    for(size_t l = 0; l < sizeof(lengths)/sizeof(*lengths); l++){
+        const size_t digits = lengths[l];
+        char* string = malloc(digits + 1);
+        for(size_t i = 0; i < digits; i++) string[i] = (char)('0' + CIRCUITC_bench_random()%10);
+        string[digits] = '\x00';
+        uint64_t values;
+
+        const uint64_t width = CIRCUITC_lexer_decimal_width(digits);
+        NOAHZK_limb_t* integer = malloc(NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width));
+        CIRCUITC_BENCH_CALIBRATE(values, CIRCUITC_lexer_decimal_to_limbs(integer, width, string, digits));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < values; i++) CIRCUITC_lexer_decimal_to_limbs(integer, width, string, digits));
+        const double chunked_ns = seconds*1e9/(double)values;
+
+        CIRCUITC_array_t array; CIRCUITC_array_init(&array);
+        CIRCUITC_BENCH_CALIBRATE(values, array.size = 0; CIRCUITC_lexer_string_decimal_to_integer(&array, string, digits));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < values; i++){ array.size = 0; CIRCUITC_lexer_string_decimal_to_integer(&array, string, digits); });
+        printf("    %8zu  %16.0f  %16.0f\n", digits, chunked_ns, seconds*1e9/(double)values);
+
+        CIRCUITC_array_destroy(&array, CIRCUITC_array_keep_ctx);
+        free(integer);
+        free(string);
+    }
+
+    const size_t based_lengths[] = { 16, 64, 4096, 65536 };
+    printf("hex and binary values, ns per value:\n");
+    printf("    %8s  %12s  %12s\n", "digits", "hex", "binary");
+    for(size_t l = 0; l < sizeof(based_lengths)/sizeof(*based_lengths); l++){
+        const size_t digits = based_lengths[l];
+        char* hex = malloc(digits + 1);
+        char* binary = malloc(digits + 1);
+        for(size_t i = 0; i < digits; i++){
+            hex[i] = "0123456789abcdefABCDEF"[CIRCUITC_bench_random()%22];
+            binary[i] = (char)('0' + CIRCUITC_bench_random()%2);
+        }
+        hex[digits] = binary[digits] = '\x00';
+        uint64_t values;
+
+        CIRCUITC_array_t array; CIRCUITC_array_init(&array);
+        CIRCUITC_BENCH_CALIBRATE(values, array.size = 0; CIRCUITC_lexer_string_hex_to_integer(&array, hex, digits));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < values; i++){ array.size = 0; CIRCUITC_lexer_string_hex_to_integer(&array, hex, digits); });
+        const double hex_ns = seconds*1e9/(double)values;
+
+        CIRCUITC_BENCH_CALIBRATE(values, array.size = 0; CIRCUITC_lexer_string_binary_to_integer(&array, binary, digits));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < values; i++){ array.size = 0; CIRCUITC_lexer_string_binary_to_integer(&array, binary, digits); });
+        printf("    %8zu  %12.1f  %12.1f\n", digits, hex_ns, seconds*1e9/(double)values);
+
+        CIRCUITC_array_destroy(&array, CIRCUITC_array_keep_ctx);
+        free(hex);
+        free(binary);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+// bit length, trailing zero count and popcount of byte arrays, against the loop bit length used to be worked out with.
+//      cc -O2 -I../lexer bench_logarithms.c -o bench_logarithms -lpthread -lm
+//      ./bench_logarithms
+// the old loop is kept here as it was: every word loaded through NOAHZK_word_load_byte. the library picks its AVX2 kernels on its own when the CPU has them,
+// so the scalar loops are repeated here without them, built out of the same per-word helpers, to time the two apart. all versions are checked to agree.
+
+#include "bench.h"              // timing
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+uint64_t CIRCUITC_bench_bitcnt_old(void* real_value, uint64_t size){
+    uint64_t bitcnt = 0;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(size); i++){
+        const NOAHZK_word_t word = NOAHZK_word_load_byte(real_value, size, i);
+        const uint64_t is_nonzero = -(uint64_t)((word | -word) >> (BITS_IN_NOAHZK_WORD - 1));
+        const uint64_t word_bitcnt = (i + 1)*BITS_IN_NOAHZK_WORD - NOAHZK_word_clz(word | 1);
+        bitcnt = (word_bitcnt & is_nonzero) | (bitcnt &~is_nonzero);
+    }
+
+    return bitcnt;
+}
+
+uint64_t CIRCUITC_bench_bitcnt_scalar(void* real_value, uint64_t size){
+    const uint64_t whole_words = size/sizeof(NOAHZK_word_t);
+    uint64_t bitcnt = 0, i = 0;
+    NOAHZK_word_t word;
+
+    for(; i < whole_words; i++){
+        memcpy(&word, (const NOAHZK_word_t*)real_value + i, sizeof(word));
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        bitcnt = (NOAHZK_variable_width_word_bitcnt(word, i + 1) & is_nonzero) | (bitcnt & ~is_nonzero);
+    }
+    if(size%sizeof(NOAHZK_word_t)){
+        word = NOAHZK_word_load_byte(real_value, size, i);
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        bitcnt = (NOAHZK_variable_width_word_bitcnt(word, i + 1) & is_nonzero) | (bitcnt & ~is_nonzero);
+    }
+
+    return bitcnt;
+}
+
+uint64_t CIRCUITC_bench_ctz_scalar(const void* real_value, const uint64_t size){
+    const uint64_t whole_words = size/sizeof(NOAHZK_word_t);
+    uint64_t ctz = size*BITS_IN_UINT8_T, i = whole_words;
+    NOAHZK_word_t word;
+
+    if(size%sizeof(NOAHZK_word_t)){
+        word = NOAHZK_word_load_byte(real_value, size, i);
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        ctz = (NOAHZK_variable_width_word_ctz(word, i + 1) & is_nonzero) | (ctz & ~is_nonzero);
+    }
+    while(i-- > 0){
+        memcpy(&word, (const NOAHZK_word_t*)real_value + i, sizeof(word));
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        ctz = (NOAHZK_variable_width_word_ctz(word, i + 1) & is_nonzero) | (ctz & ~is_nonzero);
+    }
+
+    return ctz;
+}
+
+uint64_t CIRCUITC_bench_popcount_scalar(const void* real_value, const uint64_t size){
+    const uint64_t whole_words = size/sizeof(NOAHZK_word_t);
+    uint64_t popcount = 0, i = 0;
+    NOAHZK_word_t word;
+
+    for(; i < whole_words; i++){
+        memcpy(&word, (const NOAHZK_word_t*)real_value + i, sizeof(word));
+        popcount += NOAHZK_word_popcount(word);
+    }
+    if(size%sizeof(NOAHZK_word_t)) popcount += NOAHZK_word_popcount(NOAHZK_word_load_byte(real_value, size, i));
+
+    return popcount;
+}
+
+int main(){
+    printf("ns per call:\n");
+    printf("    %6s  %10s  %10s  %10s  %10s  %10s  %10s  %10s\n", "bytes", "old bitcnt", "bitcnt", "(library)", "ctz", "(library)", "popcount", "(library)");
+
+    for(uint64_t size = 8; size <= 4096; size *= 2){
+        uint8_t* value = malloc(size);
+// random words with the top and bottom ones cleared, so that neither bit length nor ctz are settled by the first word looked at
+        for(uint64_t i = 0; i < size; i++) value[i] = (uint8_t)CIRCUITC_bench_random();
+        if(size > 2*sizeof(NOAHZK_word_t)){
+            memset(value, 0, sizeof(NOAHZK_word_t));
+            memset(value + size - sizeof(NOAHZK_word_t), 0, sizeof(NOAHZK_word_t));
+        }
+
+        const uint64_t bitcnt = NOAHZK_variable_width_min_bitcnt_byte(value, size), ctz = NOAHZK_variable_width_ctz_byte(value, size), popcount = NOAHZK_variable_width_popcount_byte(value, size);
+        if(CIRCUITC_bench_bitcnt_old(value, size) != bitcnt || CIRCUITC_bench_bitcnt_scalar(value, size) != bitcnt
+        || CIRCUITC_bench_ctz_scalar(value, size) != ctz || CIRCUITC_bench_popcount_scalar(value, size) != popcount){
+            printf("versions disagree at %llu bytes\n", (unsigned long long)size);
+            return 1;
+        }
+
+        const uint64_t calls = NOAHZK_MAX((uint64_t)1, ((uint64_t)1 << 24)/size);
+        double seconds[7];
+        CIRCUITC_BENCH_MIN(seconds[0], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += CIRCUITC_bench_bitcnt_old(value, size));
+        CIRCUITC_BENCH_MIN(seconds[1], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += CIRCUITC_bench_bitcnt_scalar(value, size));
+        CIRCUITC_BENCH_MIN(seconds[2], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += NOAHZK_variable_width_min_bitcnt_byte(value, size));
+        CIRCUITC_BENCH_MIN(seconds[3], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += CIRCUITC_bench_ctz_scalar(value, size));
+        CIRCUITC_BENCH_MIN(seconds[4], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += NOAHZK_variable_width_ctz_byte(value, size));
+        CIRCUITC_BENCH_MIN(seconds[5], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += CIRCUITC_bench_popcount_scalar(value, size));
+        CIRCUITC_BENCH_MIN(seconds[6], for(uint64_t i = 0; i < calls; i++) CIRCUITC_bench_sink += NOAHZK_variable_width_popcount_byte(value, size));
+
+        printf("    %6llu", (unsigned long long)size);
+        for(int i = 0; i < 7; i++) printf("  %10.1f", seconds[i]*1e9/(double)calls);
+        printf("\n");
+
+        free(value);
+    }
+
+    return 0;
+}
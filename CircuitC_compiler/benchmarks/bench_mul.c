@@ -0,0 +1,128 @@
+// NOAHZK_variable_width_mul_byte on balanced operands, against the 4-multiplication byte recursion it replaced,
+// NOAHZK_variable_width_mul_byte_with_scratch given a buffer of its own, against mul_byte going through the thread's workspace,
+// and mul_byte squaring, which it does when both operands are the same array; then products wide enough for the transforms, balanced or not.
+//      cc -O2 -I../lexer bench_mul.c -o bench_mul -lpthread -lm
+//      ./bench_mul [largest width the byte recursion is timed at, in bits]
+// the byte recursion is kept here as it was, to time it; it is quadratic, and takes seconds past 16384 bits, so it stops there unless told otherwise.
+
+#include "bench.h"              // timing
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+void CIRCUITC_bench_mul_byte_recursion(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
+    if(width0 == 0 || width1 == 0) return;
+    if(width0 == sizeof(uint8_t) && width1 == sizeof(uint8_t)){
+        *(uint16_t*)dst = *(uint8_t*)rs0 * *(uint8_t*)rs1;
+        return;
+    }
+    if(width0 == sizeof(uint8_t) || width1 == sizeof(uint8_t)){
+        const uint8_t k = width0 == sizeof(uint8_t)? *(uint8_t*)rs0: *(uint8_t*)rs1;
+        const uint8_t* src = width0 == sizeof(uint8_t)? rs1: rs0;
+        const uint64_t width = width0 == sizeof(uint8_t)? width1: width0;
+        uint16_t product = 0;
+        for(uint64_t i = 0; i < width; i++){
+            product += src[i]*k;
+            ((uint8_t*)dst)[i] = (uint8_t)product;
+            product >>= BITS_IN_UINT8_T;
+        }
+        ((uint8_t*)dst)[width] = (uint8_t)product;
+        return;
+    }
+
+    const uint64_t n = width0/2, m = width1/2;
+
+    const uint64_t width_X1Y1 = width0-n + width1-m;
+    uint8_t X1Y1[width_X1Y1];
+    CIRCUITC_bench_mul_byte_recursion(X1Y1, (uint8_t*)rs0 + n, (uint8_t*)rs1 + m, width0-n, width1-m);
+
+    const uint64_t width_X1Y0 = width0-n + m;
+    uint8_t X1Y0[width_X1Y0];
+    CIRCUITC_bench_mul_byte_recursion(X1Y0, (uint8_t*)rs0 + n, rs1, width0-n, m);
+
+    const uint64_t width_X0Y1 = n + width1-m;
+    uint8_t X0Y1[width_X0Y1];
+    CIRCUITC_bench_mul_byte_recursion(X0Y1, rs0, (uint8_t*)rs1 + m, n, width1-m);
+
+    const uint64_t width_X0Y0 = n + m;
+    uint8_t X0Y0[width_X0Y0];
+    CIRCUITC_bench_mul_byte_recursion(X0Y0, rs0, rs1, n, m);
+
+    memset(dst, 0, width0+width1);
+    const uint64_t width_dst = width0 + width1;
+    NOAHZK_variable_width_add_with_byte_offset_byte(dst, X0Y0, X0Y1, width_X0Y0, width_X0Y1, width_dst, m);
+    NOAHZK_variable_width_add_with_byte_offset_byte(dst, dst,  X1Y0, width_dst,  width_X1Y0, width_dst, n);
+    NOAHZK_variable_width_add_with_byte_offset_byte(dst, dst,  X1Y1, width_dst,  width_X1Y1, width_dst, n+m);
+}
+
+void CIRCUITC_bench_fill(uint8_t* bytes, const uint64_t width){
+    for(uint64_t i = 0; i < width; i++) bytes[i] = (uint8_t)CIRCUITC_bench_random();
+}
+
+int main(int argc, char** argv){
+    const uint64_t largest_recursion_bits = argc > 1? (uint64_t)atoll(argv[1]): 16384;
+    double seconds;
+
+    printf("balanced products, ns per call:\n");
+    printf("    %8s  %16s  %12s  %12s  %12s\n", "bits", "byte recursion", "mul_byte", "with_scratch", "square");
+    for(uint64_t bits = 64; bits <= 65536; bits *= 2){
+        const uint64_t width = bits/BITS_IN_UINT8_T;
+        uint8_t* rs0 = malloc(width);
+        uint8_t* rs1 = malloc(width);
+        uint8_t* dst = malloc(2*width);
+        CIRCUITC_bench_fill(rs0, width);
+        CIRCUITC_bench_fill(rs1, width);
+// enough calls per run that a run takes some tens of milliseconds; the byte recursion is about a hundred times slower, so it's given fewer
+        const uint64_t calls = NOAHZK_MAX((uint64_t)1, ((uint64_t)1 << 26)/(bits*bits/64 + 1));
+        const uint64_t recursion_calls = NOAHZK_MAX((uint64_t)1, ((uint64_t)1 << 20)/(bits*bits/64 + 1));
+
+        double recursion_ns = 0;
+        if(bits <= largest_recursion_bits){
+            CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < recursion_calls; i++) CIRCUITC_bench_mul_byte_recursion(dst, rs0, rs1, width, width));
+            recursion_ns = seconds*1e9/(double)recursion_calls;
+        }
+
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_mul_byte(dst, rs0, rs1, width, width));
+        const double mul_ns = seconds*1e9/(double)calls;
+
+        void* scratch = malloc(NOAHZK_variable_width_mul_byte_scratch_size(width, width));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_mul_byte_with_scratch(dst, rs0, rs1, width, width, scratch));
+        const double scratch_ns = seconds*1e9/(double)calls;
+
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_mul_byte(dst, rs0, rs0, width, width));
+        if(recursion_ns != 0) printf("    %8llu  %16.0f  %12.0f  %12.0f  %12.0f\n", (unsigned long long)bits, recursion_ns, mul_ns, scratch_ns, seconds*1e9/(double)calls);
+        else printf("    %8llu  %16s  %12.0f  %12.0f  %12.0f\n", (unsigned long long)bits, "-", mul_ns, scratch_ns, seconds*1e9/(double)calls);
+
+        free(scratch);
+        free(rs0);
+        free(rs1);
+        free(dst);
+    }
+
+    const uint64_t wide[][2] = { { 1024, 1024 }, { 2048, 2048 }, { 4096, 4096 }, { 16384, 16384 }, { 65536, 65536 }, { 200000, 200000 }, { 2000, 30000 } };
+    printf("wide products, ms per call:\n");
+    printf("    %16s  %12s  %12s\n", "words", "mul_byte", "square");
+    for(size_t w = 0; w < sizeof(wide)/sizeof(*wide); w++){
+        const uint64_t width0 = wide[w][0]*sizeof(NOAHZK_word_t), width1 = wide[w][1]*sizeof(NOAHZK_word_t);
+        uint8_t* rs0 = malloc(width0);
+        uint8_t* rs1 = malloc(width1);
+        uint8_t* dst = malloc(width0 + width1);
+        CIRCUITC_bench_fill(rs0, width0);
+        CIRCUITC_bench_fill(rs1, width1);
+        char name[32];
+        snprintf(name, sizeof(name), "%llux%llu", (unsigned long long)wide[w][0], (unsigned long long)wide[w][1]);
+
+        CIRCUITC_BENCH_MIN(seconds, NOAHZK_variable_width_mul_byte(dst, rs0, rs1, width0, width1));
+        const double mul_ms = seconds*1e3;
+        if(width0 == width1){
+            CIRCUITC_BENCH_MIN(seconds, NOAHZK_variable_width_mul_byte(dst, rs0, rs0, width0, width0));
+            printf("    %16s  %12.2f  %12.2f\n", name, mul_ms, seconds*1e3);
+        }
+        else printf("    %16s  %12.2f  %12s\n", name, mul_ms, "-");
+
+        free(rs0);
+        free(rs1);
+        free(dst);
+    }
+
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
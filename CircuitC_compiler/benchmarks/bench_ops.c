@@ -0,0 +1,45 @@
+// NOAHZK_variable_width_add_byte, sub_byte and add_with_bit_offset_byte on operands of 32 to 4096 bytes.
+//      cc -O2 -I../lexer bench_ops.c -o bench_ops -lpthread -lm
+//      ./bench_ops
+// the offset add shifts by 13 bits, so that it takes the path which moves bits across bytes rather than the byte-aligned one.
+
+#include "bench.h"              // timing
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+int main(){
+    const uint64_t widths[] = { 32, 256, 4096 };
+    double seconds;
+
+    printf("byte ops, ns per call:\n");
+    printf("    %8s  %10s  %10s  %20s\n", "bytes", "add_byte", "sub_byte", "add_with_bit_offset");
+    for(size_t w = 0; w < sizeof(widths)/sizeof(*widths); w++){
+        const uint64_t width = widths[w];
+        uint8_t* rs0 = malloc(width);
+        uint8_t* rs1 = malloc(width);
+        uint8_t* dst = malloc(width);
+        for(uint64_t i = 0; i < width; i++){
+            rs0[i] = (uint8_t)CIRCUITC_bench_random();
+            rs1[i] = (uint8_t)CIRCUITC_bench_random();
+        }
+        uint64_t calls;
+
+        CIRCUITC_BENCH_CALIBRATE(calls, NOAHZK_variable_width_add_byte(dst, rs0, rs1, width, width, width));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_add_byte(dst, rs0, rs1, width, width, width));
+        const double add_ns = seconds*1e9/(double)calls;
+
+        CIRCUITC_BENCH_CALIBRATE(calls, NOAHZK_variable_width_sub_byte(dst, rs0, rs1, width));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_sub_byte(dst, rs0, rs1, width));
+        const double sub_ns = seconds*1e9/(double)calls;
+
+        CIRCUITC_BENCH_CALIBRATE(calls, NOAHZK_variable_width_add_with_bit_offset_byte(dst, rs0, rs1, width, width, width, 13));
+        CIRCUITC_BENCH_MIN(seconds, for(uint64_t i = 0; i < calls; i++) NOAHZK_variable_width_add_with_bit_offset_byte(dst, rs0, rs1, width, width, width, 13));
+        printf("    %8llu  %10.0f  %10.0f  %20.0f\n", (unsigned long long)width, add_ns, sub_ns, seconds*1e9/(double)calls);
+
+        CIRCUITC_bench_sink = dst[width - 1];
+        free(rs0);
+        free(rs1);
+        free(dst);
+    }
+
+    return 0;
+}
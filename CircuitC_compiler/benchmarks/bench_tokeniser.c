@@ -0,0 +1,115 @@
+// CIRCUITC_token_get (DFA) against the per-character tree lookups it replaced, over generated source.
+//      cc -O2 -I../lexer bench_tokeniser.c -o bench_tokeniser -lpthread -lm
+//      ./bench_tokeniser [megabytes]
+// the tree path is kept here as it was in the tokeniser: a search of the whitespace tree, then of the comment tree, then of the keyword tree, for every symbol.
+// both paths scan names, values and comment bodies with the same kernels and look names up in the same keyword table, so that only the classifying of symbols differs.
+
+#include "bench.h"              // timing, source generator
+#include "tokeniser.h"          // DFA tokeniser
+#include "tokens.h"             // token trees
+
+typedef struct{
+    CIRCUITC_tree_t* keywords;
+    CIRCUITC_tree_t* comments;
+    CIRCUITC_tree_t* whitespaces;
+    CIRCUITC_tokeniser_t* tokeniser;    // run kernels and keyword table
+} CIRCUITC_bench_tree_tokeniser_t;
+
+CIRCUITC_token_t CIRCUITC_bench_tree_parse_operator(char** string, CIRCUITC_bench_tree_tokeniser_t* tokeniser, CIRCUITC_token_t token){
+    size_t operator_length = 1;
+    CIRCUITC_tree_error_code_t error_code;
+    CIRCUITC_token_t new_token = token;
+
+    do{
+        token = new_token;
+        new_token = CIRCUITC_tree_search(tokeniser->keywords, *string, operator_length++, &error_code);
+    } while(error_code == CIRCUITC_tree_no_error && CIRCUITC_TOKEN_METADATA_GET(new_token) == CIRCUITC_TOKEN_METADATA_EXTENDED);
+
+    *string += operator_length - 2;
+    return token;
+}
+
+CIRCUITC_token_t CIRCUITC_bench_tree_token_get(char** string, CIRCUITC_bench_tree_tokeniser_t* tokeniser, size_t* nameval_token_length){
+    CIRCUITC_tree_error_code_t error_code;
+    CIRCUITC_token_t cur_token = CIRCUITC_tree_search(tokeniser->whitespaces, *string, 1, &error_code);
+    if(error_code == CIRCUITC_tree_no_error){
+        *string += 1;
+        return cur_token;
+    }
+
+    cur_token = CIRCUITC_tree_search(tokeniser->comments, *string, 2, &error_code);
+    if(error_code == CIRCUITC_tree_no_error){
+        *string = CIRCUITC_tokeniser_comment_skip(*string + 2, tokeniser->tokeniser, cur_token);
+        return CIRCUITC_TOKEN_WHITESPACE;
+    }
+
+    if(CIRCUITC_tokeniser_REGEX_is_alphabetic(**string)){
+        const size_t length = tokeniser->tokeniser->scan.alphanumeric(*string);
+        if(CIRCUITC_keyword_table_lookup(&tokeniser->tokeniser->keywords, *string, length, &cur_token)){
+            *string += length;
+            return cur_token;
+        }
+
+        *nameval_token_length = length;
+        return CIRCUITC_TOKEN_NAME;
+    }
+
+    cur_token = CIRCUITC_bench_tree_parse_operator(string, tokeniser, CIRCUITC_TOKEN_EOF);
+    if(cur_token != CIRCUITC_TOKEN_EOF) return cur_token;
+
+    *nameval_token_length = CIRCUITC_tokeniser_REGEX_is_numeric(**string)? tokeniser->tokeniser->scan.alphanumeric(*string): 1;
+    return CIRCUITC_TOKEN_VALUE;
+}
+
+// tokens in source, walked the way the lexer walks it: names and values are stepped over by the caller
+size_t CIRCUITC_bench_dfa(char* source, CIRCUITC_tokeniser_t* tokeniser){
+    size_t tokens = 0;
+    CIRCUITC_token_t token;
+
+    do{
+        size_t nameval_token_length = 0;
+        token = CIRCUITC_token_get(&source, tokeniser, &nameval_token_length);
+        if(token == CIRCUITC_TOKEN_NAME || token == CIRCUITC_TOKEN_VALUE) source += nameval_token_length;
+        tokens++;
+    } while(token != CIRCUITC_TOKEN_EOF);
+
+    return tokens;
+}
+
+size_t CIRCUITC_bench_tree(char* source, CIRCUITC_bench_tree_tokeniser_t* tokeniser){
+    size_t tokens = 0;
+    CIRCUITC_token_t token;
+
+    do{
+        size_t nameval_token_length = 0;
+        token = CIRCUITC_bench_tree_token_get(&source, tokeniser, &nameval_token_length);
+        if(token == CIRCUITC_TOKEN_NAME || token == CIRCUITC_TOKEN_VALUE) source += nameval_token_length;
+        tokens++;
+    } while(token != CIRCUITC_TOKEN_EOF);
+
+    return tokens;
+}
+
+int main(int argc, char** argv){
+    const size_t megabytes = argc > 1? (size_t)atoi(argv[1]): 64;
+    size_t length;
+    char* source = CIRCUITC_bench_source(megabytes << 20, &length);
+
+    CIRCUITC_tokeniser_t tokeniser; CIRCUITC_tokeniser_init(&tokeniser);
+    CIRCUITC_bench_tree_tokeniser_t trees = { CIRCUITC_token_keywords_init(), CIRCUITC_token_comments_init(), CIRCUITC_token_whitespaces_init(), &tokeniser };
+    double dfa_seconds, tree_seconds;
+    size_t dfa_tokens = 0, tree_tokens = 0;
+
+    CIRCUITC_BENCH_MIN(dfa_seconds, dfa_tokens = CIRCUITC_bench_dfa(source, &tokeniser));
+    CIRCUITC_BENCH_MIN(tree_seconds, tree_tokens = CIRCUITC_bench_tree(source, &trees));
+    printf("source: %zu bytes\n", length);
+    printf("dfa:    %8.1f MB/s  (%zu tokens)\n", (double)length/dfa_seconds/1e6, dfa_tokens);
+    printf("tree:   %8.1f MB/s  (%zu tokens)\n", (double)length/tree_seconds/1e6, tree_tokens);
+
+    CIRCUITC_tree_destroy(trees.keywords, CIRCUITC_tree_keep_key);
+    CIRCUITC_tree_destroy(trees.comments, CIRCUITC_tree_keep_key);
+    CIRCUITC_tree_destroy(trees.whitespaces, CIRCUITC_tree_keep_key);
+    CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
+    free(source);
+    return 0;
+}
@@ -0,0 +1,185 @@
+// CIRCUITC_tree_t (AVL, nodes malloc'd or taken from an arena) against the unbalanced tree it replaced: building, then looking keys up.
+//      cc -O2 -I../lexer bench_tree.c -o bench_tree -lpthread -lm
+//      ./bench_tree
+// the unbalanced tree is kept here as it was: plain insertion, no rotations, nodes malloc'd one by one.
+// keys put in sorted order turn it into a list, which is what keyword tables did; the 20k sorted keys take it seconds to build.
+
+#include "bench.h"              // timing
+#include "bst.h"                // AVL tree
+#include "arena.h"              // arena nodes
+
+typedef struct CIRCUITC_bench_plain_tree{
+    struct CIRCUITC_bench_plain_tree* lt;
+    struct CIRCUITC_bench_plain_tree* gt;
+    char* key;
+    CIRCUITC_value_t value;
+} CIRCUITC_bench_plain_tree_t;
+
+void CIRCUITC_bench_plain_tree_put(CIRCUITC_bench_plain_tree_t** tree, char* key, CIRCUITC_value_t value){
+    int result;
+
+    while(*tree && (result = strcmp(key, (*tree)->key))) tree = result < 0? &(*tree)->lt: &(*tree)->gt;
+    if(!*tree) *tree = calloc(1, sizeof(**tree));
+
+    (*tree)->key = key;
+    (*tree)->value = value;
+}
+
+CIRCUITC_value_t CIRCUITC_bench_plain_tree_search(CIRCUITC_bench_plain_tree_t* tree, char* key, const size_t keylen, CIRCUITC_tree_error_code_t* error_code){
+    int result;
+    while((result = strncmp(key, tree->key, keylen))){
+        if(result < 0 && tree->lt) tree = tree->lt;
+        else if(result > 0 && tree->gt) tree = tree->gt;
+        else{
+            if(error_code) *error_code = CIRCUITC_tree_error;
+            return 0;
+        }
+    }
+
+    if(error_code) *error_code = CIRCUITC_tree_no_error;
+    return tree->value;
+}
+
+// iterative, as a sorted build is as deep as it is long
+void CIRCUITC_bench_plain_tree_destroy(CIRCUITC_bench_plain_tree_t* tree){
+    while(tree){
+        if(tree->lt){
+            CIRCUITC_bench_plain_tree_t* lt = tree->lt;
+            tree->lt = lt->gt;
+            lt->gt = tree;
+            tree = lt;
+        }
+        else{
+            CIRCUITC_bench_plain_tree_t* gt = tree->gt;
+            free(tree);
+            tree = gt;
+        }
+    }
+}
+
+typedef enum{ CIRCUITC_bench_plain, CIRCUITC_bench_avl, CIRCUITC_bench_avl_arena } CIRCUITC_bench_tree_kind_t;
+
+const char* CIRCUITC_bench_tree_kinds[] = { "unbalanced", "avl", "avl+arena" };
+
+typedef struct{
+    CIRCUITC_bench_tree_kind_t kind;
+    CIRCUITC_bench_plain_tree_t* plain;
+    CIRCUITC_tree_t* avl;
+    CIRCUITC_arena_t arena;
+} CIRCUITC_bench_tree_t;
+
+void CIRCUITC_bench_tree_build(CIRCUITC_bench_tree_t* tree, char** keys, const size_t number_of_keys){
+    tree->plain = NULL;
+    tree->avl = NULL;
+
+    for(size_t i = 0; i < number_of_keys; i++)
+        switch(tree->kind){
+            case CIRCUITC_bench_plain: CIRCUITC_bench_plain_tree_put(&tree->plain, keys[i], i); break;
+            case CIRCUITC_bench_avl: CIRCUITC_tree_put(&tree->avl, keys[i], i); break;
+// a tree whose root is made from the arena takes the rest of its nodes from it too
+            case CIRCUITC_bench_avl_arena:
+                if(!tree->avl) tree->avl = CIRCUITC_tree_node_make_from(&tree->arena, keys[i], i);
+                else CIRCUITC_tree_put(&tree->avl, keys[i], i);
+                break;
+        }
+}
+
+void CIRCUITC_bench_tree_clear(CIRCUITC_bench_tree_t* tree){
+    switch(tree->kind){
+        case CIRCUITC_bench_plain: CIRCUITC_bench_plain_tree_destroy(tree->plain); break;
+        case CIRCUITC_bench_avl: CIRCUITC_tree_destroy(tree->avl, CIRCUITC_tree_keep_key); break;
+        case CIRCUITC_bench_avl_arena: CIRCUITC_arena_reset(&tree->arena); break;
+    }
+}
+
+uint64_t CIRCUITC_bench_tree_lookups(CIRCUITC_bench_tree_t* tree, char** keys, const size_t* lookups, const size_t number_of_lookups){
+    CIRCUITC_tree_error_code_t error_code;
+    uint64_t sum = 0;
+
+    for(size_t i = 0; i < number_of_lookups; i++){
+        char* key = keys[lookups[i]];
+        const size_t keylen = strlen(key) + 1;
+        sum += tree->kind == CIRCUITC_bench_plain? CIRCUITC_bench_plain_tree_search(tree->plain, key, keylen, &error_code): CIRCUITC_tree_search(tree->avl, key, keylen, &error_code);
+    }
+
+    return sum;
+}
+
+// builds each kind of tree out of keys, in the order given, then looks up number_of_lookups random keys in it
+void CIRCUITC_bench_tree_case(const char* name, char** keys, const size_t number_of_keys, const size_t number_of_lookups){
+    size_t* lookups = malloc(number_of_lookups*sizeof(*lookups));
+    for(size_t i = 0; i < number_of_lookups; i++) lookups[i] = CIRCUITC_bench_random()%number_of_keys;
+
+    printf("%s:\n", name);
+    for(int kind = CIRCUITC_bench_plain; kind <= CIRCUITC_bench_avl_arena; kind++){
+        CIRCUITC_bench_tree_t tree = { .kind = kind };
+        CIRCUITC_arena_init(&tree.arena);
+// builds are timed apart from clearing the tree; the last one is kept for the lookups
+        double build_seconds = 1e300, lookup_seconds;
+        for(int run = 0; run < CIRCUITC_BENCH_RUNS; run++){
+            if(run) CIRCUITC_bench_tree_clear(&tree);
+            const double start = CIRCUITC_bench_now();
+            CIRCUITC_bench_tree_build(&tree, keys, number_of_keys);
+            const double seconds = CIRCUITC_bench_now() - start;
+            if(seconds < build_seconds) build_seconds = seconds;
+        }
+
+        CIRCUITC_BENCH_MIN(lookup_seconds, CIRCUITC_bench_sink += CIRCUITC_bench_tree_lookups(&tree, keys, lookups, number_of_lookups));
+        printf("    %-10s  build %10.3f ms   lookup %10.1f ns/op\n", CIRCUITC_bench_tree_kinds[kind], build_seconds*1e3, lookup_seconds*1e9/(double)number_of_lookups);
+
+        CIRCUITC_bench_tree_clear(&tree);
+        CIRCUITC_arena_destroy(&tree.arena, CIRCUITC_arena_keep_ctx);
+    }
+
+    free(lookups);
+}
+
+void CIRCUITC_bench_shuffle(char** keys, const size_t number_of_keys){
+    for(size_t i = number_of_keys; i > 1; i--){
+        const size_t j = CIRCUITC_bench_random()%i;
+        char* key = keys[i - 1];
+        keys[i - 1] = keys[j];
+        keys[j] = key;
+    }
+}
+
+// "symbol" followed by a zero-padded number, so that keys made in order are sorted
+char** CIRCUITC_bench_symbols(const size_t number_of_keys){
+    char** keys = malloc(number_of_keys*sizeof(*keys));
+
+    for(size_t i = 0; i < number_of_keys; i++){
+        keys[i] = malloc(32);
+        snprintf(keys[i], 32, "symbol%07zu", i);
+    }
+
+    return keys;
+}
+
+void CIRCUITC_bench_symbols_destroy(char** keys, const size_t number_of_keys){
+    for(size_t i = 0; i < number_of_keys; i++) free(keys[i]);
+    free(keys);
+}
+
+int main(){
+// the keywords of C, sorted, as a keyword table would list them
+    char* keywords[] = {
+        "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum", "extern", "float", "for", "goto", "if",
+        "inline", "int", "long", "register", "restrict", "return", "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void"
+    };
+    const size_t number_of_keywords = sizeof(keywords)/sizeof(*keywords);
+
+    CIRCUITC_bench_tree_case("32 keywords, sorted", keywords, number_of_keywords, 1000000);
+    CIRCUITC_bench_shuffle(keywords, number_of_keywords);
+    CIRCUITC_bench_tree_case("32 keywords, shuffled", keywords, number_of_keywords, 1000000);
+
+    char** symbols = CIRCUITC_bench_symbols(200000);
+    CIRCUITC_bench_shuffle(symbols, 200000);
+    CIRCUITC_bench_tree_case("200k symbols, random order", symbols, 200000, 1000000);
+    CIRCUITC_bench_symbols_destroy(symbols, 200000);
+
+    symbols = CIRCUITC_bench_symbols(20000);
+    CIRCUITC_bench_tree_case("20k symbols, sorted", symbols, 20000, 2000);
+    CIRCUITC_bench_symbols_destroy(symbols, 20000);
+
+    return 0;
+}
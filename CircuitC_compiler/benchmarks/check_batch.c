@@ -0,0 +1,159 @@
+// checks the batched ops (scalar, AVX2 and AVX-512 versions, and those NOAHZK_variable_width_batch_init picks) against the per-operand ops.
+//      cc -O2 -I../lexer check_batch.c -o check_batch -lpthread -lm
+//      ./check_batch [cases]
+// - add and sub against NOAHZK_variable_width_add_byte and sub_byte, also with dst over rs0
+// - mul against NOAHZK_variable_width_mul_byte, on widths either side of where the vector versions hand operands to the scalar one
+// - compare against a byte by byte comparison, there being no per-operand compare in the library
+// counts are random, so that most batches leave operands that don't fill a vector to the scalar version. operands are random, all ones
+// (whose sums carry the furthest), 0 or, for rs1, rs0 with a single word changed, so that compare goes through every word.
+// versions the CPU doesn't support are left out. prints the first operand that doesn't agree and exits with 1; exits with 0 if all do.
+
+#include "bench.h"              // seeded generator
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library, batches
+
+#define CIRCUITC_CHECK_BATCH_WIDEST                 20                  // widest operand, in words
+#define CIRCUITC_CHECK_BATCH_LARGEST                40                  // most operands in a batch
+
+typedef enum{ CIRCUITC_CHECK_RANDOM, CIRCUITC_CHECK_ALL_ONES, CIRCUITC_CHECK_ZERO, CIRCUITC_CHECK_ONE_WORD_APART, CIRCUITC_CHECK_KINDS } CIRCUITC_check_kind_t;
+
+typedef struct{
+    const char* name;
+    NOAHZK_variable_width_batch_t batch;
+} CIRCUITC_check_batch_version_t;
+
+// records what doesn't agree, unless something earlier already didn't, so that a case is reported by the first check it fails
+#define CIRCUITC_CHECK(failed, mismatch, what) if(!(failed) && (mismatch)) (failed) = (what)
+
+// -1, 0 or 1 as rs0 is below, equal to or above rs1, both width bytes wide
+int CIRCUITC_check_compare_byte(const uint8_t* rs0, const uint8_t* rs1, const uint64_t width){
+    for(uint64_t i = width; i-- > 0;) if(rs0[i] != rs1[i]) return rs0[i] < rs1[i]? -1: 1;
+    return 0;
+}
+
+// fills width bytes of rs1 as kind says, rs0 being what rs1 is one word apart from
+void CIRCUITC_check_fill(uint8_t* rs1, const uint8_t* rs0, const uint64_t width, const CIRCUITC_check_kind_t kind){
+    switch(kind){
+        case CIRCUITC_CHECK_RANDOM:         for(uint64_t i = 0; i < width; i++) rs1[i] = (uint8_t)CIRCUITC_bench_random(); break;
+        case CIRCUITC_CHECK_ALL_ONES:       memset(rs1, 0xff, width); break;
+        case CIRCUITC_CHECK_ZERO:           memset(rs1, 0, width); break;
+        default:
+            memcpy(rs1, rs0, width);
+            if(width) rs1[CIRCUITC_bench_random()%width] ^= (uint8_t)(1 << CIRCUITC_bench_random()%8);
+            break;
+    }
+}
+
+// checks version on count operands width words wide, laid out one after the other in rs0 and rs1 as byte arrays
+const char* CIRCUITC_check_version(const NOAHZK_variable_width_batch_t* version, const uint8_t* rs0, const uint8_t* rs1, const uint64_t width, const uint64_t count, uint64_t* operand){
+    const uint64_t bytes = NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width);
+// exactly as wide as the batches, so that an op reading or writing past one shows under a sanitiser
+    NOAHZK_word_t* batch0 = calloc(count*width, sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* batch1 = calloc(count*width, sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* batch_dst = calloc(2*count*width, sizeof(NOAHZK_word_t));
+    int8_t* order = malloc(count);
+    uint8_t* expected = malloc(2*bytes + 1);
+    uint8_t* got = malloc(2*bytes + 1);
+    const char* failed = NULL;
+
+    for(uint64_t j = 0; j < count; j++){
+        NOAHZK_variable_width_batch_set_byte(batch0, width, count, j, rs0 + j*bytes, bytes);
+        NOAHZK_variable_width_batch_set_byte(batch1, width, count, j, rs1 + j*bytes, bytes);
+    }
+
+    version->add(batch_dst, batch0, batch1, width, count);
+    for(uint64_t j = 0; j < count && !failed; j++){
+        NOAHZK_variable_width_add_byte(expected, rs0 + j*bytes, rs1 + j*bytes, bytes, bytes, bytes);
+        NOAHZK_variable_width_batch_get_byte(got, bytes, batch_dst, width, count, j);
+        CIRCUITC_CHECK(failed, memcmp(got, expected, bytes), "add differs from add_byte");
+        *operand = j;
+    }
+
+    version->sub(batch_dst, batch0, batch1, width, count);
+    for(uint64_t j = 0; j < count && !failed; j++){
+        NOAHZK_variable_width_sub_byte(expected, rs0 + j*bytes, rs1 + j*bytes, bytes);
+        NOAHZK_variable_width_batch_get_byte(got, bytes, batch_dst, width, count, j);
+        CIRCUITC_CHECK(failed, memcmp(got, expected, bytes), "sub differs from sub_byte");
+        *operand = j;
+    }
+
+    CIRCUITC_CHECK(failed, !version->mul(batch_dst, batch0, batch1, width, count), "mul failed to grow the workspace");
+    for(uint64_t j = 0; j < count && !failed; j++){
+        NOAHZK_variable_width_mul_byte(expected, rs0 + j*bytes, rs1 + j*bytes, bytes, bytes);
+        NOAHZK_variable_width_batch_get_byte(got, 2*bytes, batch_dst, 2*width, count, j);
+        CIRCUITC_CHECK(failed, memcmp(got, expected, 2*bytes), "mul differs from mul_byte");
+        *operand = j;
+    }
+
+    version->compare(order, batch0, batch1, width, count);
+    for(uint64_t j = 0; j < count && !failed; j++){
+        CIRCUITC_CHECK(failed, order[j] != CIRCUITC_check_compare_byte(rs0 + j*bytes, rs1 + j*bytes, bytes), "compare differs from comparing bytes");
+        *operand = j;
+    }
+
+// dst over rs0, which is left as rs0 - rs1 once both are done
+    version->add(batch0, batch0, batch1, width, count);
+    version->sub(batch0, batch0, batch1, width, count);
+    version->sub(batch0, batch0, batch1, width, count);
+    for(uint64_t j = 0; j < count && !failed; j++){
+        NOAHZK_variable_width_sub_byte(expected, rs0 + j*bytes, rs1 + j*bytes, bytes);
+        NOAHZK_variable_width_batch_get_byte(got, bytes, batch0, width, count, j);
+        CIRCUITC_CHECK(failed, memcmp(got, expected, bytes), "add and sub over rs0 differ from sub_byte");
+        *operand = j;
+    }
+
+    free(batch0);
+    free(batch1);
+    free(batch_dst);
+    free(order);
+    free(expected);
+    free(got);
+    return failed;
+}
+
+int main(int argc, char** argv){
+    const uint64_t cases = argc > 1? (uint64_t)atoll(argv[1]): 2000;
+    CIRCUITC_check_batch_version_t versions[4];
+    size_t number_of_versions = 0;
+
+    versions[number_of_versions++] = (CIRCUITC_check_batch_version_t){ "scalar", { NOAHZK_variable_width_batch_add_scalar, NOAHZK_variable_width_batch_sub_scalar, NOAHZK_variable_width_batch_mul_scalar, NOAHZK_variable_width_batch_compare_scalar } };
+#ifdef NOAHZK_BATCH_X86_64
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        versions[number_of_versions++] = (CIRCUITC_check_batch_version_t){ "avx2", { NOAHZK_variable_width_batch_add_avx2, NOAHZK_variable_width_batch_sub_avx2, NOAHZK_variable_width_batch_mul_avx2, NOAHZK_variable_width_batch_compare_avx2 } };
+    if(__builtin_cpu_supports("avx512f"))
+        versions[number_of_versions++] = (CIRCUITC_check_batch_version_t){ "avx512", { NOAHZK_variable_width_batch_add_avx512, NOAHZK_variable_width_batch_sub_avx512, NOAHZK_variable_width_batch_mul_avx512, NOAHZK_variable_width_batch_compare_avx512 } };
+#endif
+    versions[number_of_versions].name = "init";
+    NOAHZK_variable_width_batch_init(&versions[number_of_versions++].batch);
+
+    const uint64_t largest = NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(CIRCUITC_CHECK_BATCH_LARGEST*CIRCUITC_CHECK_BATCH_WIDEST);
+    uint8_t* rs0 = malloc(largest);
+    uint8_t* rs1 = malloc(largest);
+
+    for(uint64_t c = 0; c < cases; c++){
+        const uint64_t width = CIRCUITC_bench_random()%(CIRCUITC_CHECK_BATCH_WIDEST + 1), bytes = NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width);
+        const uint64_t count = 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_BATCH_LARGEST;
+
+        for(uint64_t j = 0; j < count; j++){
+            CIRCUITC_check_fill(rs0 + j*bytes, NULL, bytes, (CIRCUITC_check_kind_t)(CIRCUITC_bench_random()%CIRCUITC_CHECK_ONE_WORD_APART));
+            CIRCUITC_check_fill(rs1 + j*bytes, rs0 + j*bytes, bytes, (CIRCUITC_check_kind_t)(CIRCUITC_bench_random()%CIRCUITC_CHECK_KINDS));
+        }
+
+        for(size_t v = 0; v < number_of_versions; v++){
+            uint64_t operand = 0;
+            const char* failed = CIRCUITC_check_version(&versions[v].batch, rs0, rs1, width, count, &operand);
+            if(failed){
+                printf("case %llu: %s %s (operand %llu of %llu, %llu words wide)\n", (unsigned long long)c, versions[v].name, failed,
+                    (unsigned long long)operand, (unsigned long long)count, (unsigned long long)width);
+                return 1;
+            }
+        }
+    }
+
+    free(rs0);
+    free(rs1);
+
+    printf("%llu batches agree with the per-operand ops in %zu versions\n", (unsigned long long)cases, number_of_versions);
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
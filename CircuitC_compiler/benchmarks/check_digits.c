@@ -0,0 +1,120 @@
+// checks the hex and binary digit kernels (scalar, SSSE3 and AVX2 versions, and the dispatching ones) against decoding a digit at a time.
+//      cc -O2 -I../lexer check_digits.c -o check_digits -lpthread -lm
+//      ./check_digits [cases]
+// - runs of valid digits, upper and lower case for hex, decoding into the same limbs as the reference
+// - runs with a single character that isn't a digit of their base anywhere in them (one either side of a range of digits, the same letter past
+//   'f', a digit of a bigger base, a byte with its top bit set or 0) being rejected
+// the vector versions are given the whole run, and the scalar version the digits they leave, as CIRCUITC_digits_hex and binary do. runs and
+// dst are exactly as wide as they have to be, so that a kernel reading or writing past either shows under a sanitiser.
+// versions the CPU doesn't support are left out. prints the first run that doesn't agree and exits with 1; exits with 0 if all do.
+
+#include "bench.h"              // seeded generator
+#include "digits.h"             // digit kernels
+
+#define CIRCUITC_CHECK_DIGITS_LONGEST               300                 // longest run, in digits
+
+typedef bool (*CIRCUITC_check_digits_decode_t)(void* dst, const char* string, const size_t length);
+typedef size_t (*CIRCUITC_check_digits_kernel_t)(void* dst, const char* string, size_t length, uint32_t* invalid);
+
+typedef struct{
+    const char* name;
+    CIRCUITC_check_digits_decode_t decode;          // whole run, if set
+    CIRCUITC_check_digits_kernel_t kernel;          // whole blocks, the digits left being decoded by scalar otherwise
+    CIRCUITC_check_digits_decode_t scalar;
+} CIRCUITC_check_digits_version_t;
+
+const char CIRCUITC_check_hex_digits[]      = "0123456789abcdefABCDEF";
+const char CIRCUITC_check_hex_invalid[]     = "/:@G`g \x80\xff";
+const char CIRCUITC_check_binary_invalid[]  = "/2a\x80\xb1";
+
+// value of digit in base (2 or 16), a digit at a time and written out here, so that it shares nothing with the kernels; -1 if it isn't one
+int CIRCUITC_check_digit_value(const char digit, const int base){
+    for(int value = 0; value < base; value++)
+        if(digit == "0123456789abcdef"[value] || digit == "0123456789ABCDEF"[value]) return value;
+    return -1;
+}
+
+// decodes the length digits of base (2 or 16) at string into bytes, limbs limbs wide and least significant first, the last digit
+// being the least significant one. returns false if any of the characters isn't a digit of base
+bool CIRCUITC_check_decode(uint8_t* bytes, const size_t limbs, const char* string, const size_t length, const int base){
+    const int bits = base == 16? 4: 1;
+    memset(bytes, 0, limbs*sizeof(NOAHZK_limb_t));
+
+    for(size_t i = 0; i < length; i++){
+        const int value = CIRCUITC_check_digit_value(string[length - 1 - i], base);
+        if(value < 0) return false;
+        for(int bit = 0; bit < bits; bit++) bytes[(i*bits + bit)/8] |= (uint8_t)((value >> bit & 1) << (i*bits + bit)%8);
+    }
+
+    return true;
+}
+
+// decodes through version, as CIRCUITC_digits_hex and binary do
+bool CIRCUITC_check_version_decode(const CIRCUITC_check_digits_version_t* version, void* dst, const char* string, const size_t length, const size_t digits_in_limb){
+    if(version->decode) return version->decode(dst, string, length);
+
+    uint32_t invalid = 0;
+    const size_t left = version->kernel(dst, string, length, &invalid);
+    return version->scalar((uint8_t*)dst + (length - left)/digits_in_limb*sizeof(NOAHZK_limb_t), string, left) && !invalid;
+}
+
+// checks versions on runs of base (2 or 16), returning the name of the first that doesn't agree
+const char* CIRCUITC_check_base(const CIRCUITC_check_digits_version_t* versions, const size_t number_of_versions, const int base, const uint64_t c){
+    const size_t digits_in_limb = base == 16? CIRCUITC_DIGITS_HEX_IN_LIMB: CIRCUITC_DIGITS_BINARY_IN_LIMB;
+    const char* invalid_characters = base == 16? CIRCUITC_check_hex_invalid: CIRCUITC_check_binary_invalid;
+    const size_t number_of_invalid = base == 16? sizeof(CIRCUITC_check_hex_invalid): sizeof(CIRCUITC_check_binary_invalid);
+// every length up to a few blocks in turn, then random ones
+    const size_t length = c < 100? c + 1: 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_DIGITS_LONGEST;
+    const size_t limbs = NOAHZK_SIZE_AS_ARR_OF_TYPE(length, digits_in_limb);
+    char* string = malloc(length);
+    uint8_t* expected = malloc(limbs*sizeof(NOAHZK_limb_t));
+    uint8_t* dst = malloc(limbs*sizeof(NOAHZK_limb_t));
+    const char* failed = NULL;
+
+    for(size_t i = 0; i < length; i++) string[i] = base == 16? CIRCUITC_check_hex_digits[CIRCUITC_bench_random()%(sizeof(CIRCUITC_check_hex_digits) - 1)]: (char)('0' + CIRCUITC_bench_random()%2);
+// a third of the runs have a character that isn't a digit; number_of_invalid takes in the terminating 0, which is one of them
+    if(c%3 == 0) string[CIRCUITC_bench_random()%length] = invalid_characters[CIRCUITC_bench_random()%number_of_invalid];
+    const bool valid = CIRCUITC_check_decode(expected, limbs, string, length, base);
+
+    for(size_t v = 0; v < number_of_versions && !failed; v++){
+        const bool got = CIRCUITC_check_version_decode(&versions[v], dst, string, length, digits_in_limb);
+        if(got != valid || (valid && memcmp(dst, expected, limbs*sizeof(NOAHZK_limb_t)))){
+            printf("case %llu: %s %s of %zu digits %s\n", (unsigned long long)c, versions[v].name, base == 16? "hex run": "binary run", length,
+                got != valid? (valid? "is rejected": "isn't rejected"): "differs from decoding a digit at a time");
+            failed = versions[v].name;
+        }
+    }
+
+    free(string);
+    free(expected);
+    free(dst);
+    return failed;
+}
+
+int main(int argc, char** argv){
+    const uint64_t cases = argc > 1? (uint64_t)atoll(argv[1]): 20000;
+    CIRCUITC_check_digits_version_t hex[4], binary[4];
+    size_t number_of_hex = 0, number_of_binary = 0;
+
+    hex[number_of_hex++]       = (CIRCUITC_check_digits_version_t){ "scalar", CIRCUITC_digits_hex_scalar, NULL, NULL };
+    binary[number_of_binary++] = (CIRCUITC_check_digits_version_t){ "scalar", CIRCUITC_digits_binary_scalar, NULL, NULL };
+#ifdef CIRCUITC_DIGITS_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("ssse3")){
+        hex[number_of_hex++]       = (CIRCUITC_check_digits_version_t){ "ssse3", NULL, CIRCUITC_digits_hex_ssse3, CIRCUITC_digits_hex_scalar };
+        binary[number_of_binary++] = (CIRCUITC_check_digits_version_t){ "ssse3", NULL, CIRCUITC_digits_binary_ssse3, CIRCUITC_digits_binary_scalar };
+    }
+    if(__builtin_cpu_supports("avx2")){
+        hex[number_of_hex++]       = (CIRCUITC_check_digits_version_t){ "avx2", NULL, CIRCUITC_digits_hex_avx2, CIRCUITC_digits_hex_scalar };
+        binary[number_of_binary++] = (CIRCUITC_check_digits_version_t){ "avx2", NULL, CIRCUITC_digits_binary_avx2, CIRCUITC_digits_binary_scalar };
+    }
+#endif
+    hex[number_of_hex++]       = (CIRCUITC_check_digits_version_t){ "dispatched", CIRCUITC_digits_hex, NULL, NULL };
+    binary[number_of_binary++] = (CIRCUITC_check_digits_version_t){ "dispatched", CIRCUITC_digits_binary, NULL, NULL };
+
+    for(uint64_t c = 0; c < cases; c++)
+        if(CIRCUITC_check_base(hex, number_of_hex, 16, c) || CIRCUITC_check_base(binary, number_of_binary, 2, c)) return 1;
+
+    printf("%llu hex and binary runs agree with decoding a digit at a time in %zu versions\n", (unsigned long long)cases, number_of_hex);
+    return 0;
+}
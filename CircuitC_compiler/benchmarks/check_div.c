@@ -0,0 +1,234 @@
+// checks division, Barrett reduction and Montgomery multiplication against what they have to agree with, on random operands of random widths.
+//      cc -O2 -I../lexer check_div.c -o check_div -lpthread -lm
+//      ./check_div [cases]
+// - x == q*d + r and r < d for NOAHZK_variable_width_divrem_byte (Knuth's algorithm D, or the single word path), q*d + r worked out by mul_byte
+// - NOAHZK_variable_width_divrem_ct_byte and aliased calls giving the same quotient and remainder as divrem_byte
+// - the NOAHZK_variable_width_t ops constant folding goes through (div, mod and, for divisors of up to 8 bytes, div_constant) giving the same as
+//   divrem_byte, operands being zero-extended to whole limbs and div writing over its dividend
+// - NOAHZK_variable_width_divrem_1_words against the compiler's double-word division
+// - Barrett reduction against mod_byte, and Montgomery multiplication (through Montgomery form and back) against mul_byte then mod_byte;
+//   moduli go up to 6400 bytes, so that Barrett's products are wide enough for Toom-3
+// divisors are random, all ones, a single word, a power of two, sparse or 0, which divides as RISC-V does (quotient all ones, remainder the dividend).
+// prints the first case that doesn't agree and exits with 1; exits with 0 if all do.
+
+#include "stdbool.h"            // boolean type
+#include "bench.h"              // seeded generator
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+typedef enum{ CIRCUITC_CHECK_RANDOM, CIRCUITC_CHECK_ALL_ONES, CIRCUITC_CHECK_ONE_WORD, CIRCUITC_CHECK_POWER_OF_TWO, CIRCUITC_CHECK_SPARSE, CIRCUITC_CHECK_ZERO, CIRCUITC_CHECK_KINDS } CIRCUITC_check_kind_t;
+
+// records what doesn't agree, unless something earlier already didn't, so that a case is reported by the first check it fails
+#define CIRCUITC_CHECK(failed, mismatch, what) if(!(failed) && (mismatch)) (failed) = (what)
+
+const char* CIRCUITC_check_kind_names[CIRCUITC_CHECK_KINDS] = { "random", "all ones", "one word", "power of two", "sparse", "zero" };
+
+void CIRCUITC_check_fill(uint8_t* bytes, const uint64_t width, const CIRCUITC_check_kind_t kind){
+    memset(bytes, 0, width);
+
+    switch(kind){
+        case CIRCUITC_CHECK_RANDOM:         for(uint64_t i = 0; i < width; i++) bytes[i] = (uint8_t)CIRCUITC_bench_random(); break;
+        case CIRCUITC_CHECK_ALL_ONES:       memset(bytes, 0xff, width); break;
+        case CIRCUITC_CHECK_ONE_WORD:       for(uint64_t i = 0; i < width && i < sizeof(NOAHZK_word_t); i++) bytes[i] = (uint8_t)CIRCUITC_bench_random(); break;
+        case CIRCUITC_CHECK_POWER_OF_TWO:   bytes[CIRCUITC_bench_random()%width] = (uint8_t)(1 << CIRCUITC_bench_random()%8); break;
+        case CIRCUITC_CHECK_SPARSE:         for(int i = 0; i < 3; i++) bytes[CIRCUITC_bench_random()%width] |= (uint8_t)(1 << CIRCUITC_bench_random()%8); break;
+        default:                            break;
+    }
+}
+
+// -1, 0 or 1 as rs0 is below, equal to or above rs1, each zero-extended to the wider of the two
+int CIRCUITC_check_compare_byte(const uint8_t* rs0, const uint64_t width0, const uint8_t* rs1, const uint64_t width1){
+    for(uint64_t i = NOAHZK_MAX(width0, width1); i-- > 0;){
+        const uint8_t byte0 = i < width0? rs0[i]: 0, byte1 = i < width1? rs1[i]: 0;
+        if(byte0 != byte1) return byte0 < byte1? -1: 1;
+    }
+    return 0;
+}
+
+bool CIRCUITC_check_is_zero(const uint8_t* bytes, const uint64_t width){
+    for(uint64_t i = 0; i < width; i++) if(bytes[i]) return false;
+    return true;
+}
+
+// initializes dst to bytes, width bytes wide and zero-extended to whole limbs
+void CIRCUITC_check_init_variable_width(NOAHZK_variable_width_t* dst, const uint8_t* bytes, const uint64_t width){
+    NOAHZK_variable_width_init(dst, width);
+    memset(dst->arr, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst));
+    memcpy(dst->arr, bytes, width);
+}
+
+// checks NOAHZK_variable_width_div, mod and div_constant against q and r, which divrem_byte gave for x by d, d not being 0
+const char* CIRCUITC_check_variable_width_division(const uint8_t* x, const uint8_t* d, const uint8_t* q, const uint8_t* r, const uint64_t width0, const uint64_t width1){
+    NOAHZK_variable_width_t dividend, divisor, result;
+    CIRCUITC_check_init_variable_width(&dividend, x, width0);
+    CIRCUITC_check_init_variable_width(&divisor, d, width1);
+    NOAHZK_variable_width_init(&result, 0);
+    const char* failed = NULL;
+
+    if(width1 <= sizeof(uint64_t)){
+        uint64_t k = 0, expected_rem = 0;
+        memcpy(&k, d, width1);
+        memcpy(&expected_rem, r, width1);
+        uint64_t rem = 0;
+        CIRCUITC_CHECK(failed, !NOAHZK_variable_width_div_constant(&result, &dividend, k, &rem), "div_constant failed to grow the workspace");
+        CIRCUITC_CHECK(failed, rem != expected_rem, "div_constant's remainder differs from divrem_byte");
+        CIRCUITC_CHECK(failed, CIRCUITC_check_compare_byte((uint8_t*)result.arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE(result), q, width0) != 0, "div_constant differs from divrem_byte");
+    }
+
+    NOAHZK_variable_width_mod(&result, &dividend, &divisor);
+    CIRCUITC_CHECK(failed, CIRCUITC_check_compare_byte((uint8_t*)result.arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE(result), r, width1) != 0, "mod differs from divrem_byte");
+    NOAHZK_variable_width_div(&dividend, &dividend, &divisor);
+    CIRCUITC_CHECK(failed, CIRCUITC_check_compare_byte((uint8_t*)dividend.arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE(dividend), q, width0) != 0, "div over its dividend differs from divrem_byte");
+
+    NOAHZK_variable_width_destroy(&dividend, NOAHZK_variable_width_keep_ptr);
+    NOAHZK_variable_width_destroy(&divisor, NOAHZK_variable_width_keep_ptr);
+    NOAHZK_variable_width_destroy(&result, NOAHZK_variable_width_keep_ptr);
+    return failed;
+}
+
+// checks a division of x, width0 bytes wide, by d, width1 bytes wide; returns the name of what doesn't agree, or NULL if everything does
+const char* CIRCUITC_check_division(const uint8_t* x, const uint8_t* d, const uint64_t width0, const uint64_t width1){
+    uint8_t* q = malloc(width0);
+    uint8_t* r = malloc(width1);
+    uint8_t* q_ct = malloc(width0);
+    uint8_t* r_ct = malloc(width1);
+    uint8_t* aliased0 = malloc(width0);
+    uint8_t* aliased1 = malloc(width1);
+    uint8_t* product = malloc(width0 + width1);
+    const char* failed = NULL;
+
+    NOAHZK_variable_width_divrem_byte(q, r, x, d, width0, width1);
+
+    if(CIRCUITC_check_is_zero(d, width1)){
+        for(uint64_t i = 0; i < width0; i++) CIRCUITC_CHECK(failed, q[i] != 0xff, "quotient by 0 isn't all ones");
+        CIRCUITC_CHECK(failed, CIRCUITC_check_compare_byte(r, width1, x, NOAHZK_MIN(width0, width1)) != 0, "remainder by 0 isn't the dividend");
+    }
+    else{
+// q*d + r, which can't carry out of width0 + width1 bytes as it is at most x
+        NOAHZK_variable_width_mul_byte(product, q, d, width0, width1);
+        NOAHZK_variable_width_add_byte(product, product, r, width0 + width1, width1, width0 + width1);
+        CIRCUITC_CHECK(failed, CIRCUITC_check_compare_byte(product, width0 + width1, x, width0) != 0, "x != q*d + r");
+        CIRCUITC_CHECK(failed, CIRCUITC_check_compare_byte(r, width1, d, width1) >= 0, "r >= d");
+
+        const char* failed_variable_width = CIRCUITC_check_variable_width_division(x, d, q, r, width0, width1);
+        CIRCUITC_CHECK(failed, failed_variable_width, failed_variable_width);
+    }
+
+    NOAHZK_variable_width_divrem_ct_byte(q_ct, r_ct, x, d, width0, width1);
+    CIRCUITC_CHECK(failed, memcmp(q, q_ct, width0) || memcmp(r, r_ct, width1), "constant-time division differs");
+
+// quotient written over the dividend, remainder over the divisor
+    memcpy(aliased0, x, width0);
+    memcpy(aliased1, d, width1);
+    NOAHZK_variable_width_divrem_byte(aliased0, aliased1, aliased0, aliased1, width0, width1);
+    CIRCUITC_CHECK(failed, memcmp(q, aliased0, width0) || memcmp(r, aliased1, width1), "aliased division differs");
+
+    free(q);
+    free(r);
+    free(q_ct);
+    free(r_ct);
+    free(aliased0);
+    free(aliased1);
+    free(product);
+    return failed;
+}
+
+// checks Barrett reduction and, for odd moduli, Montgomery multiplication by modulus, width bytes wide and nonzero
+const char* CIRCUITC_check_reduction(const uint8_t* modulus, const uint64_t width){
+    uint8_t* rs0 = malloc(2*width);
+    uint8_t* rs1 = malloc(2*width);
+    uint8_t* product = malloc(2*width);
+    uint8_t* expected = malloc(width);
+    uint8_t* dst = malloc(2*width);
+    const char* failed = NULL;
+
+// Barrett asks for src below B^(2n), n being the width of the modulus in words once its leading zero words are dropped
+    NOAHZK_barrett_ctx_t barrett; NOAHZK_variable_width_barrett_init(&barrett, modulus, width);
+    const uint64_t width_src = NOAHZK_MIN(2*width, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*barrett.width));
+    CIRCUITC_check_fill(product, 2*width, CIRCUITC_bench_random()%2? CIRCUITC_CHECK_RANDOM: CIRCUITC_CHECK_ALL_ONES);
+    memset(product + width_src, 0, 2*width - width_src);
+    NOAHZK_variable_width_mod_byte(expected, product, modulus, 2*width, width);
+    NOAHZK_variable_width_barrett_reduce_byte(&barrett, dst, product, 2*width);
+    CIRCUITC_CHECK(failed, memcmp(dst, expected, width), "barrett differs from mod");
+    memcpy(dst, product, 2*width);
+    NOAHZK_variable_width_barrett_reduce_byte(&barrett, dst, dst, 2*width);
+    CIRCUITC_CHECK(failed, memcmp(dst, expected, width), "aliased barrett differs from mod");
+    NOAHZK_variable_width_barrett_destroy(&barrett, NOAHZK_variable_width_keep_ptr);
+
+    NOAHZK_montgomery_ctx_t montgomery;
+    if(NOAHZK_variable_width_montgomery_init(&montgomery, modulus, width)){
+// operands below the modulus
+        CIRCUITC_check_fill(dst, 2*width, CIRCUITC_CHECK_RANDOM);
+        NOAHZK_variable_width_mod_byte(rs0, dst, modulus, 2*width, width);
+        CIRCUITC_check_fill(dst, 2*width, CIRCUITC_CHECK_RANDOM);
+        NOAHZK_variable_width_mod_byte(rs1, dst, modulus, 2*width, width);
+        NOAHZK_variable_width_mul_byte(product, rs0, rs1, width, width);
+        NOAHZK_variable_width_mod_byte(expected, product, modulus, 2*width, width);
+
+        NOAHZK_variable_width_montgomery_to_byte(&montgomery, rs0, rs0);
+        NOAHZK_variable_width_montgomery_to_byte(&montgomery, rs1, rs1);
+        NOAHZK_variable_width_montgomery_mul_byte(&montgomery, dst, rs0, rs1);
+        NOAHZK_variable_width_montgomery_from_byte(&montgomery, dst, dst);
+        CIRCUITC_CHECK(failed, memcmp(dst, expected, width), "montgomery differs from mul + mod");
+        NOAHZK_variable_width_montgomery_destroy(&montgomery, NOAHZK_variable_width_keep_ptr);
+    }
+    else CIRCUITC_CHECK(failed, modulus[0] & 1, "montgomery refused an odd modulus");
+
+    free(rs0);
+    free(rs1);
+    free(product);
+    free(expected);
+    free(dst);
+    return failed;
+}
+
+int main(int argc, char** argv){
+    const uint64_t cases = argc > 1? (uint64_t)atoll(argv[1]): 4000;
+
+    for(uint64_t c = 0; c < cases; c++){
+// mostly narrow operands, where the word paths meet their edges, some wide enough for Karatsuba to take part, and a few for Toom-3
+        const uint64_t widest = c%64 == 0? 6400: c%16 == 0? 1200: 72;
+        const uint64_t width0 = 1 + CIRCUITC_bench_random()%widest, width1 = 1 + CIRCUITC_bench_random()%widest;
+        const CIRCUITC_check_kind_t dividend_kind = (CIRCUITC_check_kind_t)(CIRCUITC_bench_random()%CIRCUITC_CHECK_ZERO), divisor_kind = (CIRCUITC_check_kind_t)(c%CIRCUITC_CHECK_KINDS);
+        uint8_t* x = malloc(width0);
+        uint8_t* d = malloc(width1);
+        CIRCUITC_check_fill(x, width0, dividend_kind);
+        CIRCUITC_check_fill(d, width1, divisor_kind);
+
+        const char* failed = CIRCUITC_check_division(x, d, width0, width1);
+        if(!failed && !CIRCUITC_check_is_zero(d, width1)){
+            if(c%2) d[0] |= 1;
+            failed = CIRCUITC_check_reduction(d, width1);
+        }
+        free(x);
+        free(d);
+        if(failed){
+            printf("case %llu: %s (%s dividend of %llu bytes, %s divisor of %llu bytes)\n", (unsigned long long)c, failed,
+                CIRCUITC_check_kind_names[dividend_kind], (unsigned long long)width0, CIRCUITC_check_kind_names[divisor_kind], (unsigned long long)width1);
+            return 1;
+        }
+    }
+
+    for(uint64_t c = 0; c < cases; c++){
+        const uint64_t words = 1 + CIRCUITC_bench_random()%32;
+        NOAHZK_word_t src[32], quot[32], expected[32];
+        CIRCUITC_check_fill((uint8_t*)src, sizeof(src), CIRCUITC_bench_random()%2? CIRCUITC_CHECK_RANDOM: CIRCUITC_CHECK_ALL_ONES);
+        NOAHZK_word_t d = (NOAHZK_word_t)CIRCUITC_bench_random();
+        if(c%3 == 0) d >>= CIRCUITC_bench_random()%BITS_IN_NOAHZK_WORD;
+        if(!d) d = 1;
+
+        NOAHZK_dword_t rem = 0;
+        for(uint64_t i = words; i-- > 0;){
+            const NOAHZK_dword_t dividend = rem << BITS_IN_NOAHZK_WORD | src[i];
+            expected[i] = (NOAHZK_word_t)(dividend/d);
+            rem = dividend%d;
+        }
+        if(NOAHZK_variable_width_divrem_1_words(quot, src, words, d) != (NOAHZK_word_t)rem || memcmp(quot, expected, words*sizeof(NOAHZK_word_t))){
+            printf("case %llu: single word division differs from the compiler's (%llu words)\n", (unsigned long long)c, (unsigned long long)words);
+            return 1;
+        }
+    }
+
+    printf("%llu divisions and reductions, %llu single word divisions agree\n", (unsigned long long)cases, (unsigned long long)cases);
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
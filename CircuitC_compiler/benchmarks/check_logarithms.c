@@ -0,0 +1,148 @@
+// checks bit length, trailing zero count and popcount of byte arrays, and the AVX2 kernels they go through, against bit by bit loops.
+//      cc -O2 -I../lexer check_logarithms.c -o check_logarithms -lpthread -lm
+//      ./check_logarithms [cases]
+// - NOAHZK_variable_width_min_bitcnt_byte, min_bytecnt_byte, ctz_byte and popcount_byte, on sizes either side of where they take the AVX2
+//   kernels, most of which aren't whole words
+// - on x86-64 with AVX2, NOAHZK_variable_width_top_word_avx2, bottom_word_avx2 and popcount_avx2 called directly, against a scalar loop over
+//   the same whole vectors
+// - NOAHZK_min_bitcnt_var, min_bytecnt_var and ceil_log2_value on random values, powers of two and those either side of them
+// values are random, 0, a single bit (so that the word that has the last say is anywhere: in a vector, in the words left over or in a partial
+// last word) or sparse. prints the first value that doesn't agree and exits with 1; exits with 0 if all do.
+
+#include "bench.h"              // seeded generator
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+#define CIRCUITC_CHECK_LOGARITHMS_WIDEST            1100                // widest value, in bytes: a few times the AVX2 threshold
+
+typedef enum{ CIRCUITC_CHECK_RANDOM, CIRCUITC_CHECK_ZERO, CIRCUITC_CHECK_ONE_BIT, CIRCUITC_CHECK_SPARSE, CIRCUITC_CHECK_KINDS } CIRCUITC_check_kind_t;
+
+const char* CIRCUITC_check_kind_names[CIRCUITC_CHECK_KINDS] = { "random", "zero", "one bit", "sparse" };
+
+// records what doesn't agree, unless something earlier already didn't, so that a case is reported by the first check it fails
+#define CIRCUITC_CHECK(failed, mismatch, what) if(!(failed) && (mismatch)) (failed) = (what)
+
+void CIRCUITC_check_fill(uint8_t* bytes, const uint64_t width, const CIRCUITC_check_kind_t kind){
+    memset(bytes, 0, width);
+
+    switch(kind){
+        case CIRCUITC_CHECK_RANDOM:         for(uint64_t i = 0; i < width; i++) bytes[i] = (uint8_t)CIRCUITC_bench_random(); break;
+        case CIRCUITC_CHECK_ONE_BIT:        bytes[CIRCUITC_bench_random()%width] = (uint8_t)(1 << CIRCUITC_bench_random()%8); break;
+        case CIRCUITC_CHECK_SPARSE:         for(int i = 0; i < 3; i++) bytes[CIRCUITC_bench_random()%width] |= (uint8_t)(1 << CIRCUITC_bench_random()%8); break;
+        default:                            break;
+    }
+}
+
+int CIRCUITC_check_bit(const uint8_t* bytes, const uint64_t bit){
+    return bytes[bit/BITS_IN_UINT8_T] >> bit%BITS_IN_UINT8_T & 1;
+}
+
+// bit length, trailing zero count (all of the bits if 0) and popcount of bytes, width bytes wide, a bit at a time
+void CIRCUITC_check_counts(const uint8_t* bytes, const uint64_t width, uint64_t* bitcnt, uint64_t* ctz, uint64_t* popcount){
+    *bitcnt = 0; *ctz = width*BITS_IN_UINT8_T; *popcount = 0;
+
+    for(uint64_t bit = 0; bit < width*BITS_IN_UINT8_T; bit++){
+        if(!CIRCUITC_check_bit(bytes, bit)) continue;
+        *bitcnt = bit + 1;
+        if(*ctz == width*BITS_IN_UINT8_T) *ctz = bit;
+        (*popcount)++;
+    }
+}
+
+// checks the uint64_t counts on value, against a bit at a time
+const char* CIRCUITC_check_value(const uint64_t value){
+    uint64_t bitcnt = 0, bytecnt, ceil_log2 = 0;
+    const char* failed = NULL;
+
+    for(uint64_t bit = 0; bit < BITS_IN_UINT64_T; bit++) if(value >> bit & 1) bitcnt = bit + 1;
+    bytecnt = (bitcnt + BITS_IN_UINT8_T - 1)/BITS_IN_UINT8_T;
+    while(ceil_log2 < BITS_IN_UINT64_T && (uint64_t)1 << ceil_log2 < value) ceil_log2++;
+
+    CIRCUITC_CHECK(failed, NOAHZK_min_bitcnt_var(value) != bitcnt, "min_bitcnt_var differs from the bit by bit count");
+    CIRCUITC_CHECK(failed, NOAHZK_min_bytecnt_var(value) != bytecnt, "min_bytecnt_var differs from the bit by bit count");
+    CIRCUITC_CHECK(failed, NOAHZK_ceil_log2_value(value) != ceil_log2, "ceil_log2_value differs from the bit by bit count");
+    return failed;
+}
+
+#ifdef NOAHZK_LOGARITHMS_X86_64
+// checks the AVX2 kernels on the whole vectors of bytes, width bytes wide, against a scalar loop over the same words
+const char* CIRCUITC_check_kernels(const uint8_t* bytes, const uint64_t width){
+    const uint64_t words = width/sizeof(NOAHZK_word_t) & ~(uint64_t)3;
+    uint64_t top = 0, bottom = 0, popcount = 0, got_top, got_bottom, got_popcount;
+    NOAHZK_word_t top_word = 0, bottom_word = 0, got_top_word, got_bottom_word;
+    const char* failed = NULL;
+
+    for(uint64_t i = 0; i < words; i++){
+        NOAHZK_word_t word;
+        memcpy(&word, bytes + i*sizeof(word), sizeof(word));
+        if(word && !bottom){ bottom = i + 1; bottom_word = word; }
+        if(word){ top = i + 1; top_word = word; }
+        popcount += (uint64_t)__builtin_popcountll(word);
+    }
+
+    CIRCUITC_CHECK(failed, NOAHZK_variable_width_top_word_avx2(bytes, width, &got_top, &got_top_word) != words, "top_word_avx2 looks at the wrong number of words");
+    CIRCUITC_CHECK(failed, got_top != top || got_top_word != top_word, "top_word_avx2 differs from the scalar loop");
+    CIRCUITC_CHECK(failed, NOAHZK_variable_width_bottom_word_avx2(bytes, width, &got_bottom, &got_bottom_word) != words, "bottom_word_avx2 looks at the wrong number of words");
+    CIRCUITC_CHECK(failed, got_bottom != bottom || got_bottom_word != bottom_word, "bottom_word_avx2 differs from the scalar loop");
+    CIRCUITC_CHECK(failed, NOAHZK_variable_width_popcount_avx2(bytes, width, &got_popcount) != words, "popcount_avx2 looks at the wrong number of words");
+    CIRCUITC_CHECK(failed, got_popcount != popcount, "popcount_avx2 differs from the scalar loop");
+    return failed;
+}
+#endif
+
+int main(int argc, char** argv){
+    const uint64_t cases = argc > 1? (uint64_t)atoll(argv[1]): 20000;
+    int avx2 = 0;
+
+#ifdef NOAHZK_LOGARITHMS_X86_64
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    for(uint64_t c = 0; c < cases; c++){
+// every size up to past the AVX2 threshold in turn, then random ones
+        const uint64_t width = c < 2*NOAHZK_LOGARITHMS_AVX2_MIN_WIDTH? c + 1: 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_LOGARITHMS_WIDEST;
+        const CIRCUITC_check_kind_t kind = (CIRCUITC_check_kind_t)(CIRCUITC_bench_random()%CIRCUITC_CHECK_KINDS);
+        uint8_t* bytes = malloc(width);
+        uint64_t bitcnt, ctz, popcount;
+        const char* failed = NULL;
+
+        CIRCUITC_check_fill(bytes, width, kind);
+        CIRCUITC_check_counts(bytes, width, &bitcnt, &ctz, &popcount);
+
+        CIRCUITC_CHECK(failed, NOAHZK_variable_width_min_bitcnt_byte(bytes, width) != bitcnt, "min_bitcnt_byte differs from the bit by bit count");
+        CIRCUITC_CHECK(failed, NOAHZK_variable_width_min_bytecnt_byte(bytes, width) != (bitcnt + BITS_IN_UINT8_T - 1)/BITS_IN_UINT8_T, "min_bytecnt_byte differs from the bit by bit count");
+        CIRCUITC_CHECK(failed, NOAHZK_variable_width_ctz_byte(bytes, width) != ctz, "ctz_byte differs from the bit by bit count");
+        CIRCUITC_CHECK(failed, NOAHZK_variable_width_popcount_byte(bytes, width) != popcount, "popcount_byte differs from the bit by bit count");
+#ifdef NOAHZK_LOGARITHMS_X86_64
+        if(!failed && avx2) failed = CIRCUITC_check_kernels(bytes, width);
+#endif
+
+        free(bytes);
+        if(failed){
+            printf("case %llu: %s (%s value of %llu bytes)\n", (unsigned long long)c, failed, CIRCUITC_check_kind_names[kind], (unsigned long long)width);
+            return 1;
+        }
+    }
+
+// powers of two, those either side of them, and random values
+    for(uint64_t bit = 0; bit < BITS_IN_UINT64_T; bit++)
+        for(int64_t offset = -1; offset <= 1; offset++){
+            const uint64_t value = ((uint64_t)1 << bit) + (uint64_t)offset;
+            const char* failed = CIRCUITC_check_value(value);
+            if(failed){
+                printf("%llu: %s\n", (unsigned long long)value, failed);
+                return 1;
+            }
+        }
+    for(uint64_t c = 0; c < cases; c++){
+        const uint64_t value = CIRCUITC_bench_random() >> CIRCUITC_bench_random()%BITS_IN_UINT64_T;
+        const char* failed = CIRCUITC_check_value(value);
+        if(failed){
+            printf("%llu: %s\n", (unsigned long long)value, failed);
+            return 1;
+        }
+    }
+
+    printf("%llu values agree with the bit by bit counts%s\n", (unsigned long long)cases, avx2? ", AVX2 kernels included": "");
+    return 0;
+}
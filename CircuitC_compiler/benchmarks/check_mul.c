@@ -0,0 +1,228 @@
+// checks the Karatsuba and Toom-3 multiplication kernels, the squaring kernels and the fused multiply-accumulate kernels against schoolbook
+// multiplication, on random operands of random widths.
+//      cc -O2 -I../lexer check_mul.c -o check_mul -lpthread -lm
+//      ./check_mul [cases]
+// the cutoffs are lowered here, so that operands of a few words already go through Karatsuba and Toom-3, and wider ones through Toom-3
+// recursing into Toom-3, Karatsuba and schoolbook in turn:
+// - NOAHZK_variable_width_mul_karatsuba_words and mul_toom3_words called directly, given exactly NOAHZK_variable_width_mul_balanced_scratch words
+//   of scratch filled with garbage, so that a kernel that takes more (or reads what it didn't write) shows
+// - NOAHZK_variable_width_mul_byte on equal and unequal widths, most of which aren't whole words, and with dst aliasing an operand
+// - squares: sqr_schoolbook_words, sqr_karatsuba_words and mul_toom3_words given the same operand twice, and mul_byte and square_byte on
+//   the same array, square_byte also with dst over its operand
+// - the fused kernels: addmul_1_words and submul_1_words (and the word they return), mul_1_byte (and the carry it returns), and
+//   addmul_constant_byte and submul_constant_byte, also with dst over src, each for a random multiplier
+// operands are random, all ones (whose products carry the furthest) or sparse.
+// the reference is a word by word schoolbook product, written out here so that it shares nothing with the library's kernels.
+// prints the first product that doesn't agree and exits with 1; exits with 0 if all do.
+
+#define NOAHZK_MUL_KARATSUBA_CUTOFF                 4
+#define NOAHZK_MUL_TOOM3_CUTOFF                     12
+
+#include "bench.h"              // seeded generator
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+#define CIRCUITC_CHECK_MUL_WIDEST                   200                 // widest operand, in words: Toom-3 three levels deep
+
+typedef enum{ CIRCUITC_CHECK_RANDOM, CIRCUITC_CHECK_ALL_ONES, CIRCUITC_CHECK_SPARSE, CIRCUITC_CHECK_KINDS } CIRCUITC_check_kind_t;
+
+const char* CIRCUITC_check_kind_names[CIRCUITC_CHECK_KINDS] = { "random", "all ones", "sparse" };
+
+// dst = rs0*rs1, dst being width0 + width1 words wide
+void CIRCUITC_check_schoolbook_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1){
+    memset(dst, 0, (width0 + width1)*sizeof(NOAHZK_word_t));
+
+    for(uint64_t i = 0; i < width0; i++){
+        NOAHZK_word_t carry = 0;
+        for(uint64_t j = 0; j < width1; j++){
+            const NOAHZK_dword_t t = (NOAHZK_dword_t)rs0[i]*rs1[j] + dst[i + j] + carry;
+            dst[i + j] = (NOAHZK_word_t)t;
+            carry = (NOAHZK_word_t)(t >> BITS_IN_NOAHZK_WORD);
+        }
+        dst[i + width1] = carry;
+    }
+}
+
+// dst = rs0 + rs1, or rs0 - rs1 if subtract, all three being width words wide; returns the carry (or borrow) out of dst
+NOAHZK_word_t CIRCUITC_check_add_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const int subtract){
+    NOAHZK_word_t carry = 0;
+
+    for(uint64_t i = 0; i < width; i++){
+        const NOAHZK_dword_t t = subtract? (NOAHZK_dword_t)rs0[i] - rs1[i] - carry: (NOAHZK_dword_t)rs0[i] + rs1[i] + carry;
+        dst[i] = (NOAHZK_word_t)t;
+        carry = (NOAHZK_word_t)(t >> BITS_IN_NOAHZK_WORD) & 1;
+    }
+
+    return carry;
+}
+
+// fills words words of arr, only the low width bytes of which are nonzero
+void CIRCUITC_check_fill(NOAHZK_word_t* arr, const uint64_t words, const uint64_t width, const CIRCUITC_check_kind_t kind){
+    uint8_t* bytes = (uint8_t*)arr;
+    memset(arr, 0, words*sizeof(NOAHZK_word_t));
+
+    switch(kind){
+        case CIRCUITC_CHECK_RANDOM:         for(uint64_t i = 0; i < width; i++) bytes[i] = (uint8_t)CIRCUITC_bench_random(); break;
+        case CIRCUITC_CHECK_ALL_ONES:       memset(bytes, 0xff, width); break;
+        default:                            for(int i = 0; i < 3; i++) bytes[CIRCUITC_bench_random()%width] |= (uint8_t)(1 << CIRCUITC_bench_random()%8); break;
+    }
+}
+
+// checks NOAHZK_variable_width_mul_karatsuba_words (sqr_karatsuba_words if rs0 is rs1) and mul_toom3_words on operands width words wide,
+// which is more than NOAHZK_MUL_KARATSUBA_CUTOFF
+const char* CIRCUITC_check_kernels(const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const NOAHZK_word_t* expected, const uint64_t width){
+    const uint64_t scratch_width = NOAHZK_variable_width_mul_balanced_scratch(width);
+    NOAHZK_word_t* scratch = malloc(scratch_width*sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* dst = malloc(2*width*sizeof(NOAHZK_word_t));
+    const char* failed = NULL;
+
+    memset(scratch, 0xa5, scratch_width*sizeof(NOAHZK_word_t));
+    if(rs0 == rs1) NOAHZK_variable_width_sqr_karatsuba_words(dst, rs0, width, scratch);
+    else NOAHZK_variable_width_mul_karatsuba_words(dst, rs0, rs1, width, scratch);
+    if(memcmp(dst, expected, 2*width*sizeof(NOAHZK_word_t))) failed = rs0 == rs1? "karatsuba square differs from schoolbook": "karatsuba differs from schoolbook";
+
+    if(!failed){
+        memset(scratch, 0xa5, scratch_width*sizeof(NOAHZK_word_t));
+        NOAHZK_variable_width_mul_toom3_words(dst, rs0, rs1, width, scratch);
+        if(memcmp(dst, expected, 2*width*sizeof(NOAHZK_word_t))) failed = rs0 == rs1? "toom-3 square differs from schoolbook": "toom-3 differs from schoolbook";
+    }
+
+    free(scratch);
+    free(dst);
+    return failed;
+}
+
+// checks NOAHZK_variable_width_sqr_schoolbook_words, the square kernels through CIRCUITC_check_kernels, mul_byte on the same array and
+// square_byte on src, width bytes (words words) wide
+const char* CIRCUITC_check_square(const NOAHZK_word_t* src, const uint64_t words, const uint64_t width){
+    NOAHZK_word_t* expected = malloc(2*words*sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* dst = malloc(2*words*sizeof(NOAHZK_word_t));
+    const char* failed = NULL;
+
+    CIRCUITC_check_schoolbook_words(expected, src, src, words, words);
+    NOAHZK_variable_width_sqr_schoolbook_words(dst, src, words);
+    if(memcmp(dst, expected, 2*words*sizeof(NOAHZK_word_t))) failed = "schoolbook square differs from schoolbook";
+
+    if(!failed && words > NOAHZK_MUL_KARATSUBA_CUTOFF) failed = CIRCUITC_check_kernels(src, src, expected, words);
+
+    NOAHZK_variable_width_mul_byte(dst, src, src, width, width);
+    if(!failed && memcmp(dst, expected, 2*width)) failed = "mul_byte of an array by itself differs from schoolbook";
+    NOAHZK_variable_width_square_byte(dst, src, width);
+    if(!failed && memcmp(dst, expected, 2*width)) failed = "square_byte differs from schoolbook";
+// dst over the operand
+    memcpy(dst, src, width);
+    NOAHZK_variable_width_square_byte(dst, dst, width);
+    if(!failed && memcmp(dst, expected, 2*width)) failed = "square_byte over its operand differs from schoolbook";
+
+    free(expected);
+    free(dst);
+    return failed;
+}
+
+// checks the fused kernels on acc (width0 bytes, words0 words) and src (width1 bytes, words1 words); if acc is src, the byte kernels are
+// given dst as src too. dst is exactly as wide as the kernels are told, so that one writing past it shows under a sanitiser
+const char* CIRCUITC_check_fused(const NOAHZK_word_t* acc, const NOAHZK_word_t* src, const uint64_t words0, const uint64_t words1, const uint64_t width0, const uint64_t width1){
+    const uint64_t words = words0 < words1? words0: words1;
+    const uint64_t k = CIRCUITC_bench_random();
+    const NOAHZK_word_t k_word = (NOAHZK_word_t)k, carry = (NOAHZK_word_t)CIRCUITC_bench_random();
+    NOAHZK_word_t k_words[NOAHZK_WORDS_IN_UINT64];
+    memcpy(k_words, &k, sizeof(k));
+
+    const uint64_t width_product = words1 + NOAHZK_WORDS_IN_UINT64 > words0 + 1? words1 + NOAHZK_WORDS_IN_UINT64: words0 + 1;
+    NOAHZK_word_t* product = calloc(width_product, sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* expected = calloc(width_product, sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* words_dst = malloc(words*sizeof(NOAHZK_word_t));
+    uint8_t* dst = malloc(width0);
+    const char* failed = NULL;
+
+// dst += src*k and dst -= src*k over the narrower operand's words, and what they carry out
+    CIRCUITC_check_schoolbook_words(product, src, &k_word, words, 1);
+    for(int subtract = 0; subtract < 2 && !failed; subtract++){
+        const NOAHZK_word_t expected_carry = product[words] + CIRCUITC_check_add_words(expected, acc, product, words, subtract);
+        memcpy(words_dst, acc, words*sizeof(NOAHZK_word_t));
+        const NOAHZK_word_t got = subtract? NOAHZK_variable_width_submul_1_words(words_dst, src, words, k_word): NOAHZK_variable_width_addmul_1_words(words_dst, src, words, k_word);
+        if(memcmp(words_dst, expected, words*sizeof(NOAHZK_word_t))) failed = subtract? "submul_1_words differs from schoolbook": "addmul_1_words differs from schoolbook";
+        else if(got != expected_carry) failed = subtract? "submul_1_words returns the wrong carry": "addmul_1_words returns the wrong carry";
+    }
+
+// dst = acc*k + carry, in place, and what's carried out of its width0 bytes
+    if(!failed){
+        NOAHZK_word_t expected_carry = 0;
+        memset(product, 0, width_product*sizeof(NOAHZK_word_t));
+        memset(expected, 0, width_product*sizeof(NOAHZK_word_t));
+        CIRCUITC_check_schoolbook_words(product, acc, &k_word, words0, 1);
+        expected[0] = carry;
+        CIRCUITC_check_add_words(expected, product, expected, words0 + 1, 0);
+        memcpy(&expected_carry, (uint8_t*)expected + width0, sizeof(NOAHZK_word_t));
+        memcpy(dst, acc, width0);
+        if(NOAHZK_variable_width_mul_1_byte(dst, dst, k_word, carry, width0) != expected_carry) failed = "mul_1_byte returns the wrong carry";
+        else if(memcmp(dst, expected, width0)) failed = "mul_1_byte differs from schoolbook";
+    }
+
+// dst += src*k and dst -= src*k for a uint64_t k, truncated to width0 bytes
+    memset(product, 0, width_product*sizeof(NOAHZK_word_t));
+    CIRCUITC_check_schoolbook_words(product, src, k_words, words1, NOAHZK_WORDS_IN_UINT64);
+    for(int subtract = 0; subtract < 2 && !failed; subtract++){
+        CIRCUITC_check_add_words(expected, acc, product, words0, subtract);
+        memcpy(dst, acc, width0);
+        const void* from = acc == src? (const void*)dst: (const void*)src;
+        if(subtract) NOAHZK_variable_width_submul_constant_byte(dst, from, k, width0, width1);
+        else NOAHZK_variable_width_addmul_constant_byte(dst, from, k, width0, width1);
+        if(memcmp(dst, expected, width0)) failed = subtract? "submul_constant_byte differs from schoolbook": "addmul_constant_byte differs from schoolbook";
+    }
+
+    free(product);
+    free(expected);
+    free(words_dst);
+    free(dst);
+    return failed;
+}
+
+int main(int argc, char** argv){
+    const uint64_t cases = argc > 1? (uint64_t)atoll(argv[1]): 3000;
+    NOAHZK_word_t* rs0 = malloc(CIRCUITC_CHECK_MUL_WIDEST*sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* rs1 = malloc(CIRCUITC_CHECK_MUL_WIDEST*sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* expected = malloc(2*CIRCUITC_CHECK_MUL_WIDEST*sizeof(NOAHZK_word_t));
+    uint8_t* dst = malloc(2*CIRCUITC_CHECK_MUL_WIDEST*sizeof(NOAHZK_word_t));
+
+    for(uint64_t c = 0; c < cases; c++){
+// every width up to a few times the Toom-3 cutoff in turn, then random ones; every other case unequal, and most not whole words
+        const uint64_t words0 = c < 4*NOAHZK_MUL_TOOM3_CUTOFF? c%(4*NOAHZK_MUL_TOOM3_CUTOFF) + 1: 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_MUL_WIDEST;
+        const uint64_t words1 = c%2? 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_MUL_WIDEST: words0;
+        const uint64_t width0 = words0*sizeof(NOAHZK_word_t) - CIRCUITC_bench_random()%sizeof(NOAHZK_word_t);
+        const uint64_t width1 = words1 == words0? width0: words1*sizeof(NOAHZK_word_t) - CIRCUITC_bench_random()%sizeof(NOAHZK_word_t);
+        const CIRCUITC_check_kind_t kind0 = (CIRCUITC_check_kind_t)(c%CIRCUITC_CHECK_KINDS), kind1 = (CIRCUITC_check_kind_t)(CIRCUITC_bench_random()%CIRCUITC_CHECK_KINDS);
+        const char* failed = NULL;
+
+        CIRCUITC_check_fill(rs0, words0, width0, kind0);
+        CIRCUITC_check_fill(rs1, words1, width1, kind1);
+        CIRCUITC_check_schoolbook_words(expected, rs0, rs1, words0, words1);
+
+        if(words0 == words1 && words0 > NOAHZK_MUL_KARATSUBA_CUTOFF) failed = CIRCUITC_check_kernels(rs0, rs1, expected, words0);
+
+        NOAHZK_variable_width_mul_byte(dst, rs0, rs1, width0, width1);
+        if(!failed && memcmp(dst, expected, width0 + width1)) failed = "mul_byte differs from schoolbook";
+// dst over the first operand
+        memcpy(dst, rs0, width0);
+        NOAHZK_variable_width_mul_byte(dst, dst, rs1, width0, width1);
+        if(!failed && memcmp(dst, expected, width0 + width1)) failed = "mul_byte over its operand differs from schoolbook";
+
+        if(!failed) failed = CIRCUITC_check_square(rs0, words0, width0);
+        if(!failed) failed = CIRCUITC_check_fused(rs0, rs1, words0, words1, width0, width1);
+        if(!failed) failed = CIRCUITC_check_fused(rs0, rs0, words0, words0, width0, width0);
+
+        if(failed){
+            printf("case %llu: %s (%s operand of %llu bytes, %s operand of %llu bytes)\n", (unsigned long long)c, failed,
+                CIRCUITC_check_kind_names[kind0], (unsigned long long)width0, CIRCUITC_check_kind_names[kind1], (unsigned long long)width1);
+            return 1;
+        }
+    }
+
+    free(rs0);
+    free(rs1);
+    free(expected);
+    free(dst);
+
+    printf("%llu products, squares and fused products agree with schoolbook\n", (unsigned long long)cases);
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
@@ -0,0 +1,219 @@
+// checks the transforms, and products done by them (three primes, put back together by the Chinese remainder theorem), against references.
+//      cc -O2 -I../lexer check_ntt.c -o check_ntt -lpthread -lm
+//      ./check_ntt
+// built with -fopenmp, the primes' transforms of 2^14 words or more run in parallel; built with -U__SIZEOF_INT128__, words are 32 bits wide,
+// and transforms are done modulo the primes that go with those. all of these should be run.
+// - each prime's transforms, forward and inverse, against a transform worked out term by term modulo that prime, on lengths up to
+//   2^CIRCUITC_CHECK_NTT_LOG_LENGTH; and that each prime has roots of unity of order 2^NOAHZK_NTT_MAX_LOG_LENGTH, which its generator gives
+// - NOAHZK_variable_width_mul_byte on either side of NOAHZK_MUL_NTT_CUTOFF and NOAHZK_MUL_NTT_FULL_CUTOFF, on equal and unequal widths and on squares
+//   (both operands the same array), each width pair asserting NOAHZK_variable_width_mul_takes_ntt says what it's expected to, so the transforms really run
+// - operands of all ones, whose coefficients are the largest a product of those widths has, which is what the three primes' product has to stay above
+// - NOAHZK_variable_width_pow_constant, whose squarings are wide enough to be done by transforms, against multiplying by the base over and over
+// the references are a word by word schoolbook product and modular arithmetic by the compiler's double-word division, written out here
+// so that they share nothing with the library's kernels.
+// prints the first transform or product that doesn't agree and exits with 1; exits with 0 if all do.
+
+#include "bench.h"              // seeded generator
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+#define CIRCUITC_CHECK_NTT_LOG_LENGTH               8                   // transforms are checked term by term on lengths up to 2^this
+
+// base^exponent mod p
+NOAHZK_word_t CIRCUITC_check_pow_mod(NOAHZK_word_t base, NOAHZK_word_t exponent, const NOAHZK_word_t p){
+    NOAHZK_word_t power = 1;
+
+    for(; exponent; exponent >>= 1, base = (NOAHZK_word_t)((NOAHZK_dword_t)base*base % p)) if(exponent & 1) power = (NOAHZK_word_t)((NOAHZK_dword_t)power*base % p);
+    return power;
+}
+
+// checks the transforms of length 2^log_length modulo p against the transform worked out term by term, which the forward transform
+// leaves in bit-reversed order; returns the name of what doesn't agree, or NULL if everything does
+const char* CIRCUITC_check_transforms(const NOAHZK_word_t p, const NOAHZK_word_t generator, const uint64_t log_length){
+    const NOAHZK_ntt_prime_t prime = NOAHZK_ntt_prime_init(p);
+    const uint64_t length = (uint64_t)1 << log_length;
+    const NOAHZK_word_t root = CIRCUITC_check_pow_mod(generator, (p - 1) >> log_length, p);
+    NOAHZK_word_t residues[1 << CIRCUITC_CHECK_NTT_LOG_LENGTH], expected[1 << CIRCUITC_CHECK_NTT_LOG_LENGTH], transform[1 << CIRCUITC_CHECK_NTT_LOG_LENGTH];
+    NOAHZK_word_t roots[1 << CIRCUITC_CHECK_NTT_LOG_LENGTH], inverse_roots[1 << CIRCUITC_CHECK_NTT_LOG_LENGTH];
+
+    for(uint64_t i = 0; i < length; i++) residues[i] = (NOAHZK_word_t)CIRCUITC_bench_random()%p;
+    for(uint64_t j = 0; j < length; j++){
+        const NOAHZK_word_t step = CIRCUITC_check_pow_mod(root, (NOAHZK_word_t)j, p);
+        NOAHZK_word_t sum = 0, power = 1;
+        for(uint64_t i = 0; i < length; i++, power = (NOAHZK_word_t)((NOAHZK_dword_t)power*step % p)) sum = (NOAHZK_word_t)(((NOAHZK_dword_t)residues[i]*power + sum) % p);
+
+        uint64_t reversed = 0;
+        for(uint64_t bit = 0; bit < log_length; bit++) reversed |= (j >> bit & 1) << (log_length - 1 - bit);
+        expected[reversed] = sum;
+    }
+
+// residues go into Montgomery form and out of it as NOAHZK_variable_width_mul_ntt_residues_words takes them there and back
+    NOAHZK_ntt_roots(roots, NOAHZK_ntt_mul(root, prime.r2, &prime), length, &prime);
+    NOAHZK_ntt_roots(inverse_roots, NOAHZK_ntt_mul(CIRCUITC_check_pow_mod(root, (NOAHZK_word_t)(length - 1), p), prime.r2, &prime), length, &prime);
+    for(uint64_t i = 0; i < length; i++) transform[i] = NOAHZK_ntt_mul(residues[i], prime.r2, &prime);
+    NOAHZK_ntt_forward(transform, roots, length, &prime);
+    for(uint64_t i = 0; i < length; i++) if(NOAHZK_ntt_mul(transform[i], 1, &prime) != expected[i]) return "forward transform differs from the one worked out term by term";
+// the inverse transform leaves out the factor of length^-1
+    NOAHZK_ntt_inverse(transform, inverse_roots, length, &prime);
+    for(uint64_t i = 0; i < length; i++) if(NOAHZK_ntt_mul(transform[i], 1, &prime) != (NOAHZK_word_t)((NOAHZK_dword_t)residues[i]*length % p)) return "inverse transform doesn't undo the forward one";
+
+    return NULL;
+}
+
+// dst = rs0*rs1, dst being width0 + width1 words wide
+void CIRCUITC_check_schoolbook_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1){
+    memset(dst, 0, (width0 + width1)*sizeof(NOAHZK_word_t));
+
+    for(uint64_t i = 0; i < width0; i++){
+        NOAHZK_word_t carry = 0;
+        for(uint64_t j = 0; j < width1; j++){
+            const NOAHZK_dword_t t = (NOAHZK_dword_t)rs0[i]*rs1[j] + dst[i + j] + carry;
+            dst[i + j] = (NOAHZK_word_t)t;
+            carry = (NOAHZK_word_t)(t >> BITS_IN_NOAHZK_WORD);
+        }
+        dst[i + width1] = carry;
+    }
+}
+
+// random or all ones, each word of arr being whole for the schoolbook product; only the low width bytes of it are multiplied by the library
+void CIRCUITC_check_fill(NOAHZK_word_t* arr, const uint64_t words, const uint64_t width, const int all_ones){
+    memset(arr, 0, words*sizeof(NOAHZK_word_t));
+    if(all_ones) memset(arr, 0xff, width);
+    else for(uint64_t i = 0; i < width; i++) ((uint8_t*)arr)[i] = (uint8_t)CIRCUITC_bench_random();
+}
+
+typedef struct{
+    uint64_t words0, words1;
+    int ntt;                    // whether NOAHZK_variable_width_mul_takes_ntt is expected to
+} CIRCUITC_check_widths_t;
+
+int main(){
+    const CIRCUITC_check_widths_t widths[] = {
+        { 1023, 1023, 0 },          // just below NOAHZK_MUL_NTT_CUTOFF: Toom-3
+        { 1024, 1024, 1 },          // at it, filling the whole transform
+        { 1024, 1100, 0 },          // just past a power of 2: the transform would be mostly padding
+        { 1600, 1600, 0 },
+        { 1700, 1700, 1 },          // fills 4/5 of the transform
+        { 2559, 2559, 0 },
+        { 2560, 2560, 1 },          // at NOAHZK_MUL_NTT_FULL_CUTOFF: whatever the padding
+        { 2560, 2700, 1 },
+        { 1024, 30000, 1 },         // unequal: done in one go rather than a piece at a time; transforms of 2^15 words, parallel under OpenMP
+        { 3000, 20000, 1 },
+        { 4096, 4096, 1 },
+    };
+    const uint64_t cases = sizeof(widths)/sizeof(widths[0]);
+    uint64_t products = 0;
+
+    const NOAHZK_word_t primes[NOAHZK_NTT_PRIME_COUNT] = NOAHZK_NTT_PRIMES, generators[NOAHZK_NTT_PRIME_COUNT] = NOAHZK_NTT_GENERATORS;
+    for(uint64_t i = 0; i < NOAHZK_NTT_PRIME_COUNT; i++){
+        const NOAHZK_word_t p = primes[i];
+// p - 1 has to be divisible by 2^NOAHZK_NTT_MAX_LOG_LENGTH, and the generator's power taken for that length has to be a root of that order, not less;
+// p is less than B/2, so that a sum of two residues can't overflow a word
+        const NOAHZK_word_t deepest_root = CIRCUITC_check_pow_mod(generators[i], (p - 1) >> NOAHZK_NTT_MAX_LOG_LENGTH, p);
+        if(((p - 1) >> NOAHZK_NTT_MAX_LOG_LENGTH << NOAHZK_NTT_MAX_LOG_LENGTH) != p - 1 || p >> (BITS_IN_NOAHZK_WORD - 1)
+            || CIRCUITC_check_pow_mod(deepest_root, (NOAHZK_word_t)1 << (NOAHZK_NTT_MAX_LOG_LENGTH - 1), p) != p - 1){
+            printf("prime %llu: no roots of unity of order 2^%d from generator %llu\n", (unsigned long long)p, NOAHZK_NTT_MAX_LOG_LENGTH, (unsigned long long)generators[i]);
+            return 1;
+        }
+
+        for(uint64_t log_length = 1; log_length <= CIRCUITC_CHECK_NTT_LOG_LENGTH; log_length++){
+            const char* failed = CIRCUITC_check_transforms(p, generators[i], log_length);
+            if(failed){
+                printf("prime %llu, length 2^%llu: %s\n", (unsigned long long)p, (unsigned long long)log_length, failed);
+                return 1;
+            }
+        }
+    }
+
+// transforms longer than 2^NOAHZK_NTT_MAX_LOG_LENGTH have no roots of unity in all three primes, and are left to Toom-3
+    if(!NOAHZK_variable_width_mul_takes_ntt((uint64_t)1 << (NOAHZK_NTT_MAX_LOG_LENGTH - 1), (uint64_t)1 << (NOAHZK_NTT_MAX_LOG_LENGTH - 1))
+        || NOAHZK_variable_width_mul_takes_ntt((uint64_t)1 << NOAHZK_NTT_MAX_LOG_LENGTH, (uint64_t)1 << NOAHZK_NTT_MAX_LOG_LENGTH)){
+        printf("transforms of 2^%d words aren't where NOAHZK_variable_width_mul_ntt_fits puts them\n", NOAHZK_NTT_MAX_LOG_LENGTH);
+        return 1;
+    }
+
+    for(uint64_t c = 0; c < cases; c++){
+        const uint64_t words0 = widths[c].words0, words1 = widths[c].words1;
+        if(NOAHZK_variable_width_mul_takes_ntt(words0, words1) != widths[c].ntt){
+            printf("%llu x %llu words: expected %s\n", (unsigned long long)words0, (unsigned long long)words1, widths[c].ntt? "transforms": "Toom-3");
+            return 1;
+        }
+
+        NOAHZK_word_t* rs0 = malloc(words0*sizeof(NOAHZK_word_t));
+        NOAHZK_word_t* rs1 = malloc(words1*sizeof(NOAHZK_word_t));
+        NOAHZK_word_t* expected = malloc((words0 + words1)*sizeof(NOAHZK_word_t));
+        uint8_t* dst = malloc((words0 + words1)*sizeof(NOAHZK_word_t));
+
+// random and all-ones operands, then squares of both when the widths are equal; every other case drops a few bytes off the top word
+        for(int kind = 0; kind < (words0 == words1? 4: 2); kind++){
+            const int all_ones = kind%2, square = kind >= 2;
+            const uint64_t trim = c%2? sizeof(NOAHZK_word_t)/2 + 1: 0;
+            const uint64_t width0 = words0*sizeof(NOAHZK_word_t) - trim, width1 = words1*sizeof(NOAHZK_word_t) - trim;
+
+            CIRCUITC_check_fill(rs0, words0, width0, all_ones);
+            CIRCUITC_check_fill(rs1, words1, width1, all_ones);
+            CIRCUITC_check_schoolbook_words(expected, rs0, square? rs0: rs1, words0, words1);
+            NOAHZK_variable_width_mul_byte(dst, rs0, square? rs0: rs1, width0, width1);
+
+            if(memcmp(dst, expected, width0 + width1)){
+                printf("%llu x %llu bytes (%s%s): product differs from schoolbook\n", (unsigned long long)width0, (unsigned long long)width1,
+                    all_ones? "all ones": "random", square? ", squared": "");
+                return 1;
+            }
+            products++;
+        }
+
+        free(rs0);
+        free(rs1);
+        free(expected);
+        free(dst);
+    }
+
+// base**power, checked against base multiplied in power - 1 times; squaring the base alone is done by transforms, as is everything wider
+    const uint64_t words_base = 1700, powers[] = { 2, 3, 5, 7 };
+    NOAHZK_word_t* base = malloc(words_base*sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* expected = malloc(8*words_base*sizeof(NOAHZK_word_t));
+    NOAHZK_word_t* previous = malloc(8*words_base*sizeof(NOAHZK_word_t));
+    if(!NOAHZK_variable_width_mul_takes_ntt(words_base, words_base)){
+        printf("%llu x %llu words: expected transforms\n", (unsigned long long)words_base, (unsigned long long)words_base);
+        return 1;
+    }
+
+    for(int all_ones = 0; all_ones < 2; all_ones++){
+        CIRCUITC_check_fill(base, words_base, words_base*sizeof(NOAHZK_word_t), all_ones);
+// the top bit set makes the power exactly power*words_base words wide
+        base[words_base - 1] |= (NOAHZK_word_t)1 << (BITS_IN_NOAHZK_WORD - 1);
+        NOAHZK_variable_width_t src, dst;
+        NOAHZK_variable_width_init_arr(&src, base, words_base*sizeof(NOAHZK_word_t));
+        NOAHZK_variable_width_init(&dst, 1);
+
+        for(uint64_t p = 0; p < sizeof(powers)/sizeof(powers[0]); p++){
+            const uint64_t power = powers[p], words_result = power*words_base;
+
+            memcpy(expected, base, words_base*sizeof(NOAHZK_word_t));
+            for(uint64_t i = 1; i < power; i++){
+                memcpy(previous, expected, i*words_base*sizeof(NOAHZK_word_t));
+                CIRCUITC_check_schoolbook_words(expected, previous, base, i*words_base, words_base);
+            }
+
+            if(!NOAHZK_variable_width_pow_constant(&dst, &src, power)
+                || NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(dst.width) < words_result*sizeof(NOAHZK_word_t)
+                || memcmp(dst.arr, expected, words_result*sizeof(NOAHZK_word_t))){
+                printf("%s base of %llu words to the power of %llu: differs from repeated multiplication\n",
+                    all_ones? "all ones": "random", (unsigned long long)words_base, (unsigned long long)power);
+                return 1;
+            }
+            products++;
+        }
+
+        NOAHZK_variable_width_destroy(&src, NOAHZK_variable_width_keep_ptr);
+        NOAHZK_variable_width_destroy(&dst, NOAHZK_variable_width_keep_ptr);
+    }
+
+    free(base);
+    free(expected);
+    free(previous);
+
+    printf("transforms of %d primes and %llu products and powers agree with their references\n", NOAHZK_NTT_PRIME_COUNT, (unsigned long long)products);
+    NOAHZK_variable_width_mul_workspace_free();
+    return 0;
+}
@@ -0,0 +1,104 @@
+// checks the word at a time shifts against a bit by bit shift, on random operands of random widths and random shift amounts.
+//      cc -O2 -I../lexer check_shift.c -o check_shift -lpthread -lm
+//      ./check_shift [cases]
+// - NOAHZK_variable_width_shift_right_byte and shift_left_byte, source and result widths differing (the source zero-extended, the result
+//   truncated) and, when they're the same, in place
+// - NOAHZK_variable_width_shift_right_ct_byte and shift_left_ct_byte, both apart from and over their source
+// shift amounts are 0, whole words, random ones within the width, ones past it and ones near 2^64. widths are a byte to a few hundred, most
+// of them not whole words, and dst is exactly as wide as the result, so that a shift writing past it shows under a sanitiser.
+// prints the first shift that doesn't agree and exits with 1; exits with 0 if all do.
+
+#include "bench.h"              // seeded generator
+#include "NOAHZK_bigint_lib/noahzk_bigint.h"    // bigint library
+
+#define CIRCUITC_CHECK_SHIFT_WIDEST                 300                 // widest operand, in bytes
+
+// records what doesn't agree, unless something earlier already didn't, so that a case is reported by the first check it fails
+#define CIRCUITC_CHECK(failed, mismatch, what) if(!(failed) && (mismatch)) (failed) = (what)
+
+// bit of bytes, width bytes wide and zero-extended; bit may be negative or past the width
+int CIRCUITC_check_bit(const uint8_t* bytes, const uint64_t width, const int64_t bit){
+    return bit >= 0 && (uint64_t)bit < width*BITS_IN_UINT8_T? bytes[bit/BITS_IN_UINT8_T] >> bit%BITS_IN_UINT8_T & 1: 0;
+}
+
+// dst = src >> shamt (src << shamt if left), a bit at a time; src is width_src bytes wide, dst width_result bytes
+void CIRCUITC_check_shift_bits(uint8_t* dst, const uint8_t* src, const uint64_t width_src, const uint64_t width_result, const uint64_t shamt, const int left){
+    memset(dst, 0, width_result);
+// shift amounts past every bit there is leave nothing, and are kept from overflowing the bit index
+    if(shamt > (uint64_t)INT64_MAX/2) return;
+
+    for(uint64_t i = 0; i < width_result*BITS_IN_UINT8_T; i++){
+        const int64_t from = left? (int64_t)i - (int64_t)shamt: (int64_t)i + (int64_t)shamt;
+        dst[i/BITS_IN_UINT8_T] |= (uint8_t)(CIRCUITC_check_bit(src, width_src, from) << i%BITS_IN_UINT8_T);
+    }
+}
+
+uint64_t CIRCUITC_check_shamt(const uint64_t width){
+    const uint64_t width_in_bits = width*BITS_IN_UINT8_T;
+
+    switch(CIRCUITC_bench_random()%8){
+        case 0:     return 0;
+        case 1:     return BITS_IN_NOAHZK_WORD*(CIRCUITC_bench_random()%(width/sizeof(NOAHZK_word_t) + 2));
+        case 2:     return width_in_bits + CIRCUITC_bench_random()%(2*BITS_IN_NOAHZK_WORD);
+        case 3:     return UINT64_MAX - CIRCUITC_bench_random()%4;
+        case 4:     return ((uint64_t)1 << 63) + CIRCUITC_bench_random()%width_in_bits;
+        default:    return CIRCUITC_bench_random()%width_in_bits;
+    }
+}
+
+int main(int argc, char** argv){
+    const uint64_t cases = argc > 1? (uint64_t)atoll(argv[1]): 20000;
+    uint8_t* src = malloc(CIRCUITC_CHECK_SHIFT_WIDEST);
+    uint8_t* expected = malloc(CIRCUITC_CHECK_SHIFT_WIDEST);
+
+    for(uint64_t c = 0; c < cases; c++){
+        const uint64_t width_src = 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_SHIFT_WIDEST;
+        const uint64_t width_result = c%2? 1 + CIRCUITC_bench_random()%CIRCUITC_CHECK_SHIFT_WIDEST: width_src;
+        const uint64_t shamt = CIRCUITC_check_shamt(width_src);
+        uint8_t* dst = malloc(width_result);
+        const char* failed = NULL;
+
+        for(uint64_t i = 0; i < width_src; i++) src[i] = (uint8_t)CIRCUITC_bench_random();
+
+        CIRCUITC_check_shift_bits(expected, src, width_src, width_result, shamt, 0);
+        NOAHZK_variable_width_shift_right_byte(dst, src, width_src, width_result, shamt);
+        CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_right_byte differs from the bit by bit shift");
+        if(width_src == width_result){
+            memcpy(dst, src, width_src);
+            NOAHZK_variable_width_shift_right_byte(dst, dst, width_src, width_result, shamt);
+            CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_right_byte in place differs from the bit by bit shift");
+            NOAHZK_variable_width_shift_right_ct_byte(dst, src, width_src, shamt);
+            CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_right_ct_byte differs from the bit by bit shift");
+            memcpy(dst, src, width_src);
+            NOAHZK_variable_width_shift_right_ct_byte(dst, dst, width_src, shamt);
+            CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_right_ct_byte in place differs from the bit by bit shift");
+        }
+
+        CIRCUITC_check_shift_bits(expected, src, width_src, width_result, shamt, 1);
+        NOAHZK_variable_width_shift_left_byte(dst, src, width_src, width_result, shamt);
+        CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_left_byte differs from the bit by bit shift");
+        if(width_src == width_result){
+            memcpy(dst, src, width_src);
+            NOAHZK_variable_width_shift_left_byte(dst, dst, width_src, width_result, shamt);
+            CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_left_byte in place differs from the bit by bit shift");
+            NOAHZK_variable_width_shift_left_ct_byte(dst, src, width_src, shamt);
+            CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_left_ct_byte differs from the bit by bit shift");
+            memcpy(dst, src, width_src);
+            NOAHZK_variable_width_shift_left_ct_byte(dst, dst, width_src, shamt);
+            CIRCUITC_CHECK(failed, memcmp(dst, expected, width_result), "shift_left_ct_byte in place differs from the bit by bit shift");
+        }
+
+        free(dst);
+        if(failed){
+            printf("case %llu: %s (%llu bytes shifted by %llu into %llu bytes)\n", (unsigned long long)c, failed,
+                (unsigned long long)width_src, (unsigned long long)shamt, (unsigned long long)width_result);
+            return 1;
+        }
+    }
+
+    free(src);
+    free(expected);
+
+    printf("%llu shifts agree with the bit by bit shift\n", (unsigned long long)cases);
+    return 0;
+}
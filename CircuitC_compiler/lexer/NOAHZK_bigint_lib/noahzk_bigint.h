@@ -13,8 +13,14 @@
 #include "ops/logarithms.h"
 #include "ops/type.h"
 #include "ops/add.h"
+#include "ops/ntt.h"
 #include "ops/mul.h"
 #include "ops/sub.h"
+#include "ops/shift.h"
+#include "ops/div.h"
+#include "ops/pow.h"
+#include "ops/fixed.h"
+#include "ops/batch.h"
 
 // NAMING SCHEME:
 //      NOAHZK_variable_width_<op>
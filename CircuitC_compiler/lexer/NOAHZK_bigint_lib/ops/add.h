@@ -12,7 +12,9 @@
 #include "definitions.h"    // NOAHZK variable-width type
 #include "stdint.h"         // integer types
 #include "stdlib.h"         // dynamic memory operations
-#include "string.h"         // memset
+#include "string.h"         // memset, memmove
+#include "type.h"           // resizing variable-width types
+#include "word.h"           // word-sized add-with-carry, byte array loads and stores
 
 // do not define any of these as restrict; it is vlaid for them to be aliased
 
@@ -47,8 +49,7 @@ void NOAHZK_variable_width_add_and_resize(NOAHZK_variable_width_t* dst, NOAHZK_v
     const uint64_t largest_width = NOAHZK_MAX(rs0->width, rs1->width); 
 // expands dst to size of largest operand, initializing new space to 0 
     if(dst->width < largest_width){
-        dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width));
-        memset(dst->arr + dst->width, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width - dst->width));
+        NOAHZK_variable_width_resize_arr(dst, largest_width);
         dst->width = largest_width;
     }
 
@@ -59,7 +60,7 @@ void NOAHZK_variable_width_add_and_resize(NOAHZK_variable_width_t* dst, NOAHZK_v
     }
 // expands dst by one byte in case of carry
     if(carry){
-        dst->arr = realloc(dst->arr, (dst->width + 1)*sizeof(NOAHZK_limb_t));
+        NOAHZK_variable_width_resize_arr(dst, dst->width + 1);
         dst->arr[dst->width] = carry;
         dst->width++;
     }
@@ -72,8 +73,7 @@ void NOAHZK_variable_width_add_and_resize_constant(NOAHZK_variable_width_t* dst,
     const uint64_t largest_width = NOAHZK_MAX(rs0->width, sizeof(k)/sizeof(*rs0->arr)); 
 // expands dst to size of largest operand, initializing new space to 0 
     if(dst->width < largest_width){
-        dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width));
-        memset(dst->arr + dst->width, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width - dst->width));
+        NOAHZK_variable_width_resize_arr(dst, largest_width);
         dst->width = largest_width;
     }
 
@@ -84,77 +84,75 @@ void NOAHZK_variable_width_add_and_resize_constant(NOAHZK_variable_width_t* dst,
     }
 // expands dst by one byte in case of carry
     if(carry){
-        dst->arr = realloc(dst->arr, (dst->width + 1)*sizeof(NOAHZK_limb_t));
+        NOAHZK_variable_width_resize_arr(dst, dst->width + 1);
         dst->arr[dst->width] = carry;
         dst->width++;
     }
 }
 
-void NOAHZK_variable_width_add_with_bit_offset_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result, uint64_t bit_offset){
-    uint8_t carry = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0, *rs1 = real_rs1;
-
-    const uint64_t byte_offset = bit_offset/BITS_IN_UINT8_T;
-
-    for(uint64_t i = 0; i < width_result; i++){
-// runs in constant time regardless of conditional statements because those statements are NOT DATA-DEPENDENT; widths of operands in NOAHZK are public.
-// correctly applies offset because shifts rs1 by bit_offset modulo BITS_IN_UINT8_T
-// the top 8 bits of z are set to the "overflow/shifted data" that doesn't fit inside the bottom 8 bits, to which the carry out from the previous addition is also added
-// the top 8 bits are set as the carry for the next repetition and this is repeated
-// we have the top bits that didn't fit in 8 bits of the previous addtition stored inside carry and added to the bottom part of the next addition
-// idk how good this explanation is.
-        uint16_t z = (uint16_t)(i < width0? rs0[i]: 0) + (i < byte_offset? 0: (i-byte_offset < width1? (uint16_t)rs1[i-byte_offset] << (bit_offset%BITS_IN_UINT8_T): 0)) + carry;
-
-        dst[i] = z & UINT8_MAX;
-        carry = z >> BITS_IN_UINT8_T;
+// dst = rs0 + rs1, byte arrays whose operands are zero-extended to width_result; done a word at a time.
+// constant-time, as whether a word is partial only depends on widths, which are public. used for proving, so having it be constant-time is integral
+void NOAHZK_variable_width_add_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result){
+    NOAHZK_word_t carry = 0;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_result); i++){
+        const NOAHZK_word_t z = NOAHZK_word_add_carry(NOAHZK_word_load_byte(rs0, width0, i), NOAHZK_word_load_byte(rs1, width1, i), &carry);
+        NOAHZK_word_store_byte(dst, width_result, i, z);
     }
 }
 
-void NOAHZK_variable_width_add_with_byte_offset_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result, uint64_t byte_offset){
-    uint8_t carry = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0, *rs1 = real_rs1;
+// the bytes of dst below byte_offset, which only rs0 reaches; returns how many bytes that is
+uint64_t NOAHZK_variable_width_copy_below_offset_byte(void* dst, const void* rs0, const uint64_t width0, const uint64_t width_result, const uint64_t byte_offset){
+    const uint64_t offset = NOAHZK_MIN(byte_offset, width_result);
+    const uint64_t copied = NOAHZK_MIN(offset, width0);
+// memmove, as dst may alias rs0; nothing needs copying when it does
+    if(dst != rs0) memmove(dst, rs0, copied);
+    if(offset > copied) memset((uint8_t*)dst + copied, 0, offset - copied);
 
-    for(uint64_t i = 0; i < width_result; i++){
-// runs in constant time regardless of conditional statements because those statements are NOT DATA-DEPENDENT; widths of operands in NOAHZK are public.
-        uint16_t z = (uint16_t)(i < width0? rs0[i]: 0) + (i < byte_offset? 0: (i-byte_offset < width1? (uint16_t)rs1[i-byte_offset]: 0)) + carry;
+    return offset;
+}
 
-        dst[i] = z & UINT8_MAX;
-        carry = z >> BITS_IN_UINT8_T;
+// dst = rs0 + (rs1 << bit_offset), truncated to width_result bytes
+void NOAHZK_variable_width_add_with_bit_offset_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result, uint64_t bit_offset){
+    const uint64_t offset = NOAHZK_variable_width_copy_below_offset_byte(real_dst, real_rs0, width0, width_result, bit_offset/BITS_IN_UINT8_T);
+    const uint64_t shamt = bit_offset%BITS_IN_UINT8_T;
+    const uint64_t width0_offset = width0 > offset? width0 - offset: 0, width_result_offset = width_result - offset;
+    uint8_t *dst = (uint8_t*)real_dst + offset;
+    const uint8_t *rs0 = (const uint8_t*)real_rs0 + offset;
+    NOAHZK_word_t carry = 0;
+
+// rs1 is read with the bits that the shift carries out of each word of it coming into the next; the last word out of rs1 is all such bits
+    NOAHZK_word_t previous = 0;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_result_offset); i++){
+        const NOAHZK_word_t word = NOAHZK_word_load_byte(real_rs1, width1, i);
+        const NOAHZK_word_t z = NOAHZK_word_add_carry(NOAHZK_word_load_byte(rs0, width0_offset, i), NOAHZK_word_shift_in(word, previous, shamt), &carry);
+        NOAHZK_word_store_byte(dst, width_result_offset, i, z);
+        previous = word;
     }
 }
 
-// compiles to constant-time code on any cpu with constant-time shifts.
-// used for proving, so having it be constant-time is integral
-void NOAHZK_variable_width_add_constant_byte(void* real_dst, const void* real_rs0, const uint64_t k, const uint64_t width0, const uint64_t width_result){
-    uint8_t carry = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0;
-
-    for(uint64_t i = 0; i < width_result; i++){
-// carry-out goes into the ninth bit, which can be extracted in constant-time assuming constant-time shifts
-// runs in constant time regardless of conditional statements because those statements are NOT DATA-DEPENDENT; widths of operands in NOAHZK are public.
-        uint16_t z = (uint16_t)(i < width0? rs0[i]: 0) + NOAHZK_get_section_from_var(k, UINT8_MAX, i, uint8_t) + carry;
-        dst[i] = z & UINT8_MAX;
-        carry = z >> BITS_IN_UINT8_T;
-    }
+// dst = rs0 + (rs1 << 8*byte_offset), truncated to width_result bytes
+void NOAHZK_variable_width_add_with_byte_offset_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result, uint64_t byte_offset){
+    const uint64_t offset = NOAHZK_variable_width_copy_below_offset_byte(real_dst, real_rs0, width0, width_result, byte_offset);
+
+    NOAHZK_variable_width_add_byte((uint8_t*)real_dst + offset, (const uint8_t*)real_rs0 + offset, real_rs1, width0 > offset? width0 - offset: 0, width1, width_result - offset);
 }
 
-// compiles to constant-time code on any cpu with constant-time shifts.
 // used for proving, so having it be constant-time is integral
-void NOAHZK_variable_width_add_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result){
-    uint8_t carry = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0, *rs1 = real_rs1;
-
-    for(uint64_t i = 0; i < width_result; i++){
-// carry-out goes into the ninth bit, which can be extracted in constant-time assuming constant-time shifts
-// runs in constant time regardless of conditional statements because those statements are NOT DATA-DEPENDENT; widths of operands in NOAHZK are public.
-        uint16_t z = (uint16_t)(i < width0? rs0[i]: 0) + (uint16_t)(i < width1? rs1[i]: 0) + carry;
-        dst[i] = z & UINT8_MAX;
-        carry = z >> BITS_IN_UINT8_T;
-    }
+void NOAHZK_variable_width_add_constant_byte(void* dst, const void* rs0, const uint64_t k, const uint64_t width0, const uint64_t width_result){
+// k is read as a byte array, as every other operand
+    NOAHZK_variable_width_add_byte(dst, rs0, &k, width0, sizeof(k), width_result);
+}
+
+// dst = rs0 + rs1 over width_result words, operands being zero-extended to it; returns the carry out.
+// constant-time for public widths. dst may alias either operand as long as it starts where said operand does
+NOAHZK_word_t NOAHZK_variable_width_add_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result){
+    NOAHZK_word_t carry = 0;
+
+    for(uint64_t i = 0; i < width_result; i++) dst[i] = NOAHZK_word_add_carry(i < width0? rs0[i]: 0, i < width1? rs1[i]: 0, &carry);
+
+    return carry;
 }
 
 // dst += src, where dst is a byte array and src a variable-width variable
@@ -0,0 +1,372 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_batch_included
+#define NOAHZK_bigint_batch_included
+
+#include "definitions.h"    // NOAHZK word types
+#include "stdint.h"         // integer types
+#include "stdlib.h"         // dynamic memory operations
+#include "string.h"         // memset
+#include "mul.h"            // word multiplication kernels, the thread's workspace
+#include "word.h"           // word-sized arithmetic, byte array loads and stores
+
+// ops over count operands at once, all of them width words wide: for folding many constants of the same width (lanes of a vector, entries of a ROM)
+// without paying for a call, a width check and a resize per operand.
+// batches are laid out as structs of arrays: word i of operand j is at arr[i*count + j], so that a vector register loads the same word of
+// neighbouring operands and works on them as lanes. every op has a scalar version and, on x86-64, AVX2 and AVX-512 versions working on 4 or 8
+// operands at a time, which leave the operands that don't fill a whole vector to the scalar version; NOAHZK_variable_width_batch_init picks
+// the best ones the CPU supports.
+// all of the ops are constant-time for public widths and counts. dst may be either operand for add, sub and compare, but not for mul.
+// mul is the only one that allocates, growing the thread's workspace: it returns dst, or NULL if the workspace can't be grown, dst being left
+// as it was then.
+
+typedef struct{
+    void (*add)(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count);       // dst = rs0 + rs1 mod B^width
+    void (*sub)(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count);       // dst = rs0 - rs1 mod B^width
+    void* (*mul)(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count);      // dst = rs0*rs1, dst being 2*width words wide
+    void (*compare)(int8_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count);          // dst[j] = -1, 0 or 1 as rs0 <, = or > rs1
+} NOAHZK_variable_width_batch_t;
+
+// sets operand j of dst, a batch of count operands width words wide, to src, a byte array width_src bytes wide, truncated or zero-extended to fit
+void NOAHZK_variable_width_batch_set_byte(NOAHZK_word_t* dst, const uint64_t width, const uint64_t count, const uint64_t j, const void* src, const uint64_t width_src){
+    for(uint64_t i = 0; i < width; i++) dst[i*count + j] = NOAHZK_word_load_byte(src, width_src, i);
+}
+
+// dst = operand j of src, a batch of count operands width words wide, dst being a byte array width_dst bytes wide that it's truncated or zero-extended to fit
+void NOAHZK_variable_width_batch_get_byte(void* dst, const uint64_t width_dst, const NOAHZK_word_t* src, const uint64_t width, const uint64_t count, const uint64_t j){
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_dst); i++) NOAHZK_word_store_byte(dst, width_dst, i, i < width? src[i*count + j]: 0);
+}
+
+// the scalar versions work on operands begin to count - 1, so that the vector versions can hand them the ones left over
+
+void NOAHZK_variable_width_batch_add_from(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count, const uint64_t begin){
+    for(uint64_t j = begin; j < count; j++){
+        NOAHZK_word_t carry = 0;
+        for(uint64_t i = 0; i < width; i++) dst[i*count + j] = NOAHZK_word_add_carry(rs0[i*count + j], rs1[i*count + j], &carry);
+    }
+}
+
+void NOAHZK_variable_width_batch_sub_from(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count, const uint64_t begin){
+    for(uint64_t j = begin; j < count; j++){
+        NOAHZK_word_t borrow = 0;
+        for(uint64_t i = 0; i < width; i++) dst[i*count + j] = NOAHZK_word_sub_borrow(rs0[i*count + j], rs1[i*count + j], &borrow);
+    }
+}
+
+// bytes of the thread's workspace NOAHZK_variable_width_batch_mul_from takes for operands width words wide
+uint64_t NOAHZK_variable_width_batch_mul_scratch_size(const uint64_t width){
+    return NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(4*width + NOAHZK_variable_width_mul_scratch(width, width));
+}
+
+// operands are gathered into the thread's workspace, multiplied by the same kernels as NOAHZK_variable_width_mul_words and scattered back.
+// returns dst, or NULL if the workspace can't be grown
+void* NOAHZK_variable_width_batch_mul_from(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count, const uint64_t begin){
+    if(begin >= count || width == 0) return dst;
+
+    NOAHZK_word_t* operand0 = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_variable_width_batch_mul_scratch_size(width));
+    if(!operand0) return NULL;
+    NOAHZK_word_t* operand1 = operand0 + width;
+    NOAHZK_word_t* product  = operand1 + width;
+    NOAHZK_word_t* rest     = product + 2*width;
+
+    for(uint64_t j = begin; j < count; j++){
+        for(uint64_t i = 0; i < width; i++){
+            operand0[i] = rs0[i*count + j];
+            operand1[i] = rs1[i*count + j];
+        }
+        NOAHZK_variable_width_mul_words(product, operand0, operand1, width, width, rest);
+        for(uint64_t i = 0; i < 2*width; i++) dst[i*count + j] = product[i];
+    }
+
+    return dst;
+}
+
+// words are compared from the bottom up, every word that differs overriding what the ones below it said, so that no operand returns early.
+// NOAHZK_BATCH_BLOCK operands are compared side by side, as the masks of each make for a long chain of dependent ops
+#define NOAHZK_BATCH_BLOCK 8
+
+void NOAHZK_variable_width_batch_compare_from(int8_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count, const uint64_t begin){
+    for(uint64_t j = begin; j < count; j += NOAHZK_BATCH_BLOCK){
+        const uint64_t lanes = NOAHZK_MIN(NOAHZK_BATCH_BLOCK, count - j);
+        NOAHZK_word_t greater[NOAHZK_BATCH_BLOCK] = { 0 }, less[NOAHZK_BATCH_BLOCK] = { 0 };
+
+        for(uint64_t i = 0; i < width; i++)
+            for(uint64_t k = 0; k < lanes; k++){
+                const NOAHZK_word_t a = rs0[i*count + j + k], b = rs1[i*count + j + k];
+                const NOAHZK_word_t word_greater = NOAHZK_word_less_than_mask(b, a), word_less = NOAHZK_word_less_than_mask(a, b);
+                const NOAHZK_word_t differ = word_greater | word_less;
+                greater[k] = (greater[k] &~differ) | word_greater;
+                less[k]    = (less[k]    &~differ) | word_less;
+            }
+
+        for(uint64_t k = 0; k < lanes; k++) dst[j + k] = (int8_t)((greater[k] & 1) - (less[k] & 1));
+    }
+}
+
+void NOAHZK_variable_width_batch_add_scalar(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    NOAHZK_variable_width_batch_add_from(dst, rs0, rs1, width, count, 0);
+}
+
+void NOAHZK_variable_width_batch_sub_scalar(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    NOAHZK_variable_width_batch_sub_from(dst, rs0, rs1, width, count, 0);
+}
+
+void* NOAHZK_variable_width_batch_mul_scalar(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    return NOAHZK_variable_width_batch_mul_from(dst, rs0, rs1, width, count, 0);
+}
+
+void NOAHZK_variable_width_batch_compare_scalar(int8_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    NOAHZK_variable_width_batch_compare_from(dst, rs0, rs1, width, count, 0);
+}
+
+// the vector versions take words to be 64 bits wide
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__) && (defined(__GNUC__) || defined(__clang__))
+#define NOAHZK_BATCH_X86_64
+#include "immintrin.h"      // AVX2, AVX-512 intrinsics
+
+#define NOAHZK_BATCH_LANES_AVX2   4
+#define NOAHZK_BATCH_LANES_AVX512 8
+
+// widest operands (in words) the vector versions of mul take; wider ones are handed to the scalar version, whose 64-bit words take a quarter
+// of the multiplications 32-bit digits do, and which goes on to Karatsuba
+#define NOAHZK_BATCH_MUL_WIDEST_AVX2   8
+#define NOAHZK_BATCH_MUL_WIDEST_AVX512 12
+
+// AVX2 only compares signed words: flipping the sign bit of both sides turns that into an unsigned compare
+__attribute__((target("avx2"))) __m256i NOAHZK_variable_width_batch_less_than_avx2(const __m256i a, const __m256i b){
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+}
+
+// carries are kept as masks, all ones for a carry of 1: adding one in is subtracting the mask, and it carries out again only if the sum before was all ones
+__attribute__((target("avx2"))) void NOAHZK_variable_width_batch_add_avx2(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = count - count%NOAHZK_BATCH_LANES_AVX2;
+    const __m256i ones = _mm256_set1_epi64x(-1);
+
+    for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX2){
+        __m256i carry = _mm256_setzero_si256();
+
+        for(uint64_t i = 0; i < width; i++){
+            const __m256i a = _mm256_loadu_si256((const __m256i*)(rs0 + i*count + j)), b = _mm256_loadu_si256((const __m256i*)(rs1 + i*count + j));
+            const __m256i sum = _mm256_add_epi64(a, b);
+            const __m256i carry_out = _mm256_or_si256(NOAHZK_variable_width_batch_less_than_avx2(sum, a), _mm256_and_si256(carry, _mm256_cmpeq_epi64(sum, ones)));
+            _mm256_storeu_si256((__m256i*)(dst + i*count + j), _mm256_sub_epi64(sum, carry));
+            carry = carry_out;
+        }
+    }
+    NOAHZK_variable_width_batch_add_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+// borrows, as carries above; taking one away borrows again only if the difference before was 0
+__attribute__((target("avx2"))) void NOAHZK_variable_width_batch_sub_avx2(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = count - count%NOAHZK_BATCH_LANES_AVX2;
+    const __m256i zero = _mm256_setzero_si256();
+
+    for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX2){
+        __m256i borrow = _mm256_setzero_si256();
+
+        for(uint64_t i = 0; i < width; i++){
+            const __m256i a = _mm256_loadu_si256((const __m256i*)(rs0 + i*count + j)), b = _mm256_loadu_si256((const __m256i*)(rs1 + i*count + j));
+            const __m256i difference = _mm256_sub_epi64(a, b);
+            const __m256i borrow_out = _mm256_or_si256(NOAHZK_variable_width_batch_less_than_avx2(a, b), _mm256_and_si256(borrow, _mm256_cmpeq_epi64(difference, zero)));
+            _mm256_storeu_si256((__m256i*)(dst + i*count + j), _mm256_add_epi64(difference, borrow));
+            borrow = borrow_out;
+        }
+    }
+    NOAHZK_variable_width_batch_sub_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+// vectors only multiply 32-bit halves of words into 64-bit lanes, so operands are multiplied by schoolbook on 32-bit digits, each lane of the
+// product holding one digit: (2^32 - 1)^2 + 2*(2^32 - 1) = 2^64 - 1, so the product of two digits plus a digit of the product plus a carry
+// fits a lane. operands wider than NOAHZK_BATCH_MUL_WIDEST_AVX2 words are all left to the scalar version.
+// the digits of the product and of rs1 are kept in the thread's workspace, which is grown up front to what the scalar version takes for the
+// operands left over too, so that a batch either fails before anything is written or not at all
+__attribute__((target("avx2"))) void* NOAHZK_variable_width_batch_mul_avx2(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = width <= NOAHZK_BATCH_MUL_WIDEST_AVX2? count - count%NOAHZK_BATCH_LANES_AVX2: 0, digits = 2*width;
+    const __m256i digit_mask = _mm256_set1_epi64x(UINT32_MAX);
+
+    if(vector_count != 0 && width != 0){
+        __m256i* digits1 = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_MAX(3*digits*sizeof(__m256i), NOAHZK_variable_width_batch_mul_scratch_size(width)));
+        if(!digits1) return NULL;
+        __m256i* product = digits1 + digits;
+
+        for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX2){
+            for(uint64_t i = 0; i < width; i++){
+                const __m256i b = _mm256_loadu_si256((const __m256i*)(rs1 + i*count + j));
+                _mm256_storeu_si256(digits1 + 2*i, _mm256_and_si256(b, digit_mask));
+                _mm256_storeu_si256(digits1 + 2*i + 1, _mm256_srli_epi64(b, 32));
+            }
+            memset(product, 0, digits*sizeof(__m256i));
+
+            for(uint64_t i = 0; i < digits; i++){
+// _mm256_mul_epu32 only reads the low half of each lane, so the low digit needn't be masked
+                const __m256i a = _mm256_loadu_si256((const __m256i*)(rs0 + i/2*count + j));
+                const __m256i digit0 = i%2? _mm256_srli_epi64(a, 32): a;
+                __m256i carry = _mm256_setzero_si256();
+
+                for(uint64_t k = 0; k < digits; k++){
+                    const __m256i z = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(digit0, _mm256_loadu_si256(digits1 + k)), _mm256_loadu_si256(product + i + k)), carry);
+                    _mm256_storeu_si256(product + i + k, _mm256_and_si256(z, digit_mask));
+                    carry = _mm256_srli_epi64(z, 32);
+                }
+                _mm256_storeu_si256(product + i + digits, carry);
+            }
+
+            for(uint64_t i = 0; i < digits; i++)
+                _mm256_storeu_si256((__m256i*)(dst + i*count + j), _mm256_or_si256(_mm256_loadu_si256(product + 2*i), _mm256_slli_epi64(_mm256_loadu_si256(product + 2*i + 1), 32)));
+        }
+    }
+    return NOAHZK_variable_width_batch_mul_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+__attribute__((target("avx2"))) void NOAHZK_variable_width_batch_compare_avx2(int8_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = count - count%NOAHZK_BATCH_LANES_AVX2;
+
+    for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX2){
+        __m256i greater = _mm256_setzero_si256(), less = _mm256_setzero_si256();
+
+        for(uint64_t i = 0; i < width; i++){
+            const __m256i a = _mm256_loadu_si256((const __m256i*)(rs0 + i*count + j)), b = _mm256_loadu_si256((const __m256i*)(rs1 + i*count + j));
+            const __m256i word_greater = NOAHZK_variable_width_batch_less_than_avx2(b, a), word_less = NOAHZK_variable_width_batch_less_than_avx2(a, b);
+            const __m256i differ = _mm256_or_si256(word_greater, word_less);
+            greater = _mm256_or_si256(_mm256_andnot_si256(differ, greater), word_greater);
+            less    = _mm256_or_si256(_mm256_andnot_si256(differ, less), word_less);
+        }
+
+        const int greater_mask = _mm256_movemask_pd(_mm256_castsi256_pd(greater)), less_mask = _mm256_movemask_pd(_mm256_castsi256_pd(less));
+        for(uint64_t k = 0; k < NOAHZK_BATCH_LANES_AVX2; k++) dst[j + k] = (int8_t)((greater_mask >> k & 1) - (less_mask >> k & 1));
+    }
+    NOAHZK_variable_width_batch_compare_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+// AVX-512 compares unsigned words and keeps carries as mask registers, one bit per lane
+__attribute__((target("avx512f"))) void NOAHZK_variable_width_batch_add_avx512(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = count - count%NOAHZK_BATCH_LANES_AVX512;
+    const __m512i ones = _mm512_set1_epi64(-1), one = _mm512_set1_epi64(1);
+
+    for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX512){
+        __mmask8 carry = 0;
+
+        for(uint64_t i = 0; i < width; i++){
+            const __m512i a = _mm512_loadu_si512(rs0 + i*count + j), b = _mm512_loadu_si512(rs1 + i*count + j);
+            const __m512i sum = _mm512_add_epi64(a, b);
+            const __mmask8 carry_out = _mm512_cmplt_epu64_mask(sum, a) | (carry & _mm512_cmpeq_epi64_mask(sum, ones));
+            _mm512_storeu_si512(dst + i*count + j, _mm512_mask_add_epi64(sum, carry, sum, one));
+            carry = carry_out;
+        }
+    }
+    NOAHZK_variable_width_batch_add_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+__attribute__((target("avx512f"))) void NOAHZK_variable_width_batch_sub_avx512(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = count - count%NOAHZK_BATCH_LANES_AVX512;
+    const __m512i zero = _mm512_setzero_si512(), one = _mm512_set1_epi64(1);
+
+    for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX512){
+        __mmask8 borrow = 0;
+
+        for(uint64_t i = 0; i < width; i++){
+            const __m512i a = _mm512_loadu_si512(rs0 + i*count + j), b = _mm512_loadu_si512(rs1 + i*count + j);
+            const __m512i difference = _mm512_sub_epi64(a, b);
+            const __mmask8 borrow_out = _mm512_cmplt_epu64_mask(a, b) | (borrow & _mm512_cmpeq_epi64_mask(difference, zero));
+            _mm512_storeu_si512(dst + i*count + j, _mm512_mask_sub_epi64(difference, borrow, difference, one));
+            borrow = borrow_out;
+        }
+    }
+    NOAHZK_variable_width_batch_sub_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+// as NOAHZK_variable_width_batch_mul_avx2, 8 operands at a time and up to NOAHZK_BATCH_MUL_WIDEST_AVX512 words wide
+__attribute__((target("avx512f"))) void* NOAHZK_variable_width_batch_mul_avx512(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = width <= NOAHZK_BATCH_MUL_WIDEST_AVX512? count - count%NOAHZK_BATCH_LANES_AVX512: 0, digits = 2*width;
+    const __m512i digit_mask = _mm512_set1_epi64(UINT32_MAX);
+
+    if(vector_count != 0 && width != 0){
+        __m512i* digits1 = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_MAX(3*digits*sizeof(__m512i), NOAHZK_variable_width_batch_mul_scratch_size(width)));
+        if(!digits1) return NULL;
+        __m512i* product = digits1 + digits;
+
+        for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX512){
+            for(uint64_t i = 0; i < width; i++){
+                const __m512i b = _mm512_loadu_si512(rs1 + i*count + j);
+                _mm512_storeu_si512(digits1 + 2*i, _mm512_and_si512(b, digit_mask));
+                _mm512_storeu_si512(digits1 + 2*i + 1, _mm512_srli_epi64(b, 32));
+            }
+            memset(product, 0, digits*sizeof(__m512i));
+
+            for(uint64_t i = 0; i < digits; i++){
+                const __m512i a = _mm512_loadu_si512(rs0 + i/2*count + j);
+                const __m512i digit0 = i%2? _mm512_srli_epi64(a, 32): a;
+                __m512i carry = _mm512_setzero_si512();
+
+                for(uint64_t k = 0; k < digits; k++){
+                    const __m512i z = _mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(digit0, _mm512_loadu_si512(digits1 + k)), _mm512_loadu_si512(product + i + k)), carry);
+                    _mm512_storeu_si512(product + i + k, _mm512_and_si512(z, digit_mask));
+                    carry = _mm512_srli_epi64(z, 32);
+                }
+                _mm512_storeu_si512(product + i + digits, carry);
+            }
+
+            for(uint64_t i = 0; i < digits; i++)
+                _mm512_storeu_si512(dst + i*count + j, _mm512_or_si512(_mm512_loadu_si512(product + 2*i), _mm512_slli_epi64(_mm512_loadu_si512(product + 2*i + 1), 32)));
+        }
+    }
+    return NOAHZK_variable_width_batch_mul_from(dst, rs0, rs1, width, count, vector_count);
+}
+
+__attribute__((target("avx512f"))) void NOAHZK_variable_width_batch_compare_avx512(int8_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, const uint64_t count){
+    const uint64_t vector_count = count - count%NOAHZK_BATCH_LANES_AVX512;
+
+    for(uint64_t j = 0; j < vector_count; j += NOAHZK_BATCH_LANES_AVX512){
+        __mmask8 greater = 0, less = 0;
+
+        for(uint64_t i = 0; i < width; i++){
+            const __m512i a = _mm512_loadu_si512(rs0 + i*count + j), b = _mm512_loadu_si512(rs1 + i*count + j);
+            const __mmask8 word_greater = _mm512_cmplt_epu64_mask(b, a), word_less = _mm512_cmplt_epu64_mask(a, b);
+            const __mmask8 differ = word_greater | word_less;
+            greater = (greater &~differ) | word_greater;
+            less    = (less    &~differ) | word_less;
+        }
+
+        for(uint64_t k = 0; k < NOAHZK_BATCH_LANES_AVX512; k++) dst[j + k] = (int8_t)((greater >> k & 1) - (less >> k & 1));
+    }
+    NOAHZK_variable_width_batch_compare_from(dst, rs0, rs1, width, count, vector_count);
+}
+#endif
+
+// picks fastest versions supported by the CPU that's running this. mul is dispatched on width as well: the vector versions only
+// multiply operands up to NOAHZK_BATCH_MUL_WIDEST_AVX2 or NOAHZK_BATCH_MUL_WIDEST_AVX512 words wide, past which the scalar version is faster
+NOAHZK_variable_width_batch_t* NOAHZK_variable_width_batch_init(NOAHZK_variable_width_batch_t* batch){
+    if(!batch) batch = malloc(sizeof(*batch));
+
+    batch->add     = NOAHZK_variable_width_batch_add_scalar;
+    batch->sub     = NOAHZK_variable_width_batch_sub_scalar;
+    batch->mul     = NOAHZK_variable_width_batch_mul_scalar;
+    batch->compare = NOAHZK_variable_width_batch_compare_scalar;
+
+#ifdef NOAHZK_BATCH_X86_64
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){
+        batch->add     = NOAHZK_variable_width_batch_add_avx512;
+        batch->sub     = NOAHZK_variable_width_batch_sub_avx512;
+        batch->mul     = NOAHZK_variable_width_batch_mul_avx512;
+        batch->compare = NOAHZK_variable_width_batch_compare_avx512;
+    }
+    else if(__builtin_cpu_supports("avx2")){
+        batch->add     = NOAHZK_variable_width_batch_add_avx2;
+        batch->sub     = NOAHZK_variable_width_batch_sub_avx2;
+        batch->mul     = NOAHZK_variable_width_batch_mul_avx2;
+        batch->compare = NOAHZK_variable_width_batch_compare_avx2;
+    }
+#endif
+
+    return batch;
+}
+
+#endif
@@ -23,6 +23,18 @@ typedef const uint32_t NOAHZK_op_t;
 #define BITS_IN_UINT8_T     8
 #define BITS_IN_NOAHZK_LIMB (sizeof(NOAHZK_limb_t)*BITS_IN_UINT8_T)
 
+// word the arithmetic kernels work on: 64 bits wherever the compiler has a 128-bit type to hold products of words, 32 bits otherwise
+#ifdef __SIZEOF_INT128__
+typedef uint64_t NOAHZK_word_t;
+typedef unsigned __int128 NOAHZK_dword_t;
+#define NOAHZK_WORD_MAX UINT64_MAX
+#else
+typedef uint32_t NOAHZK_word_t;
+typedef uint64_t NOAHZK_dword_t;
+#define NOAHZK_WORD_MAX UINT32_MAX
+#endif
+#define BITS_IN_NOAHZK_WORD (sizeof(NOAHZK_word_t)*BITS_IN_UINT8_T)
+
 #define NOAHZK_convert_from_bits_to_bytes(x) (((x)/BITS_IN_UINT8_T) + ((x)%BITS_IN_UINT8_T != 0))
 // gets section from variable; say variable is 0x01234567; NOAHZK_get_section_from_var(variable, UINT8_MAX, 0, uint8_t) will return a value of the same type as var holding 0x67
 #define NOAHZK_get_section_from_var(var, section_mask, section, section_type) ((section) < sizeof(var)/sizeof(section_type)? var >> (section)*sizeof(section_type)*BITS_IN_UINT8_T & section_mask: 0)
@@ -34,17 +46,31 @@ typedef const uint32_t NOAHZK_op_t;
 #define NOAHZK_SIZE_AS_ARR_OF_TYPE(size, size_type) (((size)/size_type) + ((size)%size_type != 0))
 // gets width in limbs of a variable of width x
 #define NOAHZK_GET_LIMB_WIDTH_FROM_INT(x)           ((x)/sizeof(NOAHZK_limb_t) + ((x)%sizeof(NOAHZK_limb_t) != 0))
+// gets width in words of a byte array of width x
+#define NOAHZK_GET_WORD_WIDTH_FROM_INT(x)           ((x)/sizeof(NOAHZK_word_t) + ((x)%sizeof(NOAHZK_word_t) != 0))
+// gets width in bytes of x words
+#define NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(x)         ((x)*sizeof(NOAHZK_word_t))
 #define NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE(x)     ((x). width*sizeof(NOAHZK_limb_t))
 #define NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(x) ((x)->width*sizeof(NOAHZK_limb_t))
 // width of said var-width type in number of limbs is passed directly
 #define NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(x) ((x)       *sizeof(NOAHZK_limb_t))
 #define NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR_BITS(x) ((x)->width*BITS_IN_NOAHZK_LIMB)
 
-#define NOAHZK_variable_width_INITIALIZER {0, NULL}
+#define NOAHZK_variable_width_INITIALIZER {0}
+
+// values this wide (in limbs) or less are kept in the struct itself rather than on the heap; as arr then points into the struct,
+// variable-width variables must not be copied by assignment, but through NOAHZK_variable_width_copy or NOAHZK_variable_width_move
+#define NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS 4
+#define NOAHZK_VARIABLE_WIDTH_IS_INLINE(x) ((x)->arr == (x)->inline_arr)
 
+// width is how many limbs the value spans, capacity how many arr has room for; ops that resize dst only reallocate once width outgrows
+// capacity, and then by at least half again, so a variable that keeps being updated is reallocated a logarithmic number of times.
+// a capacity of 0 with arr set (an array and a width put together by hand) is taken to be the width
 typedef struct{
     uint64_t width;
-    NOAHZK_limb_t* arr;
+    NOAHZK_limb_t* arr;                                         // inline_arr, or an array on the heap
+    uint64_t capacity;
+    NOAHZK_limb_t inline_arr[NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS];
 } NOAHZK_variable_width_t;
 
 #endif
@@ -0,0 +1,459 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_div_included
+#define NOAHZK_bigint_div_included
+
+#include "definitions.h"    // NOAHZK variable-width type
+#include "stdint.h"         // integer types
+#include "stdlib.h"         // dynamic memory operations
+#include "string.h"         // memset, memcpy
+#include "type.h"           // variable-width type options
+#include "word.h"           // word-sized arithmetic, byte array loads and stores
+#include "add.h"            // variable-width addition
+#include "sub.h"            // variable-width subtraction
+#include "shift.h"          // normalisation shifts
+#include "mul.h"            // multiplication kernels, multiply-add and multiply-subtract, the thread's workspace
+
+// division by zero is defined as it is in RISC-V: the quotient is all ones and the remainder is the dividend (truncated to the width of the remainder).
+// a quotient is as wide as the dividend, a remainder as the divisor.
+
+// reciprocal of d, which has its top bit set, as Möller and Granlund define it: floor((B^2 - 1)/d) - B, B being 2^BITS_IN_NOAHZK_WORD.
+// takes a double word division, which is only done once per divisor
+NOAHZK_word_t NOAHZK_word_reciprocal(const NOAHZK_word_t d){
+    return (NOAHZK_word_t)((((NOAHZK_dword_t)~d) << BITS_IN_NOAHZK_WORD | NOAHZK_WORD_MAX)/d);
+}
+
+// (high*B + low)/d, the remainder being stored in *rem; d has its top bit set, high is less than d and reciprocal is NOAHZK_word_reciprocal(d).
+// a multiplication and at most two corrections instead of a double word division
+NOAHZK_word_t NOAHZK_word_div_2by1(const NOAHZK_word_t high, const NOAHZK_word_t low, const NOAHZK_word_t d, const NOAHZK_word_t reciprocal, NOAHZK_word_t* rem){
+    const NOAHZK_dword_t estimate = (NOAHZK_dword_t)reciprocal*high + ((NOAHZK_dword_t)high << BITS_IN_NOAHZK_WORD | low);
+    NOAHZK_word_t quotient = (NOAHZK_word_t)(estimate >> BITS_IN_NOAHZK_WORD) + 1, r = low - quotient*d;
+
+    if(r > (NOAHZK_word_t)estimate){
+        quotient--;
+        r += d;
+    }
+    if(r >= d){
+        quotient++;
+        r -= d;
+    }
+
+    *rem = r;
+    return quotient;
+}
+
+// quot = src/d over width words, returning the remainder; d may not be 0. quot may alias src as long as it starts where src does.
+// src is normalised (shifted so that d has its top bit set) on the fly, one word at a time. not constant-time
+NOAHZK_word_t NOAHZK_variable_width_divrem_1_words(NOAHZK_word_t* quot, const NOAHZK_word_t* src, const uint64_t width, const NOAHZK_word_t d){
+    if(width == 0) return 0;
+
+    const uint64_t shamt = NOAHZK_word_clz(d);
+    const NOAHZK_word_t normalised = d << shamt, reciprocal = NOAHZK_word_reciprocal(normalised);
+// the bits shifted out of the top word are below d, as the division needs the first high word to be
+    NOAHZK_word_t rem = NOAHZK_word_shift_in(0, src[width - 1], shamt);
+
+    for(uint64_t i = width; i-- > 0;){
+        const NOAHZK_word_t low = NOAHZK_word_shift_in(src[i], i? src[i - 1]: 0, shamt);
+        quot[i] = NOAHZK_word_div_2by1(rem, low, normalised, reciprocal, &rem);
+    }
+
+    return rem >> shamt;
+}
+
+// Knuth's algorithm D: quot = un/vn, un being width0 + 1 words wide and vn width1 words, width1 >= 2 and width0 >= width1; both are normalised,
+// vn having its top bit set and un having been shifted as far. quot gets width0 - width1 + 1 words, and the remainder is left in the low width1 words of un.
+// each word of the quotient is estimated from the top two words of what's left of un and the top word of vn, corrected with the second word of vn
+// (after which it's at most 1 too big) and multiplied out and subtracted, being decremented (and vn added back) if that went below 0. not constant-time
+void NOAHZK_variable_width_divrem_words(NOAHZK_word_t* quot, NOAHZK_word_t* un, const NOAHZK_word_t* vn, const uint64_t width0, const uint64_t width1){
+    const NOAHZK_word_t top = vn[width1 - 1], second = vn[width1 - 2], reciprocal = NOAHZK_word_reciprocal(top);
+
+    for(uint64_t j = width0 - width1 + 1; j-- > 0;){
+        const NOAHZK_word_t high = un[j + width1], low = un[j + width1 - 1], next = un[j + width1 - 2];
+        NOAHZK_word_t estimate, rem;
+        uint8_t rem_overflowed = 0;
+
+// high can't be above top, as what's left of un is always less than vn shifted to j; if they're equal the estimate is B - 1
+        if(high == top){
+            estimate = NOAHZK_WORD_MAX;
+            rem = low + top;
+            rem_overflowed = rem < top;
+        }
+        else estimate = NOAHZK_word_div_2by1(high, low, top, reciprocal, &rem);
+
+        while(!rem_overflowed && (NOAHZK_dword_t)estimate*second > ((NOAHZK_dword_t)rem << BITS_IN_NOAHZK_WORD | next)){
+            estimate--;
+            rem += top;
+            rem_overflowed = rem < top;
+        }
+
+        const NOAHZK_word_t borrow = NOAHZK_variable_width_submul_1_words(un + j, vn, width1, estimate);
+        un[j + width1] = high - borrow;
+        if(high < borrow){
+            estimate--;
+            un[j + width1] += NOAHZK_variable_width_add_words(un + j, un + j, vn, width1, width1, width1);
+        }
+
+        quot[j] = estimate;
+    }
+}
+
+// bytes of scratch NOAHZK_variable_width_divrem_byte_with_scratch takes to divide a dividend width0 bytes wide by a divisor width1 bytes wide
+uint64_t NOAHZK_variable_width_divrem_byte_scratch_size(const uint64_t width0, const uint64_t width1){
+// the normalised dividend (with a word above it for what normalising shifts out), the normalised divisor and the quotient
+    return NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*NOAHZK_GET_WORD_WIDTH_FROM_INT(width0) + 1 + NOAHZK_GET_WORD_WIDTH_FROM_INT(width1));
+}
+
+// quot = rs0/rs1 and rem = rs0 % rs1, where rs0 and quot are width0 bytes wide, rs1 and rem width1 bytes; either of quot and rem may be NULL,
+// and both may alias either operand. scratch is at least NOAHZK_variable_width_divrem_byte_scratch_size(width0, width1) bytes wide and aligned
+// to NOAHZK_word_t; nothing is allocated. divisors of a single word (after leading zero words are dropped) take the single word path,
+// the rest Knuth's algorithm D. not constant-time: how long it takes depends on how many words the operands actually have
+void NOAHZK_variable_width_divrem_byte_with_scratch(void* quot, void* rem, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1, void* scratch){
+    const uint64_t words0 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width0), words1 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width1);
+    NOAHZK_word_t* u = scratch;
+    NOAHZK_word_t* v = u + words0 + 1;
+    NOAHZK_word_t* q = v + words1;
+
+    for(uint64_t i = 0; i <= words0; i++) u[i] = NOAHZK_word_load_byte(rs0, width0, i);
+    for(uint64_t i = 0; i < words1; i++) v[i] = NOAHZK_word_load_byte(rs1, width1, i);
+
+// the widths the operands actually have, in words
+    uint64_t m = words0, n = words1;
+    while(m && !u[m - 1]) m--;
+    while(n && !v[n - 1]) n--;
+
+    uint64_t quot_words = 0, rem_words = m;
+    if(n == 0){
+        quot_words = words0;
+        memset(q, 0xff, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(words0));
+    }
+    else if(m < n);
+    else if(n == 1){
+        quot_words = m;
+        rem_words = 1;
+        u[0] = NOAHZK_variable_width_divrem_1_words(q, u, m, v[0]);
+    }
+    else{
+        const uint64_t shamt = NOAHZK_word_clz(v[n - 1]);
+        quot_words = m - n + 1;
+        rem_words = n;
+
+        NOAHZK_variable_width_shift_left_byte(v, v, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n), NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n), shamt);
+        NOAHZK_variable_width_shift_left_byte(u, u, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(m + 1), NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(m + 1), shamt);
+        NOAHZK_variable_width_divrem_words(q, u, v, m, n);
+        NOAHZK_variable_width_shift_right_byte(u, u, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n), NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n), shamt);
+    }
+
+    if(quot) for(uint64_t i = 0; i < words0; i++) NOAHZK_word_store_byte(quot, width0, i, i < quot_words? q[i]: 0);
+    if(rem) for(uint64_t i = 0; i < words1; i++) NOAHZK_word_store_byte(rem, width1, i, i < rem_words? u[i]: 0);
+}
+
+// as NOAHZK_variable_width_divrem_byte_with_scratch, with the calling thread's workspace as scratch; only allocates when the workspace has to grow.
+// returns quot (rem if quot is NULL), or NULL if the workspace can't grow, quot and rem being left as they were then
+void* NOAHZK_variable_width_divrem_byte(void* quot, void* rem, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
+    void* scratch = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_variable_width_divrem_byte_scratch_size(width0, width1));
+    if(!scratch) return NULL;
+    NOAHZK_variable_width_divrem_byte_with_scratch(quot, rem, rs0, rs1, width0, width1, scratch);
+    return quot? quot: rem;
+}
+
+// dst = rs0/rs1, where rs0 and dst are width0 bytes wide and rs1 width1 bytes; returns dst, or NULL as NOAHZK_variable_width_divrem_byte does
+void* NOAHZK_variable_width_div_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
+    return NOAHZK_variable_width_divrem_byte(dst, NULL, rs0, rs1, width0, width1);
+}
+
+// dst = rs0 % rs1, where rs0 is width0 bytes wide and rs1 and dst width1 bytes; returns dst, or NULL as NOAHZK_variable_width_divrem_byte does
+void* NOAHZK_variable_width_mod_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
+    return NOAHZK_variable_width_divrem_byte(NULL, dst, rs0, rs1, width0, width1);
+}
+
+// quot = rs0/rs1 and rem = rs0 % rs1 as NOAHZK_variable_width_divrem_byte does, in constant time for public widths: restoring binary long division,
+// which shifts each bit of rs0 into the remainder and subtracts rs1 from it, adding rs1 back by mask if that borrowed.
+// takes 8*width0 passes over the divisor; quot may alias rs0 and rem either operand. returns quot (rem if quot is NULL), or NULL if the workspace
+// can't grow, quot and rem being left as they were then
+void* NOAHZK_variable_width_divrem_ct_byte(void* quot, void* rem, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
+    const uint64_t words1 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width1);
+// the remainder is kept one word wider than the divisor, as shifting a bit into it may carry out of the divisor's width
+    NOAHZK_word_t* r = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*words1 + 1));
+    if(!r) return NULL;
+    NOAHZK_word_t* d = r + words1 + 1;
+
+    memset(r, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(words1 + 1));
+    for(uint64_t i = 0; i < words1; i++) d[i] = NOAHZK_word_load_byte(rs1, width1, i);
+
+    NOAHZK_word_t q = 0;
+    for(uint64_t bit = width0*BITS_IN_UINT8_T; bit-- > 0;){
+        NOAHZK_word_t previous = NOAHZK_word_load_byte(rs0, width0, bit/BITS_IN_NOAHZK_WORD) >> (bit%BITS_IN_NOAHZK_WORD) & 1;
+        for(uint64_t i = 0; i <= words1; i++){
+            const NOAHZK_word_t word = r[i];
+            r[i] = word << 1 | previous;
+            previous = word >> (BITS_IN_NOAHZK_WORD - 1);
+        }
+
+        const NOAHZK_word_t borrow = NOAHZK_variable_width_sub_words(r, r, d, words1 + 1, words1, words1 + 1), mask = -borrow;
+        NOAHZK_word_t carry = 0;
+        for(uint64_t i = 0; i <= words1; i++) r[i] = NOAHZK_word_add_carry(r[i], i < words1? d[i] & mask: 0, &carry);
+
+        q |= (borrow ^ 1) << (bit%BITS_IN_NOAHZK_WORD);
+        if(bit%BITS_IN_NOAHZK_WORD == 0){
+            if(quot) NOAHZK_word_store_byte(quot, width0, bit/BITS_IN_NOAHZK_WORD, q);
+            q = 0;
+        }
+    }
+
+    if(rem) for(uint64_t i = 0; i < words1; i++) NOAHZK_word_store_byte(rem, width1, i, r[i]);
+    return quot? quot: rem;
+}
+
+// dst = rs0/rs1, dst being as wide as rs0. returns dst, or NULL if the workspace can't grow, dst keeping its value then
+void* NOAHZK_variable_width_div(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1){
+    const uint64_t new_width = rs0->width;
+    NOAHZK_variable_width_resize_arr(dst, new_width);
+
+    if(!NOAHZK_variable_width_divrem_byte(dst->arr, NULL, rs0->arr, rs1->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs1))) return NULL;
+// needs to be done after everything because rs0, rs1, dst may all alias
+    dst->width = new_width;
+    return dst;
+}
+
+// dst = rs0 % rs1, dst being as wide as rs1. returns dst, or NULL as NOAHZK_variable_width_div does
+void* NOAHZK_variable_width_mod(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1){
+    const uint64_t new_width = rs1->width;
+    NOAHZK_variable_width_resize_arr(dst, new_width);
+
+    if(!NOAHZK_variable_width_divrem_byte(NULL, dst->arr, rs0->arr, rs1->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs1))) return NULL;
+    dst->width = new_width;
+    return dst;
+}
+
+// dst = rs0/k, dst being as wide as rs0, and *rem = rs0 % k. returns dst, or NULL as NOAHZK_variable_width_div does, *rem being left as it was too
+void* NOAHZK_variable_width_div_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, const uint64_t k, uint64_t* rem){
+    const uint64_t new_width = rs0->width;
+    uint64_t remainder = 0;
+    NOAHZK_variable_width_resize_arr(dst, new_width);
+
+// k is read as a byte array, as every other operand
+    if(!NOAHZK_variable_width_divrem_byte(dst->arr, &remainder, rs0->arr, &k, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), sizeof(k))) return NULL;
+    dst->width = new_width;
+    *rem = remainder;
+    return dst;
+}
+
+// context for reducing by the same modulus over and over with Barrett's method: mu = floor((B^(2*width) - 1)/modulus) is worked out once,
+// after which reducing anything below B^(2*width) (such as the product of two reduced values) takes two multiplications and at most three subtractions.
+// (taking 1 off B^(2*width) keeps mu within width + 1 words when the modulus is a power of B, at the cost of the third subtraction)
+typedef struct{
+    uint64_t width;                     // width of the modulus in words, leading zero words dropped
+    uint64_t width_in_bytes;            // width of the modulus, and of what's reduced by it, in bytes
+    NOAHZK_word_t* modulus;
+    NOAHZK_word_t* mu;                  // width + 1 words
+    NOAHZK_word_t* scratch;
+} NOAHZK_barrett_ctx_t;
+
+void NOAHZK_variable_width_barrett_destroy(NOAHZK_barrett_ctx_t* ctx, NOAHZK_variable_width_option_t freeptr){
+    free(ctx->modulus);
+    free(ctx->mu);
+    free(ctx->scratch);
+
+    if(freeptr == NOAHZK_variable_width_free_ptr) free(ctx);
+}
+
+// initializes ctx to reduce by modulus, width bytes wide, which may not be 0; allocates ctx if NULL is passed.
+// returns ctx, or NULL if what it holds (or the workspace the division takes) can't be allocated, nothing being left allocated then
+void* NOAHZK_variable_width_barrett_init(NOAHZK_barrett_ctx_t* ctx, const void* modulus, const uint64_t width){
+// a ctx allocated here is freed along with the rest if anything fails
+    const NOAHZK_variable_width_option_t freeptr = ctx? NOAHZK_variable_width_keep_ptr: NOAHZK_variable_width_free_ptr;
+    if(!ctx) ctx = malloc(sizeof(NOAHZK_barrett_ctx_t));
+    if(!ctx) return NULL;
+
+    uint64_t n = NOAHZK_GET_WORD_WIDTH_FROM_INT(width);
+    ctx->width_in_bytes = width;
+    ctx->modulus = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n));
+    ctx->mu = NULL;
+    ctx->scratch = NULL;
+    if(!ctx->modulus){
+        NOAHZK_variable_width_barrett_destroy(ctx, freeptr);
+        return NULL;
+    }
+    for(uint64_t i = 0; i < n; i++) ctx->modulus[i] = NOAHZK_word_load_byte(modulus, width, i);
+    while(n > 1 && !ctx->modulus[n - 1]) n--;
+    ctx->width = n;
+
+// x (2n words) and the n + 1 words of it divided by B^(n - 1), mu and their product (2n + 2 words), that product's top n + 1 words times the modulus
+// (2n + 1 words), what's left after subtracting it (n + 1 words) and whatever the multiplications take
+    const uint64_t mul_scratch = NOAHZK_MAX(NOAHZK_variable_width_mul_scratch(n + 1, n + 1), NOAHZK_variable_width_mul_scratch(n + 1, n));
+    ctx->scratch = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*n + (2*n + 2) + (2*n + 1) + (n + 1) + mul_scratch));
+    ctx->mu = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*n));
+    if(!ctx->scratch || !ctx->mu){
+        NOAHZK_variable_width_barrett_destroy(ctx, freeptr);
+        return NULL;
+    }
+
+    NOAHZK_word_t* power = ctx->scratch;
+    memset(power, 0xff, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*n));
+    if(!NOAHZK_variable_width_divrem_byte(ctx->mu, NULL, power, ctx->modulus, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*n), NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n))){
+        NOAHZK_variable_width_barrett_destroy(ctx, freeptr);
+        return NULL;
+    }
+// mu is below B^(n + 1), as the modulus is at least B^(n - 1); it's left as it was if it can't be shrunk
+    NOAHZK_word_t* mu = realloc(ctx->mu, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n + 1));
+    if(mu) ctx->mu = mu;
+
+    return ctx;
+}
+
+// dst = src mod the modulus of ctx, where src is width_src bytes wide and below B^(2*ctx->width), and dst is ctx->width_in_bytes bytes wide; dst may alias src.
+// constant-time for public widths: the estimate of src/modulus is at most 3 too small, and all three corrections are always made, by mask
+void NOAHZK_variable_width_barrett_reduce_byte(NOAHZK_barrett_ctx_t* ctx, void* dst, const void* src, const uint64_t width_src){
+    const uint64_t n = ctx->width;
+    NOAHZK_word_t* x        = ctx->scratch;
+    NOAHZK_word_t* estimate = x + 2*n;
+    NOAHZK_word_t* product  = estimate + 2*n + 2;
+    NOAHZK_word_t* r        = product + 2*n + 1;
+    NOAHZK_word_t* rest     = r + n + 1;
+
+    for(uint64_t i = 0; i < 2*n; i++) x[i] = NOAHZK_word_load_byte(src, width_src, i);
+
+// estimate = floor(floor(x/B^(n - 1))*mu/B^(n + 1)), whose words are the top n + 1 of the product
+    NOAHZK_variable_width_mul_words(estimate, x + n - 1, ctx->mu, n + 1, n + 1, rest);
+    NOAHZK_variable_width_mul_words(product, estimate + n + 1, ctx->modulus, n + 1, n, rest);
+// x - estimate*modulus is below 4*modulus, so the low n + 1 words of each are all that's needed
+    NOAHZK_variable_width_sub_words(r, x, product, n + 1, n + 1, n + 1);
+
+    for(uint8_t i = 0; i < 3; i++){
+        NOAHZK_word_t* difference = product;
+        const NOAHZK_word_t mask = -NOAHZK_variable_width_sub_words(difference, r, ctx->modulus, n + 1, n, n + 1);
+        for(uint64_t j = 0; j <= n; j++) r[j] = (r[j] & mask) | (difference[j] &~mask);
+    }
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(ctx->width_in_bytes); i++) NOAHZK_word_store_byte(dst, ctx->width_in_bytes, i, i < n? r[i]: 0);
+}
+
+// context for multiplying modulo the same odd modulus over and over with Montgomery's method: values are kept as x*R mod modulus, R being B^width,
+// and multiplied with the reduction interleaved into the product (CIOS), which takes no division and only a subtraction (by mask) at the end
+typedef struct{
+    uint64_t width;                     // width of the modulus in words
+    uint64_t width_in_bytes;            // width of the modulus, and of the values multiplied modulo it, in bytes
+    NOAHZK_word_t inverse;              // -modulus^-1 mod B
+    NOAHZK_word_t* modulus;
+    NOAHZK_word_t* r2;                  // R^2 mod modulus, which brings values into Montgomery form
+    NOAHZK_word_t* scratch;
+} NOAHZK_montgomery_ctx_t;
+
+void NOAHZK_variable_width_montgomery_destroy(NOAHZK_montgomery_ctx_t* ctx, NOAHZK_variable_width_option_t freeptr){
+    free(ctx->modulus);
+    free(ctx->r2);
+    free(ctx->scratch);
+
+    if(freeptr == NOAHZK_variable_width_free_ptr) free(ctx);
+}
+
+// initializes ctx to multiply modulo modulus, width bytes wide, which has to be odd; returns NULL if it isn't, or if what ctx holds (or the
+// workspace the division takes) can't be allocated, nothing being left allocated then. allocates ctx if NULL is passed
+void* NOAHZK_variable_width_montgomery_init(NOAHZK_montgomery_ctx_t* ctx, const void* modulus, const uint64_t width){
+    if(!width || !(*(const uint8_t*)modulus & 1)) return NULL;
+// a ctx allocated here is freed along with the rest if anything fails
+    const NOAHZK_variable_width_option_t freeptr = ctx? NOAHZK_variable_width_keep_ptr: NOAHZK_variable_width_free_ptr;
+    if(!ctx) ctx = malloc(sizeof(NOAHZK_montgomery_ctx_t));
+    if(!ctx) return NULL;
+
+    const uint64_t n = NOAHZK_GET_WORD_WIDTH_FROM_INT(width);
+    ctx->width = n;
+    ctx->width_in_bytes = width;
+    ctx->modulus = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n));
+// two operands, the running product (n + 2 words) and R^2 = B^(2n), 2n + 1 words wide, while it's being reduced
+    ctx->scratch = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(NOAHZK_MAX(2*n + (n + 2), 2*n + 1)));
+    ctx->r2 = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n));
+    if(!ctx->modulus || !ctx->scratch || !ctx->r2){
+        NOAHZK_variable_width_montgomery_destroy(ctx, freeptr);
+        return NULL;
+    }
+    for(uint64_t i = 0; i < n; i++) ctx->modulus[i] = NOAHZK_word_load_byte(modulus, width, i);
+
+// an odd number is its own inverse mod 8, and each Newton step doubles the bits that are right
+    NOAHZK_word_t inverse = ctx->modulus[0];
+    for(uint64_t bits = 3; bits < BITS_IN_NOAHZK_WORD; bits *= 2) inverse *= 2 - ctx->modulus[0]*inverse;
+    ctx->inverse = -inverse;
+
+    NOAHZK_word_t* power = ctx->scratch;
+    memset(power, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*n));
+    power[2*n] = 1;
+    if(!NOAHZK_variable_width_divrem_byte(NULL, ctx->r2, power, ctx->modulus, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*n + 1), NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n))){
+        NOAHZK_variable_width_montgomery_destroy(ctx, freeptr);
+        return NULL;
+    }
+
+    return ctx;
+}
+
+// dst = rs0*rs1/R mod modulus, all of them ctx->width words wide and rs0, rs1 below the modulus; dst may alias either operand.
+// constant-time for public widths
+void NOAHZK_variable_width_montgomery_mul_words(NOAHZK_montgomery_ctx_t* ctx, NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1){
+    const uint64_t n = ctx->width;
+    const NOAHZK_word_t* modulus = ctx->modulus;
+    NOAHZK_word_t* t = ctx->scratch + 2*n;
+
+    memset(t, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n + 2));
+    for(uint64_t i = 0; i < n; i++){
+// t += rs0*rs1[i]
+        NOAHZK_word_t carry = NOAHZK_variable_width_addmul_1_words(t, rs0, n, rs1[i]);
+        t[n] = NOAHZK_word_add_carry(t[n], carry, &t[n + 1]);
+
+// t = (t + k*modulus)/B, k being picked so that the low word of the sum is 0
+        const NOAHZK_word_t k = t[0]*ctx->inverse;
+        NOAHZK_dword_t z = (NOAHZK_dword_t)k*modulus[0] + t[0];
+        carry = z >> BITS_IN_NOAHZK_WORD;
+        for(uint64_t j = 1; j < n; j++){
+            z = (NOAHZK_dword_t)k*modulus[j] + t[j] + carry;
+            t[j - 1] = (NOAHZK_word_t)z;
+            carry = z >> BITS_IN_NOAHZK_WORD;
+        }
+        NOAHZK_word_t top = 0;
+        t[n - 1] = NOAHZK_word_add_carry(t[n], carry, &top);
+        t[n] = t[n + 1] + top;
+        t[n + 1] = 0;
+    }
+
+// t is below 2*modulus; modulus is taken from it unless that borrows
+    const NOAHZK_word_t mask = -(NOAHZK_variable_width_sub_words(dst, t, modulus, n, n, n) &~t[n]);
+    for(uint64_t i = 0; i < n; i++) dst[i] = (t[i] & mask) | (dst[i] &~mask);
+}
+
+// dst = rs0*rs1/R mod modulus, where all are ctx->width_in_bytes bytes wide and in Montgomery form; dst may alias either operand
+void NOAHZK_variable_width_montgomery_mul_byte(NOAHZK_montgomery_ctx_t* ctx, void* dst, const void* rs0, const void* rs1){
+    const uint64_t n = ctx->width, width = ctx->width_in_bytes;
+    NOAHZK_word_t* operand0 = ctx->scratch;
+    NOAHZK_word_t* operand1 = operand0 + n;
+
+    for(uint64_t i = 0; i < n; i++){
+        operand0[i] = NOAHZK_word_load_byte(rs0, width, i);
+        operand1[i] = NOAHZK_word_load_byte(rs1, width, i);
+    }
+    NOAHZK_variable_width_montgomery_mul_words(ctx, operand0, operand0, operand1);
+    for(uint64_t i = 0; i < n; i++) NOAHZK_word_store_byte(dst, width, i, operand0[i]);
+}
+
+// dst = src*R mod modulus, which puts src (below the modulus) into Montgomery form; both are ctx->width_in_bytes bytes wide
+void NOAHZK_variable_width_montgomery_to_byte(NOAHZK_montgomery_ctx_t* ctx, void* dst, const void* src){
+    NOAHZK_variable_width_montgomery_mul_byte(ctx, dst, src, ctx->r2);
+}
+
+// dst = src/R mod modulus, which takes src out of Montgomery form; both are ctx->width_in_bytes bytes wide
+void NOAHZK_variable_width_montgomery_from_byte(NOAHZK_montgomery_ctx_t* ctx, void* dst, const void* src){
+    const uint64_t n = ctx->width, width = ctx->width_in_bytes;
+    NOAHZK_word_t* operand0 = ctx->scratch;
+    NOAHZK_word_t* one = operand0 + n;
+
+    memset(one, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(n));
+    one[0] = 1;
+    for(uint64_t i = 0; i < n; i++) operand0[i] = NOAHZK_word_load_byte(src, width, i);
+    NOAHZK_variable_width_montgomery_mul_words(ctx, operand0, operand0, one);
+    for(uint64_t i = 0; i < n; i++) NOAHZK_word_store_byte(dst, width, i, operand0[i]);
+}
+
+#endif
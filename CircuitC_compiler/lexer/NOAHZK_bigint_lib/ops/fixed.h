@@ -0,0 +1,155 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_fixed_included
+#define NOAHZK_bigint_fixed_included
+
+#include "definitions.h"    // NOAHZK variable-width type, word types
+#include "stdint.h"         // integer types
+#include "stdlib.h"         // dynamic memory operations
+#include "string.h"         // memset, memcpy
+#include "type.h"           // resizing variable-width types
+#include "word.h"           // word-sized arithmetic, funnel shifts, byte array loads and stores
+
+// fixed-width integers, for widths known when the code is compiled (wires declared as w<num>): NOAHZK_FIXED_DEFINE(bits) makes a type
+// NOAHZK_fixed_<bits>_t holding bits bits in an array of words inside the struct, and the ops on it, named NOAHZK_fixed_<bits>_<op>.
+// nothing is allocated, and as every loop runs a number of times known at compile time, the compiler unrolls them and drops the bounds checks
+// the variable-width ops need. values wrap around at 2^bits, as wires of that width do: the bits of the top word above bits are always 0.
+// all ops are constant-time (shifts for a public shamt), and dst may alias any operand.
+
+// width in words of a fixed-width integer bits bits wide
+#define NOAHZK_FIXED_WIDTH(bits)                    (((bits) + BITS_IN_NOAHZK_WORD - 1)/BITS_IN_NOAHZK_WORD)
+// mask of the bits of the top word that are part of a fixed-width integer bits bits wide
+#define NOAHZK_FIXED_TOP_MASK(bits)                 (NOAHZK_WORD_MAX >> (NOAHZK_FIXED_WIDTH(bits)*BITS_IN_NOAHZK_WORD - (bits)))
+
+#if defined(__clang__)
+#define NOAHZK_FIXED_UNROLL                         _Pragma("unroll")
+#elif defined(__GNUC__)
+#define NOAHZK_FIXED_UNROLL                         _Pragma("GCC unroll 16")
+#else
+#define NOAHZK_FIXED_UNROLL
+#endif
+
+#define NOAHZK_FIXED_DEFINE(bits)                                                                                                       \
+typedef struct{                                                                                                                         \
+    NOAHZK_word_t arr[NOAHZK_FIXED_WIDTH(bits)];                                                                                        \
+} NOAHZK_fixed_##bits##_t;                                                                                                              \
+                                                                                                                                        \
+void NOAHZK_fixed_##bits##_from_constant(NOAHZK_fixed_##bits##_t* dst, const uint64_t k){                                               \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++) dst->arr[i] = NOAHZK_word_load_byte(&k, sizeof(k), i);                       \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = src mod 2^bits, src being a byte array width bytes wide */                                                                     \
+void NOAHZK_fixed_##bits##_from_byte(NOAHZK_fixed_##bits##_t* dst, const void* src, const uint64_t width){                             \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++) dst->arr[i] = NOAHZK_word_load_byte(src, width, i);                          \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = src mod 2^(8*width), dst being a byte array width bytes wide */                                                                \
+void NOAHZK_fixed_##bits##_to_byte(void* dst, const NOAHZK_fixed_##bits##_t* src, const uint64_t width){                               \
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width); i++)                                                                 \
+        NOAHZK_word_store_byte(dst, width, i, i < NOAHZK_FIXED_WIDTH(bits)? src->arr[i]: 0);                                            \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = src mod 2^bits */                                                                                                              \
+void NOAHZK_fixed_##bits##_from_variable_width(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_variable_width_t* src){                      \
+    NOAHZK_fixed_##bits##_from_byte(dst, src->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src));                                      \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = src, dst being resized to as many limbs as bits takes */                                                                       \
+void NOAHZK_fixed_##bits##_to_variable_width(NOAHZK_variable_width_t* dst, const NOAHZK_fixed_##bits##_t* src){                        \
+    const uint64_t new_width = NOAHZK_GET_LIMB_WIDTH_FROM_INT(NOAHZK_convert_from_bits_to_bytes(bits));                                 \
+    NOAHZK_variable_width_resize_arr(dst, new_width);                                                                                   \
+    dst->width = new_width;                                                                                                             \
+                                                                                                                                        \
+    NOAHZK_fixed_##bits##_to_byte(dst->arr, src, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst));                                        \
+}                                                                                                                                       \
+                                                                                                                                        \
+void NOAHZK_fixed_##bits##_add(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_fixed_##bits##_t* rs0, const NOAHZK_fixed_##bits##_t* rs1){ \
+    NOAHZK_word_t carry = 0;                                                                                                            \
+                                                                                                                                        \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++) dst->arr[i] = NOAHZK_word_add_carry(rs0->arr[i], rs1->arr[i], &carry);       \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+void NOAHZK_fixed_##bits##_sub(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_fixed_##bits##_t* rs0, const NOAHZK_fixed_##bits##_t* rs1){ \
+    NOAHZK_word_t borrow = 0;                                                                                                           \
+                                                                                                                                        \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++) dst->arr[i] = NOAHZK_word_sub_borrow(rs0->arr[i], rs1->arr[i], &borrow);    \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+void NOAHZK_fixed_##bits##_neg(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_fixed_##bits##_t* src){                                      \
+    NOAHZK_word_t borrow = 0;                                                                                                           \
+                                                                                                                                        \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++) dst->arr[i] = NOAHZK_word_sub_borrow(0, src->arr[i], &borrow);              \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = rs0*rs1 mod 2^bits; only the products of words that land below bits are made, about half of them */                           \
+void NOAHZK_fixed_##bits##_mul(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_fixed_##bits##_t* rs0, const NOAHZK_fixed_##bits##_t* rs1){ \
+    NOAHZK_word_t product[NOAHZK_FIXED_WIDTH(bits)] = { 0 };                                                                            \
+                                                                                                                                        \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++){                                                                             \
+        NOAHZK_word_t carry = 0;                                                                                                        \
+        NOAHZK_FIXED_UNROLL                                                                                                             \
+        for(uint64_t j = 0; i + j < NOAHZK_FIXED_WIDTH(bits); j++){                                                                     \
+            const NOAHZK_dword_t z = (NOAHZK_dword_t)rs0->arr[i]*rs1->arr[j] + product[i + j] + carry;                                  \
+            product[i + j] = (NOAHZK_word_t)z;                                                                                          \
+            carry = z >> BITS_IN_NOAHZK_WORD;                                                                                           \
+        }                                                                                                                               \
+    }                                                                                                                                   \
+                                                                                                                                        \
+    memcpy(dst->arr, product, sizeof(product));                                                                                         \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = src << shamt mod 2^bits; constant-time for a public shamt */                                                                   \
+void NOAHZK_fixed_##bits##_shift_left(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_fixed_##bits##_t* src, const uint64_t shamt){        \
+    const uint64_t words = shamt/BITS_IN_NOAHZK_WORD, shamt_word = shamt%BITS_IN_NOAHZK_WORD;                                           \
+/* src is copied as dst may be src; reading the copy lets the compiler keep it in registers rather than reload it after each store */  \
+    const NOAHZK_fixed_##bits##_t from = *src;                                                                                          \
+                                                                                                                                        \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++){                                                                             \
+        const NOAHZK_word_t word = i >= words? from.arr[i - words]: 0, previous = i > words? from.arr[i - words - 1]: 0;                \
+        dst->arr[i] = NOAHZK_word_shift_in(word, previous, shamt_word);                                                                 \
+    }                                                                                                                                   \
+    dst->arr[NOAHZK_FIXED_WIDTH(bits) - 1] &= NOAHZK_FIXED_TOP_MASK(bits);                                                              \
+}                                                                                                                                       \
+                                                                                                                                        \
+/* dst = src >> shamt; constant-time for a public shamt */                                                                              \
+void NOAHZK_fixed_##bits##_shift_right(NOAHZK_fixed_##bits##_t* dst, const NOAHZK_fixed_##bits##_t* src, const uint64_t shamt){       \
+    const uint64_t words = shamt/BITS_IN_NOAHZK_WORD, shamt_word = shamt%BITS_IN_NOAHZK_WORD;                                           \
+    const NOAHZK_fixed_##bits##_t from = *src;                                                                                          \
+                                                                                                                                        \
+    NOAHZK_FIXED_UNROLL                                                                                                                 \
+    for(uint64_t i = 0; i < NOAHZK_FIXED_WIDTH(bits); i++){                                                                             \
+        const NOAHZK_word_t word = i + words < NOAHZK_FIXED_WIDTH(bits)? from.arr[i + words]: 0;                                        \
+        const NOAHZK_word_t next = i + words + 1 < NOAHZK_FIXED_WIDTH(bits)? from.arr[i + words + 1]: 0;                               \
+        dst->arr[i] = NOAHZK_word_shift_in_right(word, next, shamt_word);                                                               \
+    }                                                                                                                                   \
+}
+
+// the widths wires are most often declared as
+NOAHZK_FIXED_DEFINE(8)
+NOAHZK_FIXED_DEFINE(16)
+NOAHZK_FIXED_DEFINE(32)
+NOAHZK_FIXED_DEFINE(64)
+NOAHZK_FIXED_DEFINE(128)
+NOAHZK_FIXED_DEFINE(256)
+NOAHZK_FIXED_DEFINE(512)
+
+#endif
@@ -11,25 +11,23 @@
 
 #include "definitions.h"    // NOAHZK variable-width type
 #include "stdint.h"         // integer types
+#include "string.h"         // memcpy
+#include "word.h"           // byte array loads, leading and trailing zero counts, popcount
+
+// all ones if value isn't 0, 0 otherwise, in constant time
+uint64_t NOAHZK_nonzero_mask_var(const uint64_t value){
+    return -((value | -value) >> (BITS_IN_UINT64_T - 1));
+}
 
 // runs in constant time 
 uint64_t NOAHZK_min_bitcnt_var(const uint64_t value){
-// done to avoid clzll of value when value == 0, because that's undefined. basically forces (in constant time) value to 1 whenever it'd actually be 0
-    uint8_t number_of_0_bits = __builtin_popcountll(~value);
-    uint8_t is_value_0 = (number_of_0_bits - BITS_IN_UINT64_T + 1) & 1 & ~((number_of_0_bits - BITS_IN_UINT64_T) >> (BITS_IN_UINT8_T - 1));
-// forces input to __builtin_clzll to 1 if value is 0 (because __builtin_clzll on a 0 is invalid) and subtracts it at the end so log2(0) == 0
-    uint64_t result = BITS_IN_UINT64_T - __builtin_clzll(value | is_value_0);
-    return result - is_value_0;
+// clz is taken of value | 1, as clz of 0 is undefined, and the result is masked down to 0 when value is 0
+    return (BITS_IN_UINT64_T - __builtin_clzll(value | 1)) & NOAHZK_nonzero_mask_var(value);
 }
 
 // runs in constant time 
 uint64_t NOAHZK_ceil_log2_value(const uint64_t value){
-// done to avoid clzll of value when value == 0, because that's undefined. basically forces (in constant time) value to 1 whenever it'd actually be 0
-    uint8_t number_of_0_bits = __builtin_popcountll(~value);
-    uint8_t is_value_0 = (number_of_0_bits - BITS_IN_UINT64_T + 1) & 1 & ~((number_of_0_bits - BITS_IN_UINT64_T) >> (BITS_IN_UINT8_T - 1));
-    uint64_t is_value_0_flag = -(uint64_t)is_value_0;
-
-    return NOAHZK_min_bitcnt_var(value-1) & ~is_value_0_flag;
+    return NOAHZK_min_bitcnt_var(value-1) & NOAHZK_nonzero_mask_var(value);
 }
 
 // runs in constant time 
@@ -38,25 +36,179 @@ uint64_t NOAHZK_min_bytecnt_var(const uint64_t value){
     return min_bitcnt/BITS_IN_UINT8_T + (min_bitcnt%BITS_IN_UINT8_T != 0);
 }
 
+// bit length, trailing zero count and popcount of byte arrays, a word at a time. all of them look at every word and pick the ones that matter by
+// mask, so they're constant-time for a public size. words are numbered from 1 below, 0 standing for none.
+// on x86-64, values at least NOAHZK_LOGARITHMS_AVX2_MIN_WIDTH bytes wide (NOAHZK_LOGARITHMS_POPCOUNT_AVX2_MIN_WIDTH for popcount, which has
+// no lanes to fold) go through AVX2 versions that keep the same per lane of 4 words, the lanes being folded together at the end and the words
+// that don't fill a whole vector left to the scalar loops
+
+#define NOAHZK_LOGARITHMS_AVX2_MIN_WIDTH            256
+#define NOAHZK_LOGARITHMS_POPCOUNT_AVX2_MIN_WIDTH   64
+
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__) && (defined(__GNUC__) || defined(__clang__))
+#define NOAHZK_LOGARITHMS_X86_64
+#include "immintrin.h"      // AVX2 intrinsics
+
+// folds lanes of numbers and words into *number and *word: the highest number if highest, else the lowest that isn't 0
+__attribute__((target("avx2"))) void NOAHZK_variable_width_fold_lanes_avx2(uint64_t* number, NOAHZK_word_t* word, const __m256i numbers, const __m256i words, const uint64_t highest){
+    uint64_t lane_numbers[4], lane_words[4];
+    _mm256_storeu_si256((__m256i*)lane_numbers, numbers);
+    _mm256_storeu_si256((__m256i*)lane_words, words);
+
+    *number = 0; *word = 0;
+    for(uint64_t lane = 0; lane < 4; lane++){
+        const uint64_t is_lane_lower = NOAHZK_word_less_than_mask(lane_numbers[lane], *number);
+        const uint64_t take = NOAHZK_nonzero_mask_var(lane_numbers[lane]) & (highest? ~is_lane_lower: is_lane_lower | ~NOAHZK_nonzero_mask_var(*number));
+        *number = (lane_numbers[lane] & take) | (*number & ~take);
+        *word = (lane_words[lane] & take) | (*word & ~take);
+    }
+}
+
+// for the whole vectors of src, a byte array size bytes wide: sets *top to the number of the highest word that isn't 0 and *top_word to it.
+// returns how many words it's looked at
+__attribute__((target("avx2"))) uint64_t NOAHZK_variable_width_top_word_avx2(const void* src, const uint64_t size, uint64_t* top, NOAHZK_word_t* top_word){
+    const uint64_t words = size/sizeof(NOAHZK_word_t) & ~(uint64_t)3;
+    const __m256i zero = _mm256_setzero_si256(), step = _mm256_set1_epi64x(4);
+    __m256i numbers = _mm256_setzero_si256(), top_words = _mm256_setzero_si256(), current = _mm256_set_epi64x(4, 3, 2, 1);
+
+    for(uint64_t i = 0; i < words; i += 4){
+        const __m256i block = _mm256_loadu_si256((const __m256i*)((const NOAHZK_word_t*)src + i));
+        const __m256i is_zero = _mm256_cmpeq_epi64(block, zero);
+        numbers = _mm256_blendv_epi8(current, numbers, is_zero);
+        top_words = _mm256_blendv_epi8(block, top_words, is_zero);
+        current = _mm256_add_epi64(current, step);
+    }
+
+    NOAHZK_variable_width_fold_lanes_avx2(top, top_word, numbers, top_words, 1);
+    return words;
+}
+
+// as above, with the lowest word that isn't 0: a lane only takes a word while it hasn't found one
+__attribute__((target("avx2"))) uint64_t NOAHZK_variable_width_bottom_word_avx2(const void* src, const uint64_t size, uint64_t* bottom, NOAHZK_word_t* bottom_word){
+    const uint64_t words = size/sizeof(NOAHZK_word_t) & ~(uint64_t)3;
+    const __m256i zero = _mm256_setzero_si256(), step = _mm256_set1_epi64x(4);
+    __m256i numbers = _mm256_setzero_si256(), bottom_words = _mm256_setzero_si256(), current = _mm256_set_epi64x(4, 3, 2, 1), found = _mm256_setzero_si256();
+
+    for(uint64_t i = 0; i < words; i += 4){
+        const __m256i block = _mm256_loadu_si256((const __m256i*)((const NOAHZK_word_t*)src + i));
+        const __m256i is_zero = _mm256_cmpeq_epi64(block, zero);
+        const __m256i keep = _mm256_or_si256(is_zero, found);
+        found = _mm256_or_si256(found, _mm256_cmpeq_epi64(is_zero, zero));
+        numbers = _mm256_blendv_epi8(current, numbers, keep);
+        bottom_words = _mm256_blendv_epi8(block, bottom_words, keep);
+        current = _mm256_add_epi64(current, step);
+    }
+
+    NOAHZK_variable_width_fold_lanes_avx2(bottom, bottom_word, numbers, bottom_words, 0);
+    return words;
+}
+
+// popcount of the whole vectors of src by nibble lookup, the byte counts being summed into lanes by sad against 0. returns how many words it's looked at
+__attribute__((target("avx2"))) uint64_t NOAHZK_variable_width_popcount_avx2(const void* src, const uint64_t size, uint64_t* popcount){
+    const uint64_t words = size/sizeof(NOAHZK_word_t) & ~(uint64_t)3;
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+    __m256i sums = _mm256_setzero_si256();
+
+    for(uint64_t i = 0; i < words; i += 4){
+        const __m256i block = _mm256_loadu_si256((const __m256i*)((const NOAHZK_word_t*)src + i));
+        const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(block, low_nibbles)), _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibbles)));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+
+    uint64_t lane_sums[4];
+    _mm256_storeu_si256((__m256i*)lane_sums, sums);
+    *popcount = lane_sums[0] + lane_sums[1] + lane_sums[2] + lane_sums[3];
+    return words;
+}
+#endif
+
+// bit length of word, numbered number: all of the words below it counting in full
+uint64_t NOAHZK_variable_width_word_bitcnt(const NOAHZK_word_t word, const uint64_t number){
+    return (number*BITS_IN_NOAHZK_WORD - NOAHZK_word_clz(word | 1)) & NOAHZK_nonzero_mask_var(word);
+}
+
+// trailing zero count of word, numbered number, all of the words below it being 0
+uint64_t NOAHZK_variable_width_word_ctz(const NOAHZK_word_t word, const uint64_t number){
+    return (number - 1)*BITS_IN_NOAHZK_WORD + NOAHZK_word_ctz(word | (NOAHZK_nonzero_mask_var(word) + 1));
+}
+
+// number of bits it takes to hold real_value, a byte array size bytes wide. every word's bit length is worked out, and the highest word that
+// isn't 0 has the last say
 uint64_t NOAHZK_variable_width_min_bitcnt_byte(void* real_value, uint64_t size){
-    uint64_t number_of_leading_zeroes = 0;
-    uint8_t flag = 0;
+    const uint64_t whole_words = size/sizeof(NOAHZK_word_t);
+    uint64_t bitcnt = 0, i = 0;
+    NOAHZK_word_t word;
+
+#ifdef NOAHZK_LOGARITHMS_X86_64
+    if(size >= NOAHZK_LOGARITHMS_AVX2_MIN_WIDTH && __builtin_cpu_supports("avx2")){
+        uint64_t top;
+        i = NOAHZK_variable_width_top_word_avx2(real_value, size, &top, &word);
+        bitcnt = NOAHZK_variable_width_word_bitcnt(word, top);
+    }
+#endif
+    for(; i < whole_words; i++){
+        memcpy(&word, (const NOAHZK_word_t*)real_value + i, sizeof(word));
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        bitcnt = (NOAHZK_variable_width_word_bitcnt(word, i + 1) & is_nonzero) | (bitcnt & ~is_nonzero);
+    }
+// the last word is only loaded a byte at a time if it isn't whole
+    if(size%sizeof(NOAHZK_word_t)){
+        word = NOAHZK_word_load_byte(real_value, size, i);
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        bitcnt = (NOAHZK_variable_width_word_bitcnt(word, i + 1) & is_nonzero) | (bitcnt & ~is_nonzero);
+    }
 
-    uint8_t* value = real_value;
+    return bitcnt;
+}
 
-// exploits unsigned integer overflow so it iterates from top bit to last one
-    for(uint64_t i = size - 1; i < size; i--){
-        uint8_t number_of_0_bits = __builtin_popcountll(~value[i]);
-        uint8_t is_value_0 = (number_of_0_bits - BITS_IN_UINT64_T + 1) & 1 & ~((number_of_0_bits - BITS_IN_UINT64_T) >> (BITS_IN_UINT8_T - 1));
+// number of trailing zero bits of real_value, a byte array size bytes wide; all of its bits if it's 0. the words are gone through from the
+// top down, so that the lowest word that isn't 0 has the last say
+uint64_t NOAHZK_variable_width_ctz_byte(const void* real_value, const uint64_t size){
+    const uint64_t whole_words = size/sizeof(NOAHZK_word_t);
+    uint64_t ctz = size*BITS_IN_UINT8_T, begin = 0, i = whole_words;
+    NOAHZK_word_t word;
+
+    if(size%sizeof(NOAHZK_word_t)){
+        word = NOAHZK_word_load_byte(real_value, size, i);
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        ctz = (NOAHZK_variable_width_word_ctz(word, i + 1) & is_nonzero) | (ctz & ~is_nonzero);
+    }
+#ifdef NOAHZK_LOGARITHMS_X86_64
+// the vector version takes the words from the bottom, and the scalar loop the ones above them
+    uint64_t bottom = 0;
+    NOAHZK_word_t bottom_word = 0;
+    if(size >= NOAHZK_LOGARITHMS_AVX2_MIN_WIDTH && __builtin_cpu_supports("avx2")) begin = NOAHZK_variable_width_bottom_word_avx2(real_value, size, &bottom, &bottom_word);
+#endif
+    while(i-- > begin){
+        memcpy(&word, (const NOAHZK_word_t*)real_value + i, sizeof(word));
+        const uint64_t is_nonzero = NOAHZK_nonzero_mask_var(word);
+        ctz = (NOAHZK_variable_width_word_ctz(word, i + 1) & is_nonzero) | (ctz & ~is_nonzero);
+    }
+#ifdef NOAHZK_LOGARITHMS_X86_64
+    const uint64_t found = NOAHZK_nonzero_mask_var(bottom);
+    ctz = (NOAHZK_variable_width_word_ctz(bottom_word, bottom) & found) | (ctz & ~found);
+#endif
 
-        uint8_t this_byte_number_of_leading_zeroes = __builtin_clzll(value[i] | flag | is_value_0) - (BITS_IN_UINT64_T - BITS_IN_UINT8_T);
-        uint8_t is_value_all_zeroes = BITS_IN_UINT8_T - this_byte_number_of_leading_zeroes;
-        flag |= (uint16_t)(is_value_all_zeroes - is_value_0) << (__builtin_clzll(is_value_all_zeroes) - (BITS_IN_UINT64_T - BITS_IN_UINT8_T));
+    return ctz;
+}
 
-        number_of_leading_zeroes += this_byte_number_of_leading_zeroes + is_value_0;
+// number of bits of real_value, a byte array size bytes wide, that are set
+uint64_t NOAHZK_variable_width_popcount_byte(const void* real_value, const uint64_t size){
+    const uint64_t whole_words = size/sizeof(NOAHZK_word_t);
+    uint64_t popcount = 0, i = 0;
+    NOAHZK_word_t word;
+
+#ifdef NOAHZK_LOGARITHMS_X86_64
+    if(size >= NOAHZK_LOGARITHMS_POPCOUNT_AVX2_MIN_WIDTH && __builtin_cpu_supports("avx2")) i = NOAHZK_variable_width_popcount_avx2(real_value, size, &popcount);
+#endif
+    for(; i < whole_words; i++){
+        memcpy(&word, (const NOAHZK_word_t*)real_value + i, sizeof(word));
+        popcount += NOAHZK_word_popcount(word);
     }
+    if(size%sizeof(NOAHZK_word_t)) popcount += NOAHZK_word_popcount(NOAHZK_word_load_byte(real_value, size, i));
 
-    return size*BITS_IN_UINT8_T - number_of_leading_zeroes;
+    return popcount;
 }
 
 uint64_t NOAHZK_variable_width_min_bitcnt(NOAHZK_variable_width_t* value){
@@ -72,4 +224,12 @@ uint64_t NOAHZK_variarble_width_min_bytecnt(NOAHZK_variable_width_t* value){
     return NOAHZK_variable_width_min_bytecnt_byte(value->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(value));
 }
 
+uint64_t NOAHZK_variable_width_ctz(const NOAHZK_variable_width_t* value){
+    return NOAHZK_variable_width_ctz_byte(value->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(value));
+}
+
+uint64_t NOAHZK_variable_width_popcount(const NOAHZK_variable_width_t* value){
+    return NOAHZK_variable_width_popcount_byte(value->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(value));
+}
+
 #endif
@@ -17,162 +17,556 @@
 #include "string.h"         // memset
 #include "type.h"           // ops to allocate, destroy variable width types 
 #include "add.h"            // variable-width addition 
+#include "sub.h"            // variable-width subtraction, negation
+#include "shift.h"          // variable-width shifts
+#include "ntt.h"            // multiplication by number-theoretic transforms
 
-// not constant time, no clue on how one would implement this in constant time
-void NOAHZK_variable_width_shift_right(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, const uint64_t shamt){
-    NOAHZK_limb_t dst_arr[dst->width];
-    memset(dst_arr, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst));
-    if(shamt == 0) memcpy(dst_arr, dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst));
-    else if(shamt != NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR_BITS(dst)){
-        for(uint64_t i = NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR_BITS(dst) - 1; i >= shamt; i--)
-            dst_arr[(i - shamt)/BITS_IN_NOAHZK_LIMB] |= (src->arr[i/BITS_IN_NOAHZK_LIMB] >> (i % BITS_IN_NOAHZK_LIMB) & 1) << ((i - shamt)%BITS_IN_NOAHZK_LIMB);
+// the two cutoffs below may be defined before this is included, as benchmarks/check_mul.c does to run every kernel on narrow operands
+#ifndef NOAHZK_MUL_KARATSUBA_CUTOFF
+#define NOAHZK_MUL_KARATSUBA_CUTOFF                 24                  // operands (in words) this wide or less are multiplied by schoolbook; at least 4, for the scratch bound to hold
+#endif
+#ifndef NOAHZK_MUL_TOOM3_CUTOFF
+#define NOAHZK_MUL_TOOM3_CUTOFF                     400                 // operands (in words) this wide or more are multiplied by Toom-3, those in between by Karatsuba
+#endif
+#define NOAHZK_MUL_NTT_CUTOFF                       1024                // products whose shorter operand (in words) is this wide or more are done by transforms if they fill 4/5 of the transform,
+#define NOAHZK_MUL_NTT_FULL_CUTOFF                  2560                // and whether they do or not if it's this wide or more
+#define NOAHZK_WORDS_IN_UINT64                      NOAHZK_SIZE_AS_ARR_OF_TYPE(sizeof(uint64_t), sizeof(NOAHZK_word_t))      // words a uint64_t constant is split into
+
+// scratch a thread keeps for the multiplications that aren't given any, width being in words; grown as needed and never shrunk, until freed
+typedef struct{
+    uint64_t width;
+    NOAHZK_word_t* arr;
+} NOAHZK_mul_workspace_t;
+
+_Thread_local NOAHZK_mul_workspace_t NOAHZK_mul_workspace = { 0, NULL };
+
+// dst += src*k over width words; returns the word that the product carries out of dst, which is to be added to the word above it.
+// constant-time for a public width
+NOAHZK_word_t NOAHZK_variable_width_addmul_1_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width, const NOAHZK_word_t k){
+    NOAHZK_word_t carry = 0;
+
+// (2^n - 1)^2 + 2*(2^n - 1) = 2^2n - 1, so neither the product nor the two words added to it overflow a double word
+    for(uint64_t i = 0; i < width; i++){
+        const NOAHZK_dword_t z = (NOAHZK_dword_t)src[i]*k + dst[i] + carry;
+        dst[i] = (NOAHZK_word_t)z;
+        carry = z >> BITS_IN_NOAHZK_WORD;
+    }
+
+    return carry;
+}
+
+// dst = rs0*rs1, dst being width0 + width1 words wide and aliasing neither operand.
+// constant-time for public widths, as are all the multiplication kernels below: they only ever branch on widths, and handle signs through masks
+void NOAHZK_variable_width_mul_schoolbook_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1){
+    memset(dst, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width0 + width1));
+
+    for(uint64_t i = 0; i < width0; i++){
+        NOAHZK_word_t carry = 0;
+// (2^n - 1)^2 + 2*(2^n - 1) = 2^2n - 1, so neither the product nor the two words added to it overflow a double word
+        for(uint64_t j = 0; j < width1; j++){
+            const NOAHZK_dword_t z = (NOAHZK_dword_t)rs0[i]*rs1[j] + dst[i + j] + carry;
+            dst[i + j] = z & NOAHZK_WORD_MAX;
+            carry = z >> BITS_IN_NOAHZK_WORD;
+        }
+        dst[i + width1] = carry;
+    }
+}
+
+// dst = src*src, dst being 2*width words wide and not aliasing src. every product of two different words comes up twice in a square, so
+// those are only worked out once (the words above the diagonal), doubled by a shift, and the squares of the words on the diagonal added in:
+// width*(width + 1)/2 multiplications of words rather than width^2
+void NOAHZK_variable_width_sqr_schoolbook_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width){
+    memset(dst, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*width));
+
+    for(uint64_t i = 0; i + 1 < width; i++) dst[i + width] = NOAHZK_variable_width_addmul_1_words(dst + 2*i + 1, src + i + 1, width - i - 1, src[i]);
+
+// the cross products add up to less than B^(2*width)/2, so doubling them can't carry out of dst
+    NOAHZK_word_t carry = 0, previous = 0;
+    for(uint64_t i = 0; i < width; i++){
+        const NOAHZK_dword_t square = (NOAHZK_dword_t)src[i]*src[i];
+        const NOAHZK_word_t low = dst[2*i], high = dst[2*i + 1];
+        dst[2*i]     = NOAHZK_word_add_carry(NOAHZK_word_shift_in(low, previous, 1), (NOAHZK_word_t)square, &carry);
+        dst[2*i + 1] = NOAHZK_word_add_carry(NOAHZK_word_shift_in(high, low, 1), (NOAHZK_word_t)(square >> BITS_IN_NOAHZK_WORD), &carry);
+        previous = high;
+    }
+}
+
+// dst -= src*k over width words; returns the word that the product carries out of dst, which is to be subtracted from the word above it.
+// constant-time for a public width
+NOAHZK_word_t NOAHZK_variable_width_submul_1_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width, const NOAHZK_word_t k){
+    NOAHZK_word_t carry = 0;
+
+    for(uint64_t i = 0; i < width; i++){
+        const NOAHZK_dword_t z = (NOAHZK_dword_t)src[i]*k + carry;
+        const NOAHZK_word_t low = (NOAHZK_word_t)z, difference = dst[i] - low;
+// the borrow out of the subtraction goes into the carry, which can't overflow as the high word of the product is at most B - 2
+        carry = (NOAHZK_word_t)(z >> BITS_IN_NOAHZK_WORD) + (difference > dst[i]);
+        dst[i] = difference;
+    }
+
+    return carry;
+}
+
+// bound on the scratch (in words) NOAHZK_variable_width_mul_balanced_words takes for operands width words wide.
+// a level of Karatsuba takes under 3*width + 8 words and one of Toom-3 under 6*width + 36, and both recurse on operands at most width/2 + 2 words wide
+uint64_t NOAHZK_variable_width_mul_balanced_scratch(const uint64_t width){
+    return width <= NOAHZK_MUL_KARATSUBA_CUTOFF? 0: 6*width + 36 + NOAHZK_variable_width_mul_balanced_scratch(width/2 + 2);
+}
+
+void NOAHZK_variable_width_mul_balanced_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, NOAHZK_word_t* scratch);
+
+// 3-mul Karatsuba: with x = x1*B + x0 and y = y1*B + y0,
+// x*y = x1*y1*B^2 + (x1*y1 + x0*y0 + (x0 - x1)*(y1 - y0))*B + x0*y0
+// the differences are made positive before they're multiplied, and the product is negated back through a mask if exactly one of them wasn't
+void NOAHZK_variable_width_mul_karatsuba_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, NOAHZK_word_t* scratch){
+    const uint64_t width_low = width/2, width_high = width - width_low;
+    NOAHZK_word_t* difference0 = scratch;
+    NOAHZK_word_t* difference1 = difference0 + width_high;
+    NOAHZK_word_t* middle      = difference1 + width_high;
+    NOAHZK_word_t* sum         = middle + 2*width_high + 1;
+    NOAHZK_word_t* rest        = sum + 2*width_high + 1;
+
+    const NOAHZK_word_t sign0 = -NOAHZK_variable_width_sub_words(difference0, rs0, rs0 + width_low, width_low, width_high, width_high);
+    const NOAHZK_word_t sign1 = -NOAHZK_variable_width_sub_words(difference1, rs1 + width_low, rs1, width_high, width_low, width_high);
+    NOAHZK_variable_width_neg_if_words(difference0, difference0, width_high, sign0);
+    NOAHZK_variable_width_neg_if_words(difference1, difference1, width_high, sign1);
+
+    NOAHZK_variable_width_mul_balanced_words(dst, rs0, rs1, width_low, rest);
+    NOAHZK_variable_width_mul_balanced_words(dst + 2*width_low, rs0 + width_low, rs1 + width_low, width_high, rest);
+    NOAHZK_variable_width_mul_balanced_words(middle, difference0, difference1, width_high, rest);
+// middle is extended by a word so that it can be negated; the middle term is never negative, so the sum doesn't need a sign
+    middle[2*width_high] = 0;
+    NOAHZK_variable_width_neg_if_words(middle, middle, 2*width_high + 1, sign0 ^ sign1);
+    NOAHZK_variable_width_add_words(sum, dst, dst + 2*width_low, 2*width_low, 2*width_high, 2*width_high + 1);
+    NOAHZK_variable_width_add_words(sum, sum, middle, 2*width_high + 1, 2*width_high + 1, 2*width_high + 1);
+
+    NOAHZK_variable_width_add_words(dst + width_low, dst + width_low, sum, 2*width - width_low, 2*width_high + 1, 2*width - width_low);
+}
+
+// Karatsuba for squares: x^2 = x1^2*B^2 + (x1^2 + x0^2 - (x0 - x1)^2)*B + x0^2. the square of the difference is never negative,
+// so it's only the difference that needs making positive, and the middle term is always a subtraction. takes less scratch than
+// NOAHZK_variable_width_mul_karatsuba_words, whose bound it's given
+void NOAHZK_variable_width_sqr_karatsuba_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width, NOAHZK_word_t* scratch){
+    const uint64_t width_low = width/2, width_high = width - width_low;
+    NOAHZK_word_t* difference = scratch;
+    NOAHZK_word_t* middle     = difference + width_high;
+    NOAHZK_word_t* sum        = middle + 2*width_high;
+    NOAHZK_word_t* rest       = sum + 2*width_high + 1;
+
+    const NOAHZK_word_t sign = -NOAHZK_variable_width_sub_words(difference, src, src + width_low, width_low, width_high, width_high);
+    NOAHZK_variable_width_neg_if_words(difference, difference, width_high, sign);
+
+    NOAHZK_variable_width_mul_balanced_words(dst, src, src, width_low, rest);
+    NOAHZK_variable_width_mul_balanced_words(dst + 2*width_low, src + width_low, src + width_low, width_high, rest);
+    NOAHZK_variable_width_mul_balanced_words(middle, difference, difference, width_high, rest);
+    NOAHZK_variable_width_add_words(sum, dst, dst + 2*width_low, 2*width_low, 2*width_high, 2*width_high + 1);
+    NOAHZK_variable_width_sub_words(sum, sum, middle, 2*width_high + 1, 2*width_high, 2*width_high + 1);
+
+    NOAHZK_variable_width_add_words(dst + width_low, dst + width_low, sum, 2*width - width_low, 2*width_high + 1, 2*width - width_low);
+}
+
+// dst = src/2 over width words, src being even and in two's complement
+void NOAHZK_variable_width_halve_signed_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width){
+    for(uint64_t i = 0; i + 1 < width; i++) dst[i] = src[i] >> 1 | src[i + 1] << (BITS_IN_NOAHZK_WORD - 1);
+    dst[width - 1] = src[width - 1] >> 1 | (src[width - 1] & (NOAHZK_word_t)1 << (BITS_IN_NOAHZK_WORD - 1));
+}
+
+// dst = src/3 over width words, src being a multiple of 3 in two's complement. as the division is exact, it's a multiplication by the inverse of 3 modulo 2^(width*BITS_IN_NOAHZK_WORD),
+// which is done a word at a time: each word of the quotient is what makes the word it's subtracted from 0, and 3 times it carries into the next words
+void NOAHZK_variable_width_divexact_3_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width){
+    const NOAHZK_word_t inverse = (NOAHZK_word_t)0xAAAAAAAAAAAAAAABULL;        // 3*inverse = 1 modulo 2^BITS_IN_NOAHZK_WORD
+    NOAHZK_word_t carry = 0;
+
+    for(uint64_t i = 0; i < width; i++){
+        NOAHZK_word_t borrow = 0;
+        const NOAHZK_word_t quotient = NOAHZK_word_sub_borrow(src[i], carry, &borrow)*inverse;
+        dst[i] = quotient;
+        carry = (NOAHZK_word_t)((NOAHZK_dword_t)quotient*3 >> BITS_IN_NOAHZK_WORD) + borrow;
+    }
+}
+
+// evaluates x0 + x1*X + x2*X^2, its parts being k, k and width_top words wide, at 1, -1 and -2 over k + 1 words.
+// the values at -1 and -2 are made positive, and their signs returned as masks
+void NOAHZK_variable_width_toom3_evaluate_words(NOAHZK_word_t* at_1, NOAHZK_word_t* at_minus_1, NOAHZK_word_t* at_minus_2, NOAHZK_word_t* sign_minus_1, NOAHZK_word_t* sign_minus_2, const NOAHZK_word_t* src, const uint64_t k, const uint64_t width_top){
+    const NOAHZK_word_t *x0 = src, *x1 = src + k, *x2 = src + 2*k;
+    const uint64_t width = k + 1;
+// x0 + x2 +- x1; none of these are more than 7 times as large as a part, so they fit in k + 1 words with room for a sign
+    NOAHZK_variable_width_add_words(at_1, x0, x2, k, width_top, width);
+    NOAHZK_variable_width_sub_words(at_minus_1, at_1, x1, width, k, width);
+    NOAHZK_variable_width_add_words(at_1, at_1, x1, width, k, width);
+// x0 - 2*x1 + 4*x2 = 2*(x0 - x1 + x2 + x2) - x0
+    NOAHZK_variable_width_add_words(at_minus_2, at_minus_1, x2, width, width_top, width);
+    NOAHZK_variable_width_add_words(at_minus_2, at_minus_2, at_minus_2, width, width, width);
+    NOAHZK_variable_width_sub_words(at_minus_2, at_minus_2, x0, width, k, width);
+
+    *sign_minus_1 = -(at_minus_1[k] >> (BITS_IN_NOAHZK_WORD - 1));
+    *sign_minus_2 = -(at_minus_2[k] >> (BITS_IN_NOAHZK_WORD - 1));
+    NOAHZK_variable_width_neg_if_words(at_minus_1, at_minus_1, width, *sign_minus_1);
+    NOAHZK_variable_width_neg_if_words(at_minus_2, at_minus_2, width, *sign_minus_2);
+}
+
+// Toom-3: x and y are split in 3 parts and taken as polynomials of degree 2 in B = 2^(BITS_IN_NOAHZK_WORD*k), which are evaluated at 0, 1, -1, -2 and infinity.
+// the 5 products of the values give the product polynomial back (Bodrato's interpolation sequence), which is then evaluated at B.
+// interpolation is done in two's complement over 2k + 3 words, which holds every value along the way; all the coefficients that come out of it are positive.
+void NOAHZK_variable_width_mul_toom3_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, NOAHZK_word_t* scratch){
+    const uint64_t k = (width + 2)/3, width_top = width - 2*k;
+    const uint64_t width_evaluation = k + 1, width_interpolation = 2*k + 3, width_dst = 2*width;
+
+    NOAHZK_word_t* x_at_1       = scratch;
+    NOAHZK_word_t* x_at_minus_1 = x_at_1 + width_evaluation;
+    NOAHZK_word_t* x_at_minus_2 = x_at_minus_1 + width_evaluation;
+    NOAHZK_word_t* y_at_1       = x_at_minus_2 + width_evaluation;
+    NOAHZK_word_t* y_at_minus_1 = y_at_1 + width_evaluation;
+    NOAHZK_word_t* y_at_minus_2 = y_at_minus_1 + width_evaluation;
+    NOAHZK_word_t* r0           = y_at_minus_2 + width_evaluation;
+    NOAHZK_word_t* r1           = r0 + width_interpolation;
+    NOAHZK_word_t* r2           = r1 + width_interpolation;
+    NOAHZK_word_t* r3           = r2 + width_interpolation;
+    NOAHZK_word_t* r4           = r3 + width_interpolation;
+    NOAHZK_word_t* at_minus_2   = r4 + width_interpolation;
+    NOAHZK_word_t* rest         = at_minus_2 + width_interpolation;
+
+    NOAHZK_word_t x_sign_minus_1, x_sign_minus_2, y_sign_minus_1, y_sign_minus_2;
+    NOAHZK_variable_width_toom3_evaluate_words(x_at_1, x_at_minus_1, x_at_minus_2, &x_sign_minus_1, &x_sign_minus_2, rs0, k, width_top);
+// a square is evaluated once, its values being the same for both operands; the products below are then squares, and squared as such
+    if(rs0 == rs1){
+        y_at_1 = x_at_1; y_at_minus_1 = x_at_minus_1; y_at_minus_2 = x_at_minus_2;
+        y_sign_minus_1 = x_sign_minus_1; y_sign_minus_2 = x_sign_minus_2;
     }
+    else NOAHZK_variable_width_toom3_evaluate_words(y_at_1, y_at_minus_1, y_at_minus_2, &y_sign_minus_1, &y_sign_minus_2, rs1, k, width_top);
+// values of the product at 0, infinity, 1, -1 and -2
+    memset(r0, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(5*width_interpolation));
+    NOAHZK_variable_width_mul_balanced_words(r0, rs0, rs1, k, rest);
+    NOAHZK_variable_width_mul_balanced_words(r4, rs0 + 2*k, rs1 + 2*k, width_top, rest);
+    NOAHZK_variable_width_mul_balanced_words(r1, x_at_1, y_at_1, width_evaluation, rest);
+    NOAHZK_variable_width_mul_balanced_words(r2, x_at_minus_1, y_at_minus_1, width_evaluation, rest);
+    NOAHZK_variable_width_mul_balanced_words(r3, x_at_minus_2, y_at_minus_2, width_evaluation, rest);
+    NOAHZK_variable_width_neg_if_words(r2, r2, width_interpolation, x_sign_minus_1 ^ y_sign_minus_1);
+    NOAHZK_variable_width_neg_if_words(r3, r3, width_interpolation, x_sign_minus_2 ^ y_sign_minus_2);
+    memcpy(at_minus_2, r3, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width_interpolation));
+// r3 = (v(-2) - v(1))/3
+    NOAHZK_variable_width_sub_words(r3, at_minus_2, r1, width_interpolation, width_interpolation, width_interpolation);
+    NOAHZK_variable_width_divexact_3_words(r3, r3, width_interpolation);
+// r1 = (v(1) - v(-1))/2, r2 = v(-1) - v(0)
+    NOAHZK_variable_width_sub_words(r1, r1, r2, width_interpolation, width_interpolation, width_interpolation);
+    NOAHZK_variable_width_halve_signed_words(r1, r1, width_interpolation);
+    NOAHZK_variable_width_sub_words(r2, r2, r0, width_interpolation, width_interpolation, width_interpolation);
+// r3 = (r2 - r3)/2 + 2*v(infinity)
+    NOAHZK_variable_width_sub_words(r3, r2, r3, width_interpolation, width_interpolation, width_interpolation);
+    NOAHZK_variable_width_halve_signed_words(r3, r3, width_interpolation);
+    NOAHZK_variable_width_add_words(r3, r3, r4, width_interpolation, width_interpolation, width_interpolation);
+    NOAHZK_variable_width_add_words(r3, r3, r4, width_interpolation, width_interpolation, width_interpolation);
+// r2 = r2 + r1 - v(infinity), r1 = r1 - r3
+    NOAHZK_variable_width_add_words(r2, r2, r1, width_interpolation, width_interpolation, width_interpolation);
+    NOAHZK_variable_width_sub_words(r2, r2, r4, width_interpolation, width_interpolation, width_interpolation);
+    NOAHZK_variable_width_sub_words(r1, r1, r3, width_interpolation, width_interpolation, width_interpolation);
+// dst = r0 + r1*B + r2*B^2 + r3*B^3 + r4*B^4; r0 and r4 don't overlap, the others are added over them
+    memset(dst, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width_dst));
+    memcpy(dst, r0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*k));
+    memcpy(dst + 4*k, r4, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*width_top));
+    NOAHZK_variable_width_add_words(dst + k,   dst + k,   r1, width_dst - k,   NOAHZK_MIN(width_interpolation, width_dst - k),   width_dst - k);
+    NOAHZK_variable_width_add_words(dst + 2*k, dst + 2*k, r2, width_dst - 2*k, NOAHZK_MIN(width_interpolation, width_dst - 2*k), width_dst - 2*k);
+    NOAHZK_variable_width_add_words(dst + 3*k, dst + 3*k, r3, width_dst - 3*k, NOAHZK_MIN(width_interpolation, width_dst - 3*k), width_dst - 3*k);
+}
 
-    memcpy(dst->arr, dst_arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst));
+// dst = rs0*rs1, both operands being width words wide; dst is 2*width words wide and aliases neither operand.
+// scratch is at least NOAHZK_variable_width_mul_balanced_scratch(width) words wide. rs0 and rs1 being the same array makes it a square, which
+// takes the squaring kernels
+void NOAHZK_variable_width_mul_balanced_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width, NOAHZK_word_t* scratch){
+    if(rs0 == rs1 && width <= NOAHZK_MUL_KARATSUBA_CUTOFF) NOAHZK_variable_width_sqr_schoolbook_words(dst, rs0, width);
+    else if(rs0 == rs1 && width < NOAHZK_MUL_TOOM3_CUTOFF) NOAHZK_variable_width_sqr_karatsuba_words(dst, rs0, width, scratch);
+    else if(width <= NOAHZK_MUL_KARATSUBA_CUTOFF) NOAHZK_variable_width_mul_schoolbook_words(dst, rs0, rs1, width, width);
+    else if(width < NOAHZK_MUL_TOOM3_CUTOFF) NOAHZK_variable_width_mul_karatsuba_words(dst, rs0, rs1, width, scratch);
+    else NOAHZK_variable_width_mul_toom3_words(dst, rs0, rs1, width, scratch);
 }
 
-// basically 4-mul version of Karatsuba algorithm
-// had problems trying to implement 3-mul version
-// constant-time 
-void NOAHZK_variable_width_mul_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
-// handles common cases quickly
-    if(width0 == 0 && width1 == 0) return;
-    if(width0 == 0 || width1 == 0) return;
-    if(width0 == sizeof(uint8_t) && width1 == sizeof(uint8_t)){
-        *(uint16_t*)dst = *(uint8_t*)rs0 * *(uint8_t*)rs1; 
+// whether operands width0 and width1 words wide are multiplied by transforms. transforms are a power of 2 long, so a product that only just
+// spills past one pays for twice the length, which Toom-3 makes up for below NOAHZK_MUL_NTT_FULL_CUTOFF words
+int NOAHZK_variable_width_mul_takes_ntt(const uint64_t width0, const uint64_t width1){
+    const uint64_t width_short = NOAHZK_MIN(width0, width1);
+
+    if(width_short < NOAHZK_MUL_NTT_CUTOFF || !NOAHZK_variable_width_mul_ntt_fits(width0, width1)) return 0;
+    return width_short >= NOAHZK_MUL_NTT_FULL_CUTOFF || 5*(width0 + width1) >= 4*((uint64_t)1 << NOAHZK_ntt_log_length(width0, width1));
+}
+
+// scratch (in words) NOAHZK_variable_width_mul_words takes for operands width0 and width1 words wide
+uint64_t NOAHZK_variable_width_mul_scratch(const uint64_t width0, const uint64_t width1){
+    const uint64_t width_short = NOAHZK_MIN(width0, width1);
+
+    if(NOAHZK_variable_width_mul_takes_ntt(width0, width1)) return NOAHZK_variable_width_mul_ntt_scratch(width0, width1);
+    if(width_short <= NOAHZK_MUL_KARATSUBA_CUTOFF) return 0;
+    if(width0 == width1) return NOAHZK_variable_width_mul_balanced_scratch(width_short);
+    return 3*width_short + NOAHZK_variable_width_mul_balanced_scratch(width_short);
+}
+
+// dst = rs0*rs1, dst being width0 + width1 words wide and aliasing neither operand; scratch is at least NOAHZK_variable_width_mul_scratch(width0, width1) words wide.
+// operands of different widths are multiplied a piece of the longer one at a time, each piece being as wide as the shorter one (the last one is padded with zeroes);
+// products NOAHZK_variable_width_mul_takes_ntt are done by transforms in one go, however different the operands' widths
+void NOAHZK_variable_width_mul_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1, NOAHZK_word_t* scratch){
+    const NOAHZK_word_t *longer = width0 >= width1? rs0: rs1, *shorter = width0 >= width1? rs1: rs0;
+    const uint64_t width_long = NOAHZK_MAX(width0, width1), width_short = NOAHZK_MIN(width0, width1), width_dst = width0 + width1;
+
+    if(NOAHZK_variable_width_mul_takes_ntt(width0, width1)){
+        NOAHZK_variable_width_mul_ntt_words(dst, rs0, rs1, width0, width1, scratch);
         return;
     }
-    if(width0 == sizeof(uint8_t)){
-        uint16_t product = 0;
-        for(uint64_t i = 0; i < width1; i++){
-            product += ((uint8_t*)rs1)[i] * *(uint8_t*)rs0;
-            ((uint8_t*)dst)[i] += product;
-            product >>= BITS_IN_UINT8_T;        // this way if dst == rs1 dst[i] isn't overwritten until after we're done with rs1[i]
-        }
+    if(width_long == width_short){
+        NOAHZK_variable_width_mul_balanced_words(dst, rs0, rs1, width_short, scratch);
         return;
     }
-    if(width1 == sizeof(uint8_t)){
-        uint16_t product = 0;
-        for(uint64_t i = 0; i < width0; i++){
-            product = ((uint8_t*)rs0)[i] * *(uint8_t*)rs1;
-            ((uint8_t*)dst)[i] += product;
-            product >>= BITS_IN_UINT8_T;        // this way if dst == rs0 dst[i] isn't overwritten until after we're done with rs0[i]
-        }
+    if(width_short <= NOAHZK_MUL_KARATSUBA_CUTOFF){
+        NOAHZK_variable_width_mul_schoolbook_words(dst, longer, shorter, width_long, width_short);
         return;
     }
 
-    const uint64_t n = width0/2, m = width1/2;
-
-    const uint64_t width_X1Y1 = width0-n + width1-m;
-    uint8_t X1Y1[width_X1Y1];
-    NOAHZK_variable_width_mul_byte(X1Y1, (uint8_t*)rs0 + n, (uint8_t*)rs1 + m, width0-n, width1-m);
-
-    const uint64_t width_X1Y0 = width0-n + m;
-    uint8_t X1Y0[width_X1Y0];
-    NOAHZK_variable_width_mul_byte(X1Y0, (uint8_t*)rs0 + n, rs1, width0-n, m);
-    
-    const uint64_t width_X0Y1 = n + width1-m;
-    uint8_t X0Y1[width_X0Y1];
-    NOAHZK_variable_width_mul_byte(X0Y1, rs0, (uint8_t*)rs1 + m, n, width1-m);
-    
-    const uint64_t width_X0Y0 = n + m;
-    uint8_t X0Y0[width_X0Y0];
-    NOAHZK_variable_width_mul_byte(X0Y0, rs0, rs1, n, m);
-// HAS to be done at the end because, if we do this at the start and dst == rs0, then we'd be setting rs0 to 0, which is bad.
-    memset(dst, 0, width0+width1);
-    const uint64_t width_dst = width0 + width1;
-    NOAHZK_variable_width_add_with_byte_offset_byte(dst, X0Y0, X0Y1, width_X0Y0, width_X0Y1, width_dst, m);
-    NOAHZK_variable_width_add_with_byte_offset_byte(dst, dst,  X1Y0, width_dst,  width_X1Y0, width_dst, n);
-    NOAHZK_variable_width_add_with_byte_offset_byte(dst, dst,  X1Y1, width_dst,  width_X1Y1, width_dst, n+m);
-}
-
-void NOAHZK_variable_width_mul_constant_byte(void* dst, const void* rs0, const uint64_t k, const uint64_t width0){
+    NOAHZK_word_t* product = scratch;
+    NOAHZK_word_t* piece   = product + 2*width_short;
+    NOAHZK_word_t* rest    = piece + width_short;
+
+    memset(dst, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width_dst));
+    for(uint64_t i = 0; i < width_long; i += width_short){
+        const uint64_t width_piece = NOAHZK_MIN(width_short, width_long - i);
+        memset(piece, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width_short));
+        memcpy(piece, longer + i, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width_piece));
+
+        NOAHZK_variable_width_mul_balanced_words(product, piece, shorter, width_short, rest);
+// the pieces before this one add up to less than B^(i + width_short), so adding this one can't carry out of the words it spans
+        NOAHZK_variable_width_add_words(dst + i, dst + i, product, NOAHZK_MIN(2*width_short, width_dst - i), NOAHZK_MIN(2*width_short, width_dst - i), NOAHZK_MIN(2*width_short, width_dst - i));
+    }
+}
+
+// bytes of scratch NOAHZK_variable_width_mul_byte_with_scratch takes to multiply operands width0 and width1 bytes wide
+uint64_t NOAHZK_variable_width_mul_byte_scratch_size(const uint64_t width0, const uint64_t width1){
+    const uint64_t words0 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width0), words1 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width1);
+// copies of the operands, the product and the kernels' own scratch
+    return NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(2*(words0 + words1) + NOAHZK_variable_width_mul_scratch(words0, words1));
+}
+
+// dst = rs0*rs1, where rs0 is width0 bytes wide, rs1 width1 bytes and dst width0 + width1 bytes; dst may alias either operand.
+// scratch is at least NOAHZK_variable_width_mul_byte_scratch_size(width0, width1) bytes wide and aligned to NOAHZK_word_t; nothing is allocated,
+// and as the kernels keep no arrays on the stack, stack use only grows with the depth of the recursion (logarithmic in the widths).
+// the operands are copied into words, multiplied by schoolbook, Karatsuba, Toom-3 or transforms according to how wide they are, and the product copied back.
+// constant-time, as which algorithm runs only depends on the widths, which are public
+void NOAHZK_variable_width_mul_byte_with_scratch(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1, void* scratch){
+// a product by an empty operand is 0, as wide as the other operand; if both are empty, dst may be NULL, and there's nothing to clear
+    if(width0 == 0 || width1 == 0){
+        if(width0 + width1) memset(dst, 0, width0 + width1);
+        return;
+    }
+
+    const uint64_t words0 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width0), words1 = NOAHZK_GET_WORD_WIDTH_FROM_INT(width1);
+    NOAHZK_word_t* operand0 = scratch;
+    NOAHZK_word_t* operand1 = operand0 + words0;
+    NOAHZK_word_t* product  = operand1 + words1;
+    NOAHZK_word_t* rest     = product + words0 + words1;
+    operand0[words0 - 1] = 0;
+    memcpy(operand0, rs0, width0);
+// a square is copied once and handed to the kernels as both operands, which then square it
+    if(rs0 == rs1 && width0 == width1) operand1 = operand0;
+    else{
+        operand1[words1 - 1] = 0;
+        memcpy(operand1, rs1, width1);
+    }
+
+    NOAHZK_variable_width_mul_words(product, operand0, operand1, words0, words1, rest);
+    memcpy(dst, product, width0 + width1);
+}
+
+// returns the calling thread's workspace, at least width bytes wide, or NULL if it can't be made that wide (the workspace is then left empty)
+void* NOAHZK_variable_width_mul_workspace_reserve(const uint64_t width){
+    const uint64_t words = NOAHZK_GET_WORD_WIDTH_FROM_INT(width);
+
+    if(NOAHZK_mul_workspace.width < words){
+// grows by at least 1.5 times, so that slowly growing operands don't reallocate on every multiplication
+        const uint64_t new_width = NOAHZK_MAX(words, NOAHZK_mul_workspace.width + NOAHZK_mul_workspace.width/2);
+        free(NOAHZK_mul_workspace.arr);
+        NOAHZK_mul_workspace.arr = malloc(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(new_width));
+        NOAHZK_mul_workspace.width = NOAHZK_mul_workspace.arr? new_width: 0;
+    }
+
+    return NOAHZK_mul_workspace.arr;
+}
+
+// frees the calling thread's workspace; threads that multiply should call this before they exit
+void NOAHZK_variable_width_mul_workspace_free(){
+    free(NOAHZK_mul_workspace.arr);
+    NOAHZK_mul_workspace = (NOAHZK_mul_workspace_t){ 0, NULL };
+}
+
+// dst = rs0*rs1, where rs0 is width0 bytes wide, rs1 width1 bytes and dst width0 + width1 bytes; dst may alias either operand.
+// as NOAHZK_variable_width_mul_byte_with_scratch, with the calling thread's workspace as scratch; only allocates when the workspace has to grow.
+// returns dst, or NULL if the workspace can't grow, dst being left as it was then
+void* NOAHZK_variable_width_mul_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1){
+    if(width0 == 0 || width1 == 0){
+        if(width0 + width1) memset(dst, 0, width0 + width1);
+        return dst;
+    }
+
+    void* scratch = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_variable_width_mul_byte_scratch_size(width0, width1));
+    if(!scratch) return NULL;
+    NOAHZK_variable_width_mul_byte_with_scratch(dst, rs0, rs1, width0, width1, scratch);
+    return dst;
+}
+
+// returns dst, or NULL as NOAHZK_variable_width_mul_byte does
+void* NOAHZK_variable_width_mul_constant_byte(void* dst, const void* rs0, const uint64_t k, const uint64_t width0){
     uint64_t bytes_k = NOAHZK_min_bytecnt_var(k);
-    NOAHZK_variable_width_mul_byte(dst, rs0, &k, width0, bytes_k);
+    return NOAHZK_variable_width_mul_byte(dst, rs0, &k, width0, bytes_k);
+}
+
+// dst = src*k + carry, both being byte arrays width bytes wide; returns what's carried out of dst, (src*k + carry) >> 8*width.
+// a word at a time, in place if dst is src, and without allocating anything. constant-time for a public width
+NOAHZK_word_t NOAHZK_variable_width_mul_1_byte(void* dst, const void* src, const NOAHZK_word_t k, NOAHZK_word_t carry, const uint64_t width){
+    const uint64_t whole_words = width/sizeof(NOAHZK_word_t);
+    uint64_t i = 0;
+
+    for(; i < whole_words; i++){
+        NOAHZK_word_t word;
+        memcpy(&word, (const uint8_t*)src + i*sizeof(NOAHZK_word_t), sizeof(NOAHZK_word_t));
+        const NOAHZK_dword_t z = (NOAHZK_dword_t)word*k + carry;
+        word = (NOAHZK_word_t)z;
+        memcpy((uint8_t*)dst + i*sizeof(NOAHZK_word_t), &word, sizeof(NOAHZK_word_t));
+        carry = z >> BITS_IN_NOAHZK_WORD;
+    }
+// the last word, if partial, carries out from where it ends; as it's less than 2^bits, what it carries still fits a word
+    if(width%sizeof(NOAHZK_word_t)){
+        const NOAHZK_dword_t z = (NOAHZK_dword_t)NOAHZK_word_load_byte(src, width, i)*k + carry;
+        NOAHZK_word_store_byte(dst, width, i, (NOAHZK_word_t)z);
+        carry = z >> (width%sizeof(NOAHZK_word_t)*BITS_IN_UINT8_T);
+    }
+
+    return carry;
+}
+
+// words of src*k over the words of a uint64_t, k (split into words in k_words) being as many: word i of src*k is what this returns for
+// word i of src, what's carried being kept in carry
+NOAHZK_word_t NOAHZK_variable_width_mul_constant_word(const NOAHZK_word_t word, const NOAHZK_word_t* k_words, NOAHZK_word_t* carry){
+    NOAHZK_dword_t z = (NOAHZK_dword_t)word*k_words[0] + carry[0];
+    const NOAHZK_word_t product = (NOAHZK_word_t)z;
+
+    for(uint64_t j = 1; j < NOAHZK_WORDS_IN_UINT64; j++){
+        z = (NOAHZK_dword_t)word*k_words[j] + carry[j] + (z >> BITS_IN_NOAHZK_WORD);
+        carry[j - 1] = (NOAHZK_word_t)z;
+    }
+    carry[NOAHZK_WORDS_IN_UINT64 - 1] = z >> BITS_IN_NOAHZK_WORD;
+
+    return product;
+}
+
+// dst += src*k, byte arrays width_dst and width_src bytes wide, the sum being truncated to width_dst bytes.
+// fused: the product is added in as it's worked out, a word at a time, so nothing is allocated; dst may alias src. constant-time for public widths
+void NOAHZK_variable_width_addmul_constant_byte(void* dst, const void* src, const uint64_t k, const uint64_t width_dst, const uint64_t width_src){
+    NOAHZK_word_t k_words[NOAHZK_WORDS_IN_UINT64];
+    NOAHZK_word_t carry[NOAHZK_WORDS_IN_UINT64] = {0}, carry_sum = 0;
+    memcpy(k_words, &k, sizeof(k));
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_dst); i++){
+        const NOAHZK_word_t product = NOAHZK_variable_width_mul_constant_word(NOAHZK_word_load_byte(src, width_src, i), k_words, carry);
+        NOAHZK_word_store_byte(dst, width_dst, i, NOAHZK_word_add_carry(NOAHZK_word_load_byte(dst, width_dst, i), product, &carry_sum));
+    }
+}
+
+// dst -= src*k, byte arrays width_dst and width_src bytes wide, the difference being taken modulo 2^(8*width_dst).
+// fused as NOAHZK_variable_width_addmul_constant_byte is; dst may alias src. constant-time for public widths
+void NOAHZK_variable_width_submul_constant_byte(void* dst, const void* src, const uint64_t k, const uint64_t width_dst, const uint64_t width_src){
+    NOAHZK_word_t k_words[NOAHZK_WORDS_IN_UINT64];
+    NOAHZK_word_t carry[NOAHZK_WORDS_IN_UINT64] = {0}, borrow = 0;
+    memcpy(k_words, &k, sizeof(k));
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_dst); i++){
+        const NOAHZK_word_t product = NOAHZK_variable_width_mul_constant_word(NOAHZK_word_load_byte(src, width_src, i), k_words, carry);
+        NOAHZK_word_store_byte(dst, width_dst, i, NOAHZK_word_sub_borrow(NOAHZK_word_load_byte(dst, width_dst, i), product, &borrow));
+    }
+}
+
+// dst = src*src, where src is width bytes wide and dst 2*width bytes; dst may alias src. takes the squaring kernels, which do about half the
+// multiplications of words a product of two different operands does. returns dst, or NULL as NOAHZK_variable_width_mul_byte does
+void* NOAHZK_variable_width_square_byte(void* dst, const void* src, const uint64_t width){
+    return NOAHZK_variable_width_mul_byte(dst, src, src, width, width);
 }
 
 // multiplies two variable width variables together, returns the result in dst
-// constant time
-void NOAHZK_variable_width_mul(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1){
+// constant time. returns dst, or NULL if the workspace can't grow, dst keeping its value then
+void* NOAHZK_variable_width_mul(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1){
     const uint64_t new_width = rs0->width + rs1->width;
-    dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(new_width));
+    NOAHZK_variable_width_resize_arr(dst, new_width);
 // does not need to set dst's extra space to 0 because NOAHZK_variable_width_mul_byte already sets everything to 0
-    NOAHZK_variable_width_mul_byte(dst->arr, rs0->arr, rs1->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs1));
+    if(!NOAHZK_variable_width_mul_byte(dst->arr, rs0->arr, rs1->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs1))) return NULL;
 // needs to be done after everything because rs0, rs1, dst may all alias
     dst->width = new_width;
+    return dst;
 }
 
-void NOAHZK_variable_width_mul_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, const uint64_t k){
+// returns dst, or NULL as NOAHZK_variable_width_mul does
+void* NOAHZK_variable_width_mul_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, const uint64_t k){
     const uint64_t limbs_k = NOAHZK_GET_LIMB_WIDTH_FROM_INT(NOAHZK_min_bytecnt_var(k));
     const uint64_t new_width = rs0->width + limbs_k;
-    dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(new_width));
+    NOAHZK_variable_width_resize_arr(dst, new_width);
 
-    NOAHZK_variable_width_mul_byte(dst->arr, rs0->arr, &k, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(limbs_k));
+    if(!NOAHZK_variable_width_mul_byte(dst->arr, rs0->arr, &k, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(rs0), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(limbs_k))) return NULL;
     dst->width = new_width;
+    return dst;
 }
 
-void NOAHZK_variable_width_mul_both_constants(NOAHZK_variable_width_t* dst, const uint64_t k0, const uint64_t k1){
+// returns dst, or NULL as NOAHZK_variable_width_mul does
+void* NOAHZK_variable_width_mul_both_constants(NOAHZK_variable_width_t* dst, const uint64_t k0, const uint64_t k1){
     const uint64_t bytes_k0 = NOAHZK_min_bytecnt_var(k0);
     const uint64_t bytes_k1 = NOAHZK_min_bytecnt_var(k1);
-// no need to clear dst->arr
-    dst->width = NOAHZK_GET_LIMB_WIDTH_FROM_INT(bytes_k0 + bytes_k1);
-    dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst));
+    const uint64_t new_width = NOAHZK_GET_LIMB_WIDTH_FROM_INT(bytes_k0 + bytes_k1);
+    NOAHZK_variable_width_resize_arr(dst, new_width);
+
+// the product fills bytes_k0 + bytes_k1 bytes, which needn't be a whole number of limbs; the bytes above it are cleared.
+// a product of two zeroes is 0 limbs wide, and dst's array may then be NULL
+    if(!NOAHZK_variable_width_mul_byte(dst->arr, &k0, &k1, bytes_k0, bytes_k1)) return NULL;
+    if(new_width) memset((uint8_t*)dst->arr + bytes_k0 + bytes_k1, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(new_width) - (bytes_k0 + bytes_k1));
+    dst->width = new_width;
+    return dst;
+}
 
-    NOAHZK_variable_width_mul_byte(dst->arr, &k0, &k1, bytes_k0, bytes_k1);
+// dst = src*src; src being both operands, the product takes the squaring kernels. returns dst, or NULL as NOAHZK_variable_width_mul does
+void* NOAHZK_variable_width_square(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src){
+    return NOAHZK_variable_width_mul(dst, src, src);
 }
 
 // dst = rs0*rs1*rs1
 void NOAHZK_variable_width_mul_by_square(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1){
     NOAHZK_variable_width_t product = NOAHZK_variable_width_INITIALIZER;
-    NOAHZK_variable_width_mul(&product, rs1, rs1);
+    NOAHZK_variable_width_square(&product, rs1);
 
-    NOAHZK_variable_width_add_and_resize(dst, rs0, &product);
+    NOAHZK_variable_width_mul(dst, rs0, &product);
     NOAHZK_variable_width_destroy(&product, NOAHZK_variable_width_keep_ptr);
 }
 
-void NOAHZK_variable_width_square(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src){
-    NOAHZK_variable_width_mul(dst, src, src);
-}
-
 void NOAHZK_variable_width_square_constant(NOAHZK_variable_width_t* dst, uint64_t k){
     NOAHZK_variable_width_mul_both_constants(dst, k, k);
 }
 
+// dst = rs0*k*k
 void NOAHZK_variable_width_mul_by_square_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, uint64_t k){
+// k*k is at most 128 bits wide, which fits in product's inline limbs
     NOAHZK_variable_width_t product = NOAHZK_variable_width_INITIALIZER;
     NOAHZK_variable_width_square_constant(&product, k);
 
-    NOAHZK_variable_width_add_and_resize(dst, rs0, &product);
+    NOAHZK_variable_width_mul(dst, rs0, &product);
     NOAHZK_variable_width_destroy(&product, NOAHZK_variable_width_keep_ptr);
 }
 
-// dst = rs0 * rs1**power, where power >= 0 (because it's an unsigned 64-bit integer)
-void NOAHZK_variable_width_mul_to_power_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1, uint64_t power){
-    NOAHZK_variable_width_t* product = NOAHZK_variable_width_init_constant(alloca(sizeof(NOAHZK_variable_width_t)), 1);
-    for(uint64_t i = 0; i < power; i++) NOAHZK_variable_width_mul(product, product, rs1);
-
-    NOAHZK_variable_width_add_and_resize(dst, rs0, product);
-    NOAHZK_variable_width_destroy(product, NOAHZK_variable_width_keep_ptr);
-}
-
-// dst = rs0 * k**power, where power >= 0 (because it's an unsigned 64-bit integer)
-void NOAHZK_variable_width_mul_by_constant_to_power_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, uint64_t k, const uint64_t power){
-    NOAHZK_variable_width_t* product = NOAHZK_variable_width_init_constant(alloca(sizeof(NOAHZK_variable_width_t)), 1);
-    for(uint64_t i = 0; i < power; i++) NOAHZK_variable_width_mul_constant(product, product, k);
-
-    NOAHZK_variable_width_add_and_resize(dst, rs0, product);
-    NOAHZK_variable_width_destroy(product, NOAHZK_variable_width_keep_ptr);
-}
-
-// dst += src*k
+// dst += src*k. dst is widened to hold the product and a limb over for the carry, which it's trimmed back to if said limb is left 0;
+// as resizing is by capacity, dst is only ever reallocated when its capacity runs out. NOT CONSTANT-TIME!!! as the trimming is based on what dst holds
 void NOAHZK_variable_width_madd_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, uint64_t k){
     if(!src->width) return;
 
-    NOAHZK_variable_width_t product = NOAHZK_variable_width_INITIALIZER;
-    NOAHZK_variable_width_mul_constant(&product, src, k);
+    const uint64_t width_src = src->width;
+    const uint64_t new_width = NOAHZK_MAX(dst->width, width_src + NOAHZK_GET_LIMB_WIDTH_FROM_INT(NOAHZK_min_bytecnt_var(k))) + 1;
+    NOAHZK_variable_width_resize_arr(dst, new_width);
 
-    NOAHZK_variable_width_add_and_resize(dst, dst, &product);
-    NOAHZK_variable_width_destroy(&product, NOAHZK_variable_width_keep_ptr);
+    NOAHZK_variable_width_addmul_constant_byte(dst->arr, src->arr, k, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(new_width), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_src));
+    dst->width = new_width - !dst->arr[new_width - 1];
+}
+
+// dst -= src*k, dst keeping its width (the difference is taken modulo 2^(BITS_IN_NOAHZK_LIMB*dst->width), as subtraction is)
+void NOAHZK_variable_width_msub_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, uint64_t k){
+    NOAHZK_variable_width_submul_constant_byte(dst->arr, src->arr, k, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src));
 }
 
 // dst = (dst + rs1)*rs2, where all are variable-width vars
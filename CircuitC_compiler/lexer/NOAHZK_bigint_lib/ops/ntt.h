@@ -0,0 +1,196 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_ntt_included
+#define NOAHZK_bigint_ntt_included
+
+#include "definitions.h"    // NOAHZK word types
+#include "stdint.h"         // integer types
+#include "string.h"         // memset
+#include "word.h"           // words with carries
+
+// multiplication by number-theoretic transforms: the operands' words are taken as the coefficients of two polynomials, whose product (their
+// convolution) is worked out modulo three primes of the form c*2^k + 1 by transforms of length 2^n, and put back together by the Chinese
+// remainder theorem. a coefficient of the product is less than 2^n*B^2, which the product of the three primes is greater than.
+// the primes are less than B/2, so that a sum of two residues can't overflow a word; residues are kept in Montgomery form (x*B mod p).
+// nothing here branches on anything but widths, so the transforms are constant-time for public widths
+#ifdef __SIZEOF_INT128__
+#define NOAHZK_NTT_MAX_LOG_LENGTH                   40                  // 2^40 divides p - 1 for all three primes
+#define NOAHZK_NTT_PRIMES                           { 4611480409752993793ULL, 4611524390218104833ULL, 4611546380450660353ULL }      // 4194117*2^40 + 1, 4194157*2^40 + 1, 4194177*2^40 + 1
+#define NOAHZK_NTT_GENERATORS                       { 10, 3, 5 }
+#else
+// the product of these is about 2^85.6, which bounds the transforms to 2^21 words rather than the 2^24 the primes would allow
+#define NOAHZK_NTT_MAX_LOG_LENGTH                   21
+#define NOAHZK_NTT_PRIMES                           { 167772161U, 469762049U, 754974721U }      // 5*2^25 + 1, 7*2^26 + 1, 45*2^24 + 1
+#define NOAHZK_NTT_GENERATORS                       { 3, 3, 11 }
+#endif
+#define NOAHZK_NTT_PRIME_COUNT                      3
+
+// a prime transforms are done modulo, with what Montgomery multiplication takes
+typedef struct{
+    NOAHZK_word_t p;
+    NOAHZK_word_t inverse;      // p^-1 mod B
+    NOAHZK_word_t one;          // B mod p, 1 in Montgomery form
+    NOAHZK_word_t r2;           // B^2 mod p, which takes a residue into Montgomery form
+} NOAHZK_ntt_prime_t;
+
+NOAHZK_ntt_prime_t NOAHZK_ntt_prime_init(const NOAHZK_word_t p){
+    NOAHZK_ntt_prime_t prime = { p, p, (NOAHZK_word_t)(0 - p) % p, 0 };
+// p*p = 1 mod 8 for odd p, and each Newton step doubles the bits p^-1 is right to
+    for(uint64_t i = 0; i < 5; i++) prime.inverse *= 2 - p*prime.inverse;
+    prime.r2 = (NOAHZK_dword_t)prime.one*prime.one % p;
+    return prime;
+}
+
+// a*b*B^-1 mod p, for a*b < p*B (so for any word times a residue)
+NOAHZK_word_t NOAHZK_ntt_mul(const NOAHZK_word_t a, const NOAHZK_word_t b, const NOAHZK_ntt_prime_t* prime){
+    const NOAHZK_dword_t product = (NOAHZK_dword_t)a*b;
+// m*p has the same low word as the product, so their difference is the high words' difference, B times over; it's between -p and p
+    const NOAHZK_word_t m = (NOAHZK_word_t)product*prime->inverse;
+    const NOAHZK_word_t difference = (NOAHZK_word_t)(product >> BITS_IN_NOAHZK_WORD) - (NOAHZK_word_t)((NOAHZK_dword_t)m*prime->p >> BITS_IN_NOAHZK_WORD);
+    return difference + (prime->p & (0 - (difference >> (BITS_IN_NOAHZK_WORD - 1))));
+}
+
+NOAHZK_word_t NOAHZK_ntt_add(const NOAHZK_word_t a, const NOAHZK_word_t b, const NOAHZK_ntt_prime_t* prime){
+    const NOAHZK_word_t sum = a + b - prime->p;
+    return sum + (prime->p & (0 - (sum >> (BITS_IN_NOAHZK_WORD - 1))));
+}
+
+NOAHZK_word_t NOAHZK_ntt_sub(const NOAHZK_word_t a, const NOAHZK_word_t b, const NOAHZK_ntt_prime_t* prime){
+    const NOAHZK_word_t difference = a - b;
+    return difference + (prime->p & (0 - (difference >> (BITS_IN_NOAHZK_WORD - 1))));
+}
+
+// base^exponent, base and the result being in Montgomery form. only ever raised to public exponents
+NOAHZK_word_t NOAHZK_ntt_pow(NOAHZK_word_t base, NOAHZK_word_t exponent, const NOAHZK_ntt_prime_t* prime){
+    NOAHZK_word_t power = prime->one;
+
+    for(; exponent; exponent >>= 1, base = NOAHZK_ntt_mul(base, base, prime)) if(exponent & 1) power = NOAHZK_ntt_mul(power, base, prime);
+    return power;
+}
+
+// the roots of unity each round of a transform of length words takes, in Montgomery form: with root a primitive length-th root,
+// roots[half + j] = (root^(length/(2*half)))^j for j < half and half = 1, 2, ..., length/2, so that a round's roots are read in order
+void NOAHZK_ntt_roots(NOAHZK_word_t* roots, const NOAHZK_word_t root, const uint64_t length, const NOAHZK_ntt_prime_t* prime){
+    roots[length/2] = prime->one;
+    for(uint64_t j = 1; j < length/2; j++) roots[length/2 + j] = NOAHZK_ntt_mul(roots[length/2 + j - 1], root, prime);
+// a round of half the span takes the square of the root, so every other root of the round above
+    for(uint64_t half = length/4; half >= 1; half >>= 1) for(uint64_t j = 0; j < half; j++) roots[half + j] = roots[2*(half + j)];
+}
+
+// forward transform of the length residues at a, in place; decimation in frequency, so a is taken in order and left in bit-reversed order.
+// roots is as NOAHZK_ntt_roots leaves it
+void NOAHZK_ntt_forward(NOAHZK_word_t* a, const NOAHZK_word_t* roots, const uint64_t length, const NOAHZK_ntt_prime_t* prime){
+    for(uint64_t half = length/2; half >= 1; half >>= 1){
+        for(uint64_t i = 0; i < length; i += 2*half) for(uint64_t j = 0; j < half; j++){
+            const NOAHZK_word_t u = a[i + j], v = a[i + j + half];
+            a[i + j]        = NOAHZK_ntt_add(u, v, prime);
+            a[i + j + half] = NOAHZK_ntt_mul(NOAHZK_ntt_sub(u, v, prime), roots[half + j], prime);
+        }
+    }
+}
+
+// inverse of NOAHZK_ntt_forward but for a factor of length: decimation in time, so a is taken in bit-reversed order and left in order.
+// roots is as NOAHZK_ntt_roots leaves it for the inverse of the root the forward transform took
+void NOAHZK_ntt_inverse(NOAHZK_word_t* a, const NOAHZK_word_t* roots, const uint64_t length, const NOAHZK_ntt_prime_t* prime){
+    for(uint64_t half = 1; half < length; half <<= 1){
+        for(uint64_t i = 0; i < length; i += 2*half) for(uint64_t j = 0; j < half; j++){
+            const NOAHZK_word_t u = a[i + j], v = NOAHZK_ntt_mul(a[i + j + half], roots[half + j], prime);
+            a[i + j]        = NOAHZK_ntt_add(u, v, prime);
+            a[i + j + half] = NOAHZK_ntt_sub(u, v, prime);
+        }
+    }
+}
+
+// log2 of the length of the transforms that multiply operands width0 and width1 words wide: the least power of 2 the product fits in
+uint64_t NOAHZK_ntt_log_length(const uint64_t width0, const uint64_t width1){
+    uint64_t log_length = 0;
+    while(((uint64_t)1 << log_length) < width0 + width1) log_length++;
+    return log_length;
+}
+
+// whether operands width0 and width1 words wide can be multiplied by transforms
+int NOAHZK_variable_width_mul_ntt_fits(const uint64_t width0, const uint64_t width1){
+    return NOAHZK_ntt_log_length(width0, width1) <= NOAHZK_NTT_MAX_LOG_LENGTH;
+}
+
+// scratch (in words) NOAHZK_variable_width_mul_ntt_words takes: each prime has two operands' worth of residues and two tables of roots
+uint64_t NOAHZK_variable_width_mul_ntt_scratch(const uint64_t width0, const uint64_t width1){
+    return NOAHZK_NTT_PRIME_COUNT*4*((uint64_t)1 << NOAHZK_ntt_log_length(width0, width1));
+}
+
+// residues = rs0*rs1 mod prime, as the length = 2^log_length coefficients of the product, in order and out of Montgomery form.
+// scratch is 3*length words wide. rs0 and rs1 being the same array makes it a square, which takes one forward transform rather than two
+void NOAHZK_variable_width_mul_ntt_residues_words(NOAHZK_word_t* residues, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1, const uint64_t log_length, const NOAHZK_word_t p, const NOAHZK_word_t generator, NOAHZK_word_t* scratch){
+    const NOAHZK_ntt_prime_t prime = NOAHZK_ntt_prime_init(p);
+    const uint64_t length = (uint64_t)1 << log_length;
+    NOAHZK_word_t* transform = scratch;
+    NOAHZK_word_t* roots = transform + length;
+    NOAHZK_word_t* inverse_roots = roots + length;
+
+// p - 1 = c*2^k with k at least log_length, so generator^((p - 1)/length) is a primitive length-th root of unity
+    const NOAHZK_word_t root = NOAHZK_ntt_pow(NOAHZK_ntt_mul(generator, prime.r2, &prime), (p - 1) >> log_length, &prime);
+    NOAHZK_ntt_roots(roots, root, length, &prime);
+    NOAHZK_ntt_roots(inverse_roots, NOAHZK_ntt_pow(root, length - 1, &prime), length, &prime);
+
+    memset(residues, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(length));
+    for(uint64_t i = 0; i < width0; i++) residues[i] = NOAHZK_ntt_mul(rs0[i], prime.r2, &prime);
+    NOAHZK_ntt_forward(residues, roots, length, &prime);
+
+    if(rs0 == rs1 && width0 == width1) for(uint64_t i = 0; i < length; i++) residues[i] = NOAHZK_ntt_mul(residues[i], residues[i], &prime);
+    else{
+        memset(transform, 0, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(length));
+        for(uint64_t i = 0; i < width1; i++) transform[i] = NOAHZK_ntt_mul(rs1[i], prime.r2, &prime);
+        NOAHZK_ntt_forward(transform, roots, length, &prime);
+        for(uint64_t i = 0; i < length; i++) residues[i] = NOAHZK_ntt_mul(residues[i], transform[i], &prime);
+    }
+
+    NOAHZK_ntt_inverse(residues, inverse_roots, length, &prime);
+// length^-1 = -(p - 1)/length mod p; multiplying by it, not in Montgomery form, takes the residues out of Montgomery form too
+    const NOAHZK_word_t length_inverse = p - ((p - 1) >> log_length);
+    for(uint64_t i = 0; i < length; i++) residues[i] = NOAHZK_ntt_mul(residues[i], length_inverse, &prime);
+}
+
+// dst = rs0*rs1, dst being width0 + width1 words wide and aliasing neither operand, for operands that NOAHZK_variable_width_mul_ntt_fits;
+// scratch is at least NOAHZK_variable_width_mul_ntt_scratch(width0, width1) words wide.
+// the primes' transforms are independent of one another, and are run in parallel when built with OpenMP
+void NOAHZK_variable_width_mul_ntt_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1, NOAHZK_word_t* scratch){
+    const NOAHZK_word_t primes[NOAHZK_NTT_PRIME_COUNT] = NOAHZK_NTT_PRIMES, generators[NOAHZK_NTT_PRIME_COUNT] = NOAHZK_NTT_GENERATORS;
+    const uint64_t log_length = NOAHZK_ntt_log_length(width0, width1), length = (uint64_t)1 << log_length;
+
+#ifdef _OPENMP
+    #pragma omp parallel for if(log_length >= 14)
+#endif
+    for(int64_t i = 0; i < NOAHZK_NTT_PRIME_COUNT; i++) NOAHZK_variable_width_mul_ntt_residues_words(scratch + i*length, rs0, rs1, width0, width1, log_length, primes[i], generators[i], scratch + NOAHZK_NTT_PRIME_COUNT*length + 3*i*length);
+
+// Garner's form of the Chinese remainder theorem: x = x0 + p0*(x1 + p1*x2), where x0 = r0, x1 = (r1 - x0)/p0 mod p1 and
+// x2 = (r2 - x0 - x1*p0)/(p0*p1) mod p2. the constants are in Montgomery form, so multiplying by them leaves residues as they are
+    const NOAHZK_ntt_prime_t prime1 = NOAHZK_ntt_prime_init(primes[1]), prime2 = NOAHZK_ntt_prime_init(primes[2]);
+    const NOAHZK_word_t p0_inverse_mod_p1 = NOAHZK_ntt_pow(NOAHZK_ntt_mul(primes[0], prime1.r2, &prime1), primes[1] - 2, &prime1);
+    const NOAHZK_word_t p0_mod_p2 = NOAHZK_ntt_mul(primes[0], prime2.r2, &prime2);
+    const NOAHZK_word_t p0p1_inverse_mod_p2 = NOAHZK_ntt_pow(NOAHZK_ntt_mul(p0_mod_p2, NOAHZK_ntt_mul(primes[1], prime2.r2, &prime2), &prime2), primes[2] - 2, &prime2);
+    const NOAHZK_word_t *r0 = scratch, *r1 = r0 + length, *r2 = r1 + length;
+// the product so far past the words already in dst; less than B^2 once shifted, so adding a coefficient (less than p0*p1*p2) can't overflow it
+    NOAHZK_word_t accumulator[2] = { 0, 0 };
+
+    for(uint64_t i = 0; i < width0 + width1; i++){
+        const NOAHZK_word_t x1 = NOAHZK_ntt_mul(NOAHZK_ntt_sub(r1[i], r0[i], &prime1), p0_inverse_mod_p1, &prime1);
+        const NOAHZK_word_t x2 = NOAHZK_ntt_mul(NOAHZK_ntt_sub(NOAHZK_ntt_sub(r2[i], r0[i], &prime2), NOAHZK_ntt_mul(x1, p0_mod_p2, &prime2), &prime2), p0p1_inverse_mod_p2, &prime2);
+// x1 + p1*x2 < p1*p2 < B^2, and p0 times that, plus x0, fits three words
+        const NOAHZK_dword_t inner = (NOAHZK_dword_t)x2*primes[1] + x1;
+        const NOAHZK_dword_t low = (NOAHZK_dword_t)primes[0]*(NOAHZK_word_t)inner + r0[i];
+        const NOAHZK_dword_t high = (NOAHZK_dword_t)primes[0]*(NOAHZK_word_t)(inner >> BITS_IN_NOAHZK_WORD) + (NOAHZK_word_t)(low >> BITS_IN_NOAHZK_WORD);
+
+        NOAHZK_word_t carry = 0;
+        dst[i]         = NOAHZK_word_add_carry(accumulator[0], (NOAHZK_word_t)low, &carry);
+        accumulator[0] = NOAHZK_word_add_carry(accumulator[1], (NOAHZK_word_t)high, &carry);
+        accumulator[1] = (NOAHZK_word_t)(high >> BITS_IN_NOAHZK_WORD) + carry;
+    }
+}
+
+#endif
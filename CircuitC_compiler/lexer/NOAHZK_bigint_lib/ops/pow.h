@@ -0,0 +1,248 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_pow_included
+#define NOAHZK_bigint_pow_included
+
+#include "definitions.h"    // NOAHZK variable-width type
+#include "logarithms.h"     // bit width of constants and arrays
+#include "stdint.h"         // integer types
+#include "stdlib.h"         // dynamic memory operations
+#include "string.h"         // memset, memcpy
+#include "type.h"           // ops to allocate, destroy variable width types
+#include "mul.h"            // multiplication kernels, the thread's workspace
+#include "div.h"            // reduction, Barrett and Montgomery contexts
+
+#define NOAHZK_POW_MAX_WINDOW                       4                   // bits in the widest window an exponent is split into
+#define NOAHZK_POW_MAX_RESULT_BITS                  ((uint64_t)1 << 56) // powers wider than this are refused, as the workspace they take wouldn't fit in 64 bits
+
+// powers are worked out by left-to-right sliding windows: the exponent is read from its top bit down, runs of zeroes costing a squaring per bit
+// and each window (up to NOAHZK_variable_width_pow_window bits, starting and ending with a 1) costing a squaring per bit and one multiplication
+// by an odd power of the base, picked from a table. that's about log2(power) squarings and log2(power)/(window + 1) multiplications.
+
+// bits in a window for an exponent bits wide; the table of odd powers it takes is 2^(window - 1) entries long
+uint64_t NOAHZK_variable_width_pow_window(const uint64_t bits){
+    return bits > 24? NOAHZK_POW_MAX_WINDOW: bits > 8? 3: bits > 2? 2: 1;
+}
+
+// splits power, which may not be 0, into windows up to window bits wide: window i is multiplied in (odd_powers[i] being the odd power it stands for)
+// after squarings[i] squarings, and trailing squarings follow the last one. the first window starts off the result, so it comes after no squarings.
+// returns the number of windows, which is at most 64
+uint64_t NOAHZK_variable_width_pow_windows(const uint64_t power, const uint64_t window, uint8_t* squarings, uint8_t* odd_powers, uint64_t* trailing){
+    uint64_t windows = 0, zeroes = 0;
+
+    for(uint64_t bit = NOAHZK_min_bitcnt_var(power); bit-- > 0;){
+        if(!(power >> bit & 1)){
+            zeroes++;
+            continue;
+        }
+
+        uint64_t low = bit + 1 > window? bit + 1 - window: 0;
+        while(!(power >> low & 1)) low++;
+
+        squarings[windows] = windows? zeroes + bit - low + 1: 0;
+        odd_powers[windows] = power >> low & (((uint64_t)1 << (bit - low + 1)) - 1);
+        windows++;
+        zeroes = 0;
+        bit = low;
+    }
+
+    *trailing = zeroes;
+    return windows;
+}
+
+// dst = rs0*rs1 as NOAHZK_variable_width_mul_words does, returning the width of the product with its leading zero words dropped; neither operand is 0
+uint64_t NOAHZK_variable_width_pow_product_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1, NOAHZK_word_t* scratch){
+    uint64_t width = width0 + width1;
+
+    NOAHZK_variable_width_mul_words(dst, rs0, rs1, width0, width1, scratch);
+    while(!dst[width - 1]) width--;
+
+    return width;
+}
+
+// dst = src**power, dst being resized to the width of the result. the result's width is known from the start (power times that of src),
+// so the products are made in the thread's workspace without any reallocation. returns dst, or NULL if the result would be wider than
+// NOAHZK_POW_MAX_RESULT_BITS or the workspace can't be allocated, dst being left as it was then. not constant-time
+void* NOAHZK_variable_width_pow_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, const uint64_t power){
+    const uint64_t bits = NOAHZK_variable_width_min_bitcnt(src);
+
+    if(power == 0 || bits == 0){
+        NOAHZK_variable_width_resize_arr(dst, 1);
+        dst->arr[0] = power == 0;
+        dst->width = 1;
+        return dst;
+    }
+
+// src = 2^k (1 included) makes for 2^(k*power), a single bit, which takes no multiplying
+    if(NOAHZK_variable_width_popcount(src) == 1){
+        if(bits > 1 && power > (NOAHZK_POW_MAX_RESULT_BITS - 1)/(bits - 1)) return NULL;
+
+        const uint64_t shift = (bits - 1)*power, width_dst = NOAHZK_GET_LIMB_WIDTH_FROM_INT(NOAHZK_convert_from_bits_to_bytes(shift + 1));
+        NOAHZK_variable_width_resize_arr(dst, width_dst);
+        memset(dst->arr, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_dst));
+        dst->arr[shift/BITS_IN_NOAHZK_LIMB] = (NOAHZK_limb_t)1 << (shift%BITS_IN_NOAHZK_LIMB);
+        dst->width = width_dst;
+        return dst;
+    }
+    if(power > NOAHZK_POW_MAX_RESULT_BITS/bits) return NULL;
+
+    const uint64_t width = NOAHZK_GET_WORD_WIDTH_FROM_INT(NOAHZK_convert_from_bits_to_bytes(bits)), width_result = NOAHZK_GET_WORD_WIDTH_FROM_INT(NOAHZK_convert_from_bits_to_bytes(bits*power));
+    const uint64_t window = NOAHZK_variable_width_pow_window(NOAHZK_min_bitcnt_var(power)), table_entries = (uint64_t)1 << (window - 1);
+// a product of two values whose product is at most width_result words wide takes at most width_result + 1 words before leading zeroes are dropped
+    const uint64_t width_slot = width_result + 1;
+
+    NOAHZK_word_t* acc   = NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH((3 + table_entries)*width_slot + 3*width_result + NOAHZK_variable_width_mul_scratch(width_result, width_result)));
+    if(!acc) return NULL;
+    NOAHZK_word_t* tmp   = acc + width_slot;
+    NOAHZK_word_t* x2    = tmp + width_slot;
+    NOAHZK_word_t* table = x2 + width_slot;
+    NOAHZK_word_t* rest  = table + table_entries*width_slot;
+    uint64_t width_table[(uint64_t)1 << (NOAHZK_POW_MAX_WINDOW - 1)], width_acc = 0, width_x2 = 0;
+
+// table[i] = src**(2i + 1)
+    for(uint64_t i = 0; i < width; i++) table[i] = NOAHZK_word_load_byte(src->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src), i);
+    width_table[0] = width;
+    if(table_entries > 1) width_x2 = NOAHZK_variable_width_pow_product_words(x2, table, table, width, width, rest);
+    for(uint64_t i = 1; i < table_entries; i++) width_table[i] = NOAHZK_variable_width_pow_product_words(table + i*width_slot, table + (i - 1)*width_slot, x2, width_table[i - 1], width_x2, rest);
+
+    uint8_t squarings[BITS_IN_UINT64_T], odd_powers[BITS_IN_UINT64_T];
+    uint64_t trailing;
+    const uint64_t windows = NOAHZK_variable_width_pow_windows(power, window, squarings, odd_powers, &trailing);
+
+// each product goes into tmp, which is then swapped with acc
+    memcpy(acc, table + odd_powers[0]/2*width_slot, NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(width_table[odd_powers[0]/2]));
+    width_acc = width_table[odd_powers[0]/2];
+    for(uint64_t i = 1; i <= windows; i++){
+        for(uint64_t j = 0; j < (i < windows? squarings[i]: trailing); j++){
+            width_acc = NOAHZK_variable_width_pow_product_words(tmp, acc, acc, width_acc, width_acc, rest);
+            NOAHZK_SWP_PTR(acc, tmp);
+        }
+        if(i == windows) break;
+
+        width_acc = NOAHZK_variable_width_pow_product_words(tmp, acc, table + odd_powers[i]/2*width_slot, width_acc, width_table[odd_powers[i]/2], rest);
+        NOAHZK_SWP_PTR(acc, tmp);
+    }
+
+    const uint64_t width_dst = NOAHZK_GET_LIMB_WIDTH_FROM_INT(NOAHZK_convert_from_bits_to_bytes(bits*power));
+    NOAHZK_variable_width_resize_arr(dst, width_dst);
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_dst)); i++)
+        NOAHZK_word_store_byte(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_dst), i, i < width_acc? acc[i]: 0);
+    dst->width = width_dst;
+    return dst;
+}
+
+// dst = rs0*rs1 mod the modulus of montgomery if odd is set (all of them being in Montgomery form), of barrett otherwise, all of them width bytes wide.
+// product is 2*width bytes of scratch for Barrett to reduce, the workspace having been grown for making it (so that the product can't fail)
+void NOAHZK_variable_width_pow_mod_product_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width, const uint8_t odd, NOAHZK_montgomery_ctx_t* montgomery, NOAHZK_barrett_ctx_t* barrett, void* product){
+    if(odd){
+        NOAHZK_variable_width_montgomery_mul_byte(montgomery, dst, rs0, rs1);
+        return;
+    }
+
+    NOAHZK_variable_width_mul_byte(product, rs0, rs1, width, width);
+    NOAHZK_variable_width_barrett_reduce_byte(barrett, dst, product, 2*width);
+}
+
+// dst = src**power mod modulus, where src is width_src bytes wide and modulus and dst width bytes; modulus may not be 0, and dst may alias src.
+// odd moduli (which is what fields are) are multiplied modulo in Montgomery form, even ones by reducing each product with Barrett's method.
+// constant-time for public widths and a public power: src is reduced by binary long division rather than Knuth's algorithm D, whose steps depend on the operands.
+// returns dst, or NULL if the table of powers, the Montgomery or Barrett context or the workspace can't be allocated, dst being left as it was then
+void* NOAHZK_variable_width_pow_mod_byte(void* dst, const void* src, const void* modulus, const uint64_t width_src, const uint64_t width, const uint64_t power){
+    const uint64_t one = 1;
+
+// x**0 = 1, which is 0 modulo 1
+    if(power == 0) return NOAHZK_variable_width_divrem_ct_byte(NULL, dst, &one, modulus, sizeof(one), width);
+
+    const uint64_t window = NOAHZK_variable_width_pow_window(NOAHZK_min_bitcnt_var(power)), table_entries = (uint64_t)1 << (window - 1);
+    const uint8_t odd = *(const uint8_t*)modulus & 1;
+// the table of odd powers, the accumulator and the square of the base, followed by a product twice as wide for Barrett to reduce
+    uint8_t* table   = malloc((table_entries + 4)*width);
+    if(!table) return NULL;
+    uint8_t* acc     = table + table_entries*width;
+    uint8_t* x2      = acc + width;
+    uint8_t* product = x2 + width;
+    NOAHZK_montgomery_ctx_t montgomery;
+    NOAHZK_barrett_ctx_t barrett;
+
+    if(odd? !NOAHZK_variable_width_montgomery_init(&montgomery, modulus, width): !NOAHZK_variable_width_barrett_init(&barrett, modulus, width)){
+        free(table);
+        return NULL;
+    }
+
+// table[i] = src**(2i + 1). the products Barrett reduces are made in the workspace, which is grown for them here, before anything is worked out
+    if(!NOAHZK_variable_width_divrem_ct_byte(NULL, table, src, modulus, width_src, width)
+        || (!odd && !NOAHZK_variable_width_mul_workspace_reserve(NOAHZK_variable_width_mul_byte_scratch_size(width, width)))){
+        if(odd) NOAHZK_variable_width_montgomery_destroy(&montgomery, NOAHZK_variable_width_keep_ptr);
+        else NOAHZK_variable_width_barrett_destroy(&barrett, NOAHZK_variable_width_keep_ptr);
+        free(table);
+        return NULL;
+    }
+    if(odd) NOAHZK_variable_width_montgomery_to_byte(&montgomery, table, table);
+    if(table_entries > 1) NOAHZK_variable_width_pow_mod_product_byte(x2, table, table, width, odd, &montgomery, &barrett, product);
+    for(uint64_t i = 1; i < table_entries; i++) NOAHZK_variable_width_pow_mod_product_byte(table + i*width, table + (i - 1)*width, x2, width, odd, &montgomery, &barrett, product);
+
+    uint8_t squarings[BITS_IN_UINT64_T], odd_powers[BITS_IN_UINT64_T];
+    uint64_t trailing;
+    const uint64_t windows = NOAHZK_variable_width_pow_windows(power, window, squarings, odd_powers, &trailing);
+
+    memcpy(acc, table + odd_powers[0]/2*width, width);
+    for(uint64_t i = 1; i <= windows; i++){
+        for(uint64_t j = 0; j < (i < windows? squarings[i]: trailing); j++) NOAHZK_variable_width_pow_mod_product_byte(acc, acc, acc, width, odd, &montgomery, &barrett, product);
+        if(i < windows) NOAHZK_variable_width_pow_mod_product_byte(acc, acc, table + odd_powers[i]/2*width, width, odd, &montgomery, &barrett, product);
+    }
+
+    if(odd){
+        NOAHZK_variable_width_montgomery_from_byte(&montgomery, dst, acc);
+        NOAHZK_variable_width_montgomery_destroy(&montgomery, NOAHZK_variable_width_keep_ptr);
+    }
+    else{
+        memcpy(dst, acc, width);
+        NOAHZK_variable_width_barrett_destroy(&barrett, NOAHZK_variable_width_keep_ptr);
+    }
+    free(table);
+    return dst;
+}
+
+// dst = src**power mod modulus, dst being as wide as modulus, which may not be 0.
+// returns dst, or NULL if NOAHZK_variable_width_pow_mod_byte can't allocate what it needs, dst keeping its value then
+void* NOAHZK_variable_width_pow_mod_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, const uint64_t power, NOAHZK_variable_width_t* modulus){
+    const uint64_t new_width = modulus->width;
+    NOAHZK_variable_width_resize_arr(dst, new_width);
+
+    if(!NOAHZK_variable_width_pow_mod_byte(dst->arr, src->arr, modulus->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(modulus), power)) return NULL;
+// needs to be done after everything because src and dst may alias
+    dst->width = new_width;
+    return dst;
+}
+
+// dst = rs0 * rs1**power, where power >= 0 (because it's an unsigned 64-bit integer).
+// returns dst, or NULL if rs1**power can't be worked out (see NOAHZK_variable_width_pow_constant) or the workspace can't grow, dst being left as it was then
+void* NOAHZK_variable_width_mul_to_power_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1, uint64_t power){
+    NOAHZK_variable_width_t product = NOAHZK_variable_width_INITIALIZER;
+    void* result = NOAHZK_variable_width_pow_constant(&product, rs1, power);
+
+    if(result) result = NOAHZK_variable_width_mul(dst, rs0, &product);
+    NOAHZK_variable_width_destroy(&product, NOAHZK_variable_width_keep_ptr);
+    return result;
+}
+
+// dst = rs0 * k**power, where power >= 0 (because it's an unsigned 64-bit integer).
+// returns dst, or NULL if k**power can't be worked out (see NOAHZK_variable_width_pow_constant) or the workspace can't grow, dst being left as it was then
+void* NOAHZK_variable_width_mul_by_constant_to_power_constant(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, uint64_t k, const uint64_t power){
+    NOAHZK_variable_width_t base = NOAHZK_variable_width_INITIALIZER, product = NOAHZK_variable_width_INITIALIZER;
+    NOAHZK_variable_width_init_constant(&base, k);
+    void* result = NOAHZK_variable_width_pow_constant(&product, &base, power);
+
+    if(result) result = NOAHZK_variable_width_mul(dst, rs0, &product);
+    NOAHZK_variable_width_destroy(&base, NOAHZK_variable_width_keep_ptr);
+    NOAHZK_variable_width_destroy(&product, NOAHZK_variable_width_keep_ptr);
+    return result;
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_shift_included
+#define NOAHZK_bigint_shift_included
+
+#include "definitions.h"    // NOAHZK variable-width type
+#include "stdint.h"         // integer types
+#include "word.h"           // funnel shifts, byte array loads and stores
+
+// shifts move whole words: a shift by shamt bits is one by shamt/BITS_IN_NOAHZK_WORD words, each word of the result being funnelled
+// out of the two words of the source it straddles. dst may be src, in which case the shift is done in place, words being written
+// in the order that only overwrites those already read.
+
+// dst = src >> shamt, src being width_src bytes wide and zero-extended, dst being width_result bytes wide.
+// constant-time for a public shamt
+void NOAHZK_variable_width_shift_right_byte(void* dst, const void* src, const uint64_t width_src, const uint64_t width_result, const uint64_t shamt){
+    const uint64_t words = shamt/BITS_IN_NOAHZK_WORD, bits = shamt%BITS_IN_NOAHZK_WORD;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_result); i++){
+        const NOAHZK_word_t word = NOAHZK_word_load_byte(src, width_src, i + words), next = NOAHZK_word_load_byte(src, width_src, i + words + 1);
+        NOAHZK_word_store_byte(dst, width_result, i, NOAHZK_word_shift_in_right(word, next, bits));
+    }
+}
+
+// dst = src << shamt, src being width_src bytes wide and zero-extended, dst being width_result bytes wide, which the result is truncated to.
+// constant-time for a public shamt
+void NOAHZK_variable_width_shift_left_byte(void* dst, const void* src, const uint64_t width_src, const uint64_t width_result, const uint64_t shamt){
+    const uint64_t words = shamt/BITS_IN_NOAHZK_WORD, bits = shamt%BITS_IN_NOAHZK_WORD;
+
+    for(uint64_t i = NOAHZK_GET_WORD_WIDTH_FROM_INT(width_result); i-- > 0;){
+        const NOAHZK_word_t word = i >= words? NOAHZK_word_load_byte(src, width_src, i - words): 0, previous = i > words? NOAHZK_word_load_byte(src, width_src, i - words - 1): 0;
+        NOAHZK_word_store_byte(dst, width_result, i, NOAHZK_word_shift_in(word, previous, bits));
+    }
+}
+
+// dst = src >> shamt, both width bytes wide, in constant time even if shamt is secret: the shift is done as a shift by every power of two
+// below the width in bits, each of them kept or not (by mask) as the matching bit of shamt says. costs log2(width in bits) passes over dst
+void NOAHZK_variable_width_shift_right_ct_byte(void* dst, const void* src, const uint64_t width, const uint64_t shamt){
+    const uint64_t width_in_bits = width*BITS_IN_UINT8_T;
+    const void* from = src;
+
+    for(uint64_t step = 0; step < BITS_IN_UINT64_T && (uint64_t)1 << step < width_in_bits; step++){
+        const uint64_t words = ((uint64_t)1 << step)/BITS_IN_NOAHZK_WORD, bits = ((uint64_t)1 << step)%BITS_IN_NOAHZK_WORD;
+        const NOAHZK_word_t mask = -(NOAHZK_word_t)(shamt >> step & 1);
+
+        for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width); i++){
+            const NOAHZK_word_t word = NOAHZK_word_load_byte(from, width, i);
+            const NOAHZK_word_t shifted = NOAHZK_word_shift_in_right(NOAHZK_word_load_byte(from, width, i + words), NOAHZK_word_load_byte(from, width, i + words + 1), bits);
+            NOAHZK_word_store_byte(dst, width, i, (shifted & mask) | (word &~mask));
+        }
+        from = dst;
+    }
+
+// every bit of a shamt below the width in bits was handled above; any shamt from the width up leaves nothing
+    const NOAHZK_word_t keep = NOAHZK_word_less_than_mask(shamt, width_in_bits);
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width); i++) NOAHZK_word_store_byte(dst, width, i, NOAHZK_word_load_byte(from, width, i) & keep);
+}
+
+// dst = src << shamt, both width bytes wide, in constant time even if shamt is secret; see NOAHZK_variable_width_shift_right_ct_byte
+void NOAHZK_variable_width_shift_left_ct_byte(void* dst, const void* src, const uint64_t width, const uint64_t shamt){
+    const uint64_t width_in_bits = width*BITS_IN_UINT8_T;
+    const void* from = src;
+
+    for(uint64_t step = 0; step < BITS_IN_UINT64_T && (uint64_t)1 << step < width_in_bits; step++){
+        const uint64_t words = ((uint64_t)1 << step)/BITS_IN_NOAHZK_WORD, bits = ((uint64_t)1 << step)%BITS_IN_NOAHZK_WORD;
+        const NOAHZK_word_t mask = -(NOAHZK_word_t)(shamt >> step & 1);
+
+        for(uint64_t i = NOAHZK_GET_WORD_WIDTH_FROM_INT(width); i-- > 0;){
+            const NOAHZK_word_t word = NOAHZK_word_load_byte(from, width, i);
+            const NOAHZK_word_t low = i >= words? NOAHZK_word_load_byte(from, width, i - words): 0, previous = i > words? NOAHZK_word_load_byte(from, width, i - words - 1): 0;
+            NOAHZK_word_store_byte(dst, width, i, (NOAHZK_word_shift_in(low, previous, bits) & mask) | (word &~mask));
+        }
+        from = dst;
+    }
+
+    const NOAHZK_word_t keep = NOAHZK_word_less_than_mask(shamt, width_in_bits);
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width); i++) NOAHZK_word_store_byte(dst, width, i, NOAHZK_word_load_byte(from, width, i) & keep);
+}
+
+// dst = src >> shamt, dst keeping its width; constant-time for a public shamt
+void NOAHZK_variable_width_shift_right(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, const uint64_t shamt){
+    NOAHZK_variable_width_shift_right_byte(dst->arr, src->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst), shamt);
+}
+
+// dst = src << shamt, dst keeping its width; constant-time for a public shamt
+void NOAHZK_variable_width_shift_left(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* src, const uint64_t shamt){
+    NOAHZK_variable_width_shift_left_byte(dst->arr, src->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(dst), shamt);
+}
+
+#endif
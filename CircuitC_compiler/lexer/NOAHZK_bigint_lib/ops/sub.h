@@ -11,6 +11,8 @@
 
 #include "definitions.h"    // NOAHZK variable-width type
 #include "stdint.h"         // integer types
+#include "type.h"           // resizing variable-width types
+#include "word.h"           // word-sized subtract-with-borrow, byte array loads and stores
 
 // dst = rs0 + or - (by virtue of op) rs1; constant-time regardless of op as long as add and sub take equal time in the CPU
 void NOAHZK_variable_width_add_or_sub(NOAHZK_variable_width_t* dst, NOAHZK_variable_width_t* rs0, NOAHZK_variable_width_t* rs1, const NOAHZK_op_t op){
@@ -77,8 +79,7 @@ void NOAHZK_variable_width_sub_and_resize(NOAHZK_variable_width_t* dst, NOAHZK_v
     const uint64_t largest_width = NOAHZK_MAX(rs0->width, rs1->width); 
 // expands dst to size of largest operand, initializing new space to 0 
     if(dst->width < largest_width){
-        dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width));
-        memset(dst->arr + dst->width, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width - dst->width));
+        NOAHZK_variable_width_resize_arr(dst, largest_width);
         dst->width = largest_width;
     }
 
@@ -96,8 +97,7 @@ void NOAHZK_variable_width_sub_and_resize_constant(NOAHZK_variable_width_t* dst,
     const uint64_t largest_width = NOAHZK_MAX(rs0->width, sizeof(k)/sizeof(*rs0->arr)); 
 // expands dst to size of largest operand, initializing new space to 0 
     if(dst->width < largest_width){
-        dst->arr = realloc(dst->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width));
-        memset(dst->arr + dst->width, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(largest_width - dst->width));
+        NOAHZK_variable_width_resize_arr(dst, largest_width);
         dst->width = largest_width;
     }
 
@@ -109,82 +109,70 @@ void NOAHZK_variable_width_sub_and_resize_constant(NOAHZK_variable_width_t* dst,
     }
 }
 
-// compiles to constant-time code on any cpu with constant-time shifts.
-void NOAHZK_variable_width_neg_byte(void* real_dst, const void* real_src, const uint64_t width){
-    uint8_t carry = 1;
-    uint8_t *dst = real_dst;
-    const uint8_t *src = real_src;
-
-    for(uint64_t i = 0; i < width; i++){
-// if subtraction overflows and requires a borrow, z (when interpreted as a signed type) is negative and thus bit 15 is set. this also means that bit 8 is set, so we can check that for borrow. 
-        uint16_t z = (uint16_t)(~src[i]) + carry;
-        dst[i] = z & UINT8_MAX;
-        carry = z >> BITS_IN_UINT8_T;
-    }
+// dst = rs0 - rs1 over width_result words, operands being zero-extended to it; returns the borrow out, so the result is negative (in two's complement) if it's 1.
+// constant-time for public widths. dst may alias either operand as long as it starts where said operand does
+NOAHZK_word_t NOAHZK_variable_width_sub_words(NOAHZK_word_t* dst, const NOAHZK_word_t* rs0, const NOAHZK_word_t* rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result){
+    NOAHZK_word_t borrow = 0;
+
+    for(uint64_t i = 0; i < width_result; i++) dst[i] = NOAHZK_word_sub_borrow(i < width0? rs0[i]: 0, i < width1? rs1[i]: 0, &borrow);
+
+    return borrow;
 }
 
-void NOAHZK_variable_width_sub_with_bit_offset_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result, uint64_t bit_offset){
-    int8_t borrow = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0, *rs1 = real_rs1;
-
-    const uint64_t byte_offset = bit_offset/BITS_IN_UINT8_T;
-
-    for(uint64_t i = byte_offset; i < width_result; i++){
-// runs in constant time regardless of conditional statements because those statements are NOT DATA-DEPENDENT; widths of operands in NOAHZK are public.
-// correctly applies offset because shifts rs1 by bit_offset modulo BITS_IN_UINT8_T
-// the top 8 bits of z are set to the "overflow/shifted data" that doesn't fit inside the bottom 8 bits, to which the carry out from the previous addition is also added
-// the top 8 bits are set as the carry for the next repetition and this is repeated
-// we have the top bits that didn't fit in 8 bits of the previous addtition stored inside carry and added to the bottom part of the next addition
-// idk how good this explanation is.
-        uint16_t z = (uint16_t)(i < width0? rs0[i]: 0) - (i-byte_offset < width1? (uint16_t)rs1[i-byte_offset] << (bit_offset % BITS_IN_UINT8_T): 0) + (int16_t)borrow;
-
-        dst[i] = z & UINT8_MAX;
-        borrow = z >> BITS_IN_UINT8_T;
-    }
+// dst = -src over width words if mask is all ones, dst = src if it's 0, in constant time
+void NOAHZK_variable_width_neg_if_words(NOAHZK_word_t* dst, const NOAHZK_word_t* src, const uint64_t width, const NOAHZK_word_t mask){
+// -x = ~x + 1, and x = (x ^ 0) + 0
+    NOAHZK_word_t carry = mask & 1;
+
+    for(uint64_t i = 0; i < width; i++) dst[i] = NOAHZK_word_add_carry(src[i] ^ mask, 0, &carry);
 }
 
-// compiles to constant-time code on any cpu with constant-time shifts.
-void NOAHZK_variable_width_sub_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width){
-    uint8_t borrow = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0, *rs1 = real_rs1;
-
-    for(uint64_t i = 0; i < width; i++){
-// if subtraction overflows and requires a borrow, z (when interpreted as a signed type) is negative and thus bit 15 is set. this also means that bit 8 is set, so we can check that for borrow. 
-        uint16_t z = (uint16_t)rs0[i] - (uint16_t)rs1[i] - borrow;
-        dst[i] = z & UINT8_MAX;
-        borrow = z >> BITS_IN_UINT8_T & 1;
+// dst = rs0 - rs1, byte arrays whose operands are zero-extended to width_result; done a word at a time.
+// constant-time, as whether a word is partial only depends on widths, which are public.
+void NOAHZK_variable_width_both_sub_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result){
+    NOAHZK_word_t borrow = 0;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_result); i++){
+        const NOAHZK_word_t z = NOAHZK_word_sub_borrow(NOAHZK_word_load_byte(rs0, width0, i), NOAHZK_word_load_byte(rs1, width1, i), &borrow);
+        NOAHZK_word_store_byte(dst, width_result, i, z);
     }
 }
 
-// compiles to constant-time code on any cpu with constant-time shifts.
-void NOAHZK_variable_width_sub_constant_byte(void* real_dst, const void* real_rs0, const uint64_t k, const uint64_t width){
-    uint8_t borrow = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0;
-
-    for(uint64_t i = 0; i < width; i++){
-// if subtraction overflows and requires a borrow, z (when interpreted as a signed type) is negative and thus bit 15 is set. this also means that bit 8 is set, so we can check that for borrow. 
-        uint16_t z = (uint16_t)rs0[i] - NOAHZK_get_section_from_var(k, UINT8_MAX, i, uint8_t) - borrow;
-        dst[i] = z & UINT8_MAX;
-        borrow = z >> BITS_IN_UINT8_T & 1;
-    }
+// dst = -src, width bytes wide; constant-time
+void NOAHZK_variable_width_neg_byte(void* dst, const void* src, const uint64_t width){
+// -x = ~x + 1
+    NOAHZK_word_t carry = 1;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width); i++) NOAHZK_word_store_byte(dst, width, i, NOAHZK_word_add_carry(~NOAHZK_word_load_byte(src, width, i), 0, &carry));
 }
 
-// compiles to constant-time code on any cpu with constant-time shifts.
-void NOAHZK_variable_width_both_sub_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result){
-    uint8_t borrow = 0;
-    uint8_t *dst = real_dst;
-    const uint8_t *rs0 = real_rs0, *rs1 = real_rs1;
-
-    for(uint64_t i = 0; i < width_result; i++){
-// if subtraction overflows and requires a borrow, z (when interpreted as a signed type) is negative and thus bit 15 is set. this also means that bit 8 is set, so we can check that for borrow. 
-// runs in constant time regardless of conditional statements because those statements are NOT DATA-DEPENDENT; widths of operands in NOAHZK are public.
-        uint16_t z = (uint16_t)(i < width0? rs0[i]: 0) - (uint16_t)(i < width1? rs1[i]: 0) - borrow;
-        dst[i] = z & UINT8_MAX;
-        borrow = z >> BITS_IN_UINT8_T & 1;
+// dst = rs0 - (rs1 << bit_offset) from byte bit_offset/8 of dst up to width_result; the bytes of dst below that are left as they are
+void NOAHZK_variable_width_sub_with_bit_offset_byte(void* real_dst, const void* real_rs0, const void* real_rs1, const uint64_t width0, const uint64_t width1, const uint64_t width_result, uint64_t bit_offset){
+    const uint64_t offset = NOAHZK_MIN(bit_offset/BITS_IN_UINT8_T, width_result), shamt = bit_offset%BITS_IN_UINT8_T;
+    const uint64_t width0_offset = width0 > offset? width0 - offset: 0, width_result_offset = width_result - offset;
+    uint8_t *dst = (uint8_t*)real_dst + offset;
+    const uint8_t *rs0 = (const uint8_t*)real_rs0 + offset;
+    NOAHZK_word_t borrow = 0;
+
+    NOAHZK_word_t previous = 0;
+
+    for(uint64_t i = 0; i < NOAHZK_GET_WORD_WIDTH_FROM_INT(width_result_offset); i++){
+        const NOAHZK_word_t word = NOAHZK_word_load_byte(real_rs1, width1, i);
+        const NOAHZK_word_t z = NOAHZK_word_sub_borrow(NOAHZK_word_load_byte(rs0, width0_offset, i), NOAHZK_word_shift_in(word, previous, shamt), &borrow);
+        NOAHZK_word_store_byte(dst, width_result_offset, i, z);
+        previous = word;
     }
 }
 
+// dst = rs0 - rs1, all of them width bytes wide; constant-time
+void NOAHZK_variable_width_sub_byte(void* dst, const void* rs0, const void* rs1, const uint64_t width){
+    NOAHZK_variable_width_both_sub_byte(dst, rs0, rs1, width, width, width);
+}
+
+// dst = rs0 - k, both width bytes wide; constant-time
+void NOAHZK_variable_width_sub_constant_byte(void* dst, const void* rs0, const uint64_t k, const uint64_t width){
+// k is read as a byte array, as every other operand
+    NOAHZK_variable_width_both_sub_byte(dst, rs0, &k, width, sizeof(k), width);
+}
+
 #endif
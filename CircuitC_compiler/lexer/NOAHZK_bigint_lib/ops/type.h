@@ -15,17 +15,82 @@
 #include "string.h"         // memset, memcpy
 #include "stdlib.h"         // dynamic memory operations
 
+// array of width limbs, zeroed, for x to hold: its inline array if width fits in it, one on the heap otherwise. sets x's capacity to match
+NOAHZK_limb_t* NOAHZK_variable_width_alloc_arr(NOAHZK_variable_width_t* x, const uint64_t width){
+    if(width <= NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS){
+        memset(x->inline_arr, 0, sizeof(x->inline_arr));
+        x->capacity = NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS;
+        return x->inline_arr;
+    }
+    x->capacity = width;
+    return calloc(sizeof(NOAHZK_limb_t), width);
+}
+
+// how many limbs x's array has room for
+uint64_t NOAHZK_variable_width_capacity(const NOAHZK_variable_width_t* x){
+    if(!x->arr) return 0;
+    return x->capacity? x->capacity: x->width;
+}
+
+// makes room in x's array for at least capacity limbs, keeping its contents; when it has to grow, it grows by at least half again, so
+// that slowly growing variables aren't reallocated every time. the array moves out of the struct once it stops fitting in it
+void NOAHZK_variable_width_reserve(NOAHZK_variable_width_t* x, const uint64_t capacity){
+    const uint64_t old_capacity = NOAHZK_variable_width_capacity(x);
+    if(capacity <= old_capacity) return;
+
+    const uint64_t new_capacity = NOAHZK_MAX(capacity, old_capacity + old_capacity/2);
+    if(!x->arr && new_capacity <= NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS){
+        x->arr = x->inline_arr;
+        x->capacity = NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS;
+        return;
+    }
+
+    if(x->arr && NOAHZK_VARIABLE_WIDTH_IS_INLINE(x)){
+        NOAHZK_limb_t* arr = malloc(NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(new_capacity));
+        memcpy(arr, x->inline_arr, sizeof(x->inline_arr));
+        x->arr = arr;
+    }
+    else x->arr = realloc(x->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(new_capacity));
+    x->capacity = new_capacity;
+}
+
+// frees what x's array has room for beyond its width, moving it back into the struct if it fits there
+void NOAHZK_variable_width_shrink(NOAHZK_variable_width_t* x){
+    if(!x->arr || NOAHZK_VARIABLE_WIDTH_IS_INLINE(x) || NOAHZK_variable_width_capacity(x) == x->width) return;
+
+    if(x->width <= NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS){
+        memcpy(x->inline_arr, x->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(x));
+        free(x->arr);
+        x->arr = x->inline_arr;
+        x->capacity = NOAHZK_VARIABLE_WIDTH_INLINE_LIMBS;
+        return;
+    }
+
+    x->arr = realloc(x->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(x));
+    x->capacity = x->width;
+}
+
+// resizes x's array from x->width limbs to width limbs, keeping what fits of its contents and zeroing the limbs it grows by; only
+// reallocates if width is more than x's capacity, and never shrinks the array (see NOAHZK_variable_width_shrink).
+// x->width is left as is, so that ops whose dst aliases an operand may still read said operand at its old width after resizing dst;
+// they set it once they're done
+void NOAHZK_variable_width_resize_arr(NOAHZK_variable_width_t* x, const uint64_t width){
+    NOAHZK_variable_width_reserve(x, width);
+    if(width > x->width) memset(x->arr + x->width, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width - x->width));
+}
+
 void* NOAHZK_variable_width_init(NOAHZK_variable_width_t* toinit, const uint64_t width_in_bytes){
     if(!toinit) toinit = malloc(sizeof(NOAHZK_variable_width_t));
 
     const uint64_t width = NOAHZK_SIZE_AS_ARR_OF_TYPE(width_in_bytes, sizeof(NOAHZK_limb_t));
     if(width){
-        toinit->arr = calloc(sizeof(NOAHZK_limb_t), width);
+        toinit->arr = NOAHZK_variable_width_alloc_arr(toinit, width);
         toinit->width = width;
     }
     else{
         toinit->arr = NULL;
         toinit->width = 0;
+        toinit->capacity = 0;
     }
     return toinit;
 }
@@ -36,13 +101,14 @@ void* NOAHZK_variable_width_init_arr(NOAHZK_variable_width_t* toinit, void* arr,
 
     const uint64_t width = NOAHZK_SIZE_AS_ARR_OF_TYPE(width_in_bytes, sizeof(NOAHZK_limb_t));
     if(width){
-        toinit->arr = calloc(sizeof(NOAHZK_limb_t), width);
+        toinit->arr = NOAHZK_variable_width_alloc_arr(toinit, width);
         toinit->width = width;
         memcpy(toinit->arr, arr, width_in_bytes);
     }
     else{
         toinit->arr = NULL;
         toinit->width = 0;
+        toinit->capacity = 0;
     }
     return toinit;
 }
@@ -54,7 +120,7 @@ void* NOAHZK_variable_width_init_constant(NOAHZK_variable_width_t* toinit, uint6
     const uint64_t width_in_bits = NOAHZK_min_bitcnt_var(k);
     const uint64_t width = NOAHZK_SIZE_AS_ARR_OF_TYPE(width_in_bits, BITS_IN_NOAHZK_LIMB);
     if(width){
-        toinit->arr = malloc(sizeof(NOAHZK_limb_t)*width);
+        toinit->arr = NOAHZK_variable_width_alloc_arr(toinit, width);
         memcpy(toinit->arr, &k, sizeof(NOAHZK_limb_t)*width);
 
         toinit->width = width;
@@ -62,6 +128,7 @@ void* NOAHZK_variable_width_init_constant(NOAHZK_variable_width_t* toinit, uint6
     else{
         toinit->arr = NULL;
         toinit->width = 0;
+        toinit->capacity = 0;
     }
     return toinit;
 }
@@ -70,9 +137,9 @@ void* NOAHZK_variable_width_copy(NOAHZK_variable_width_t* restrict dst, NOAHZK_v
     if(!dst) dst = malloc(sizeof(NOAHZK_variable_width_t));
 
     dst->width = src->width;
-    dst->arr = malloc(NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src));
-
-    memcpy(dst->arr, src->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src));
+    dst->arr = NOAHZK_variable_width_alloc_arr(dst, src->width);
+// a zero-width src may have no array at all
+    if(src->width) memcpy(dst->arr, src->arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(src));
 
     return dst;
 }
@@ -93,7 +160,15 @@ void* NOAHZK_variable_width_move(NOAHZK_variable_width_t* restrict dst, NOAHZK_v
     if(!dst) dst = malloc(sizeof(NOAHZK_variable_width_t));
 
     dst->width = src->width; src->width = 0;
-    dst->arr = src->arr; src->arr = NULL;
+    dst->capacity = src->capacity; src->capacity = 0;
+// an inline array can't be handed over, as it's part of src; it's copied into dst's
+    if(src->arr && NOAHZK_VARIABLE_WIDTH_IS_INLINE(src)){
+        memcpy(dst->inline_arr, src->inline_arr, sizeof(src->inline_arr));
+        memset(src->inline_arr, 0, sizeof(src->inline_arr));
+        dst->arr = dst->inline_arr;
+    }
+    else dst->arr = src->arr;
+    src->arr = NULL;
 
     return dst;
 }
@@ -102,9 +177,10 @@ typedef enum{ NOAHZK_variable_width_keep_ptr, NOAHZK_variable_width_free_ptr } N
 
 void NOAHZK_variable_width_destroy(NOAHZK_variable_width_t* todestroy, NOAHZK_variable_width_option_t freeptr){
     if(todestroy->arr){
-        memset(todestroy->arr, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_PTR(todestroy));
+// clears all the array has room for, as limbs past the width may still hold what was there before it last shrank
+        memset(todestroy->arr, 0, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(NOAHZK_variable_width_capacity(todestroy)));
         memset(&todestroy->width, 0, sizeof(todestroy->width));
-        free(todestroy->arr);
+        if(!NOAHZK_VARIABLE_WIDTH_IS_INLINE(todestroy)) free(todestroy->arr);
     } 
 
     if(freeptr == NOAHZK_variable_width_free_ptr) free(todestroy);
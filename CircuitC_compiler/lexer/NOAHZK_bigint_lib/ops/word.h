@@ -0,0 +1,106 @@
+/*
+   NOAHZK_bigint reference source code package - reference C implementations
+
+   Copyright 2025, dedmanwalking <dedmanwalking@proton.me>.  You may use this under the
+   terms of the CC0 1.0 Universal license, linked below:
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+*/
+
+#ifndef NOAHZK_bigint_word_included
+#define NOAHZK_bigint_word_included
+
+#include "definitions.h"    // NOAHZK word types
+#include "stdint.h"         // integer types
+#include "string.h"         // memcpy
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__) && (defined(__GNUC__) || defined(__clang__))
+#include "x86intrin.h"      // _addcarry_u64, _subborrow_u64
+#define NOAHZK_WORD_X86_64_CARRY
+#endif
+
+// building blocks of the word-sized kernels the *_byte ops are wrappers over.
+// byte arrays are read and written a word at a time, the last word of an array whose width isn't a multiple of the word size being
+// zero-extended when read and only written as far as the array goes. whether a word is whole, partial or past the end only depends on widths,
+// which are public, so all of these are constant-time.
+
+// a + b + *carry, the carry out (0 or 1) being stored back in *carry
+NOAHZK_word_t NOAHZK_word_add_carry(const NOAHZK_word_t a, const NOAHZK_word_t b, NOAHZK_word_t* carry){
+#ifdef NOAHZK_WORD_X86_64_CARRY
+    unsigned long long z;
+    *carry = _addcarry_u64((unsigned char)*carry, a, b, &z);
+    return z;
+#else
+    const NOAHZK_dword_t z = (NOAHZK_dword_t)a + b + *carry;
+    *carry = z >> BITS_IN_NOAHZK_WORD;
+    return (NOAHZK_word_t)z;
+#endif
+}
+
+// a - b - *borrow, the borrow out (0 or 1) being stored back in *borrow
+NOAHZK_word_t NOAHZK_word_sub_borrow(const NOAHZK_word_t a, const NOAHZK_word_t b, NOAHZK_word_t* borrow){
+#ifdef NOAHZK_WORD_X86_64_CARRY
+    unsigned long long z;
+    *borrow = _subborrow_u64((unsigned char)*borrow, a, b, &z);
+    return z;
+#else
+// borrow goes into the bits above the word, all of which it sets; it's masked down to 1
+    const NOAHZK_dword_t z = (NOAHZK_dword_t)a - b - *borrow;
+    *borrow = z >> BITS_IN_NOAHZK_WORD & 1;
+    return (NOAHZK_word_t)z;
+#endif
+}
+
+// word i (counting in words) of src, a byte array width bytes wide
+NOAHZK_word_t NOAHZK_word_load_byte(const void* src, const uint64_t width, const uint64_t i){
+    const uint64_t byte = i*sizeof(NOAHZK_word_t);
+    NOAHZK_word_t word = 0;
+
+    if(byte + sizeof(NOAHZK_word_t) <= width) memcpy(&word, (const uint8_t*)src + byte, sizeof(NOAHZK_word_t));
+    else if(byte < width) memcpy(&word, (const uint8_t*)src + byte, width - byte);
+
+    return word;
+}
+
+// sets word i (counting in words) of dst, a byte array width bytes wide, to word
+void NOAHZK_word_store_byte(void* dst, const uint64_t width, const uint64_t i, const NOAHZK_word_t word){
+    const uint64_t byte = i*sizeof(NOAHZK_word_t);
+
+    if(byte + sizeof(NOAHZK_word_t) <= width) memcpy((uint8_t*)dst + byte, &word, sizeof(NOAHZK_word_t));
+    else if(byte < width) memcpy((uint8_t*)dst + byte, &word, width - byte);
+}
+
+// word shifted left by shamt bits, shamt being less than BITS_IN_NOAHZK_WORD, with the bits shifted out of the word before it (previous) coming in
+NOAHZK_word_t NOAHZK_word_shift_in(const NOAHZK_word_t word, const NOAHZK_word_t previous, const uint64_t shamt){
+// shifting by BITS_IN_NOAHZK_WORD - shamt in two steps keeps shamt = 0 from shifting by the width of the word
+    return word << shamt | (previous >> 1) >> (BITS_IN_NOAHZK_WORD - 1 - shamt);
+}
+
+// word shifted right by shamt bits, shamt being less than BITS_IN_NOAHZK_WORD, with the bits shifted out of the word after it (next) coming in
+NOAHZK_word_t NOAHZK_word_shift_in_right(const NOAHZK_word_t word, const NOAHZK_word_t next, const uint64_t shamt){
+    return word >> shamt | (next << 1) << (BITS_IN_NOAHZK_WORD - 1 - shamt);
+}
+
+// all ones if a < b, 0 otherwise, in constant time: the borrow out of a - b is worked out from the top bits rather than by comparing (which may branch)
+NOAHZK_word_t NOAHZK_word_less_than_mask(const uint64_t a, const uint64_t b){
+    return -(NOAHZK_word_t)((a ^ ((a ^ b) | ((a - b) ^ b))) >> (BITS_IN_UINT64_T - 1));
+}
+
+// number of leading zero bits of word, which may not be 0
+uint64_t NOAHZK_word_clz(const NOAHZK_word_t word){
+    return __builtin_clzll(word) - (BITS_IN_UINT64_T - BITS_IN_NOAHZK_WORD);
+}
+
+// number of trailing zero bits of word, which may not be 0
+uint64_t NOAHZK_word_ctz(const NOAHZK_word_t word){
+    return __builtin_ctzll(word);
+}
+
+// number of bits of word that are set. counted by adding up neighbouring bit fields, as __builtin_popcountll may become a table lookup where
+// the CPU has no popcount instruction
+uint64_t NOAHZK_word_popcount(NOAHZK_word_t word){
+    word = word - (word >> 1 & (NOAHZK_word_t)0x5555555555555555ULL);
+    word = (word & (NOAHZK_word_t)0x3333333333333333ULL) + (word >> 2 & (NOAHZK_word_t)0x3333333333333333ULL);
+    word = (word + (word >> 4)) & (NOAHZK_word_t)0x0f0f0f0f0f0f0f0fULL;
+    return (NOAHZK_word_t)(word*(NOAHZK_word_t)0x0101010101010101ULL) >> (BITS_IN_NOAHZK_WORD - BITS_IN_UINT8_T);
+}
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef CIRCUITC_arena_included
+#define CIRCUITC_arena_included
+
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "string.h"             // memcpy
+
+// bump allocator: memory is handed out from large blocks by moving a pointer forward, and is only ever given back all at once,
+// by resetting or destroying the arena. meant for things that are made in great numbers and all die together, such as the nodes of a tree.
+// a compilation keeps one arena for everything that lives as long as it does, and each phase can take its own arena (or a mark on a shared one,
+// rewound once the phase is over) for what only that phase needs. modules that allocate take an arena as an optional context: NULL means malloc.
+//
+// every arena counts what it's asked for and what it costs; allocations - blocks is the number of calls to malloc/realloc the arena saved.
+
+#define CIRCUITC_ARENA_BLOCK_SIZE                   (64*1024)           // allocations larger than this get a block of their own
+#define CIRCUITC_ARENA_ALIGNMENT                    16                  // enough for any type
+
+typedef struct CIRCUITC_arena_block{
+    struct CIRCUITC_arena_block* next;
+    size_t size;                        // bytes used
+    size_t capacity;                    // bytes allocated after the header
+    _Alignas(CIRCUITC_ARENA_ALIGNMENT) char bytes[];
+} CIRCUITC_arena_block_t;
+
+typedef struct{
+    uint64_t allocations;               // calls to CIRCUITC_arena_alloc and CIRCUITC_arena_realloc
+    uint64_t grown_in_place;            // calls to CIRCUITC_arena_realloc that didn't have to move the allocation
+    uint64_t blocks;                    // calls to malloc
+    uint64_t bytes;                     // bytes handed out, after alignment
+    uint64_t resets;                    // calls to CIRCUITC_arena_reset and CIRCUITC_arena_rewind
+} CIRCUITC_arena_stats_t;
+
+typedef struct{
+    CIRCUITC_arena_block_t* blocks;     // block being filled, which points to those filled before it
+    CIRCUITC_arena_block_t* spare;      // block of CIRCUITC_ARENA_BLOCK_SIZE bytes given back by a rewind, used before going to malloc again (or NULL)
+    CIRCUITC_arena_stats_t stats;
+} CIRCUITC_arena_t;
+
+// where an arena was at some point; rewinding to it gives back everything allocated since
+typedef struct{
+    CIRCUITC_arena_block_t* block;
+    size_t size;
+} CIRCUITC_arena_mark_t;
+
+typedef enum{ CIRCUITC_arena_keep_ctx, CIRCUITC_arena_free_ctx } CIRCUITC_arena_options_t;
+
+CIRCUITC_arena_t* CIRCUITC_arena_init(CIRCUITC_arena_t* arena){
+    if(!arena) arena = malloc(sizeof(*arena));
+
+    arena->blocks = NULL;
+    arena->spare = NULL;
+    arena->stats = (CIRCUITC_arena_stats_t){ 0 };
+
+    return arena;
+}
+
+void CIRCUITC_arena_destroy(CIRCUITC_arena_t* arena, CIRCUITC_arena_options_t freectx){
+    while(arena->blocks){
+        CIRCUITC_arena_block_t* next = arena->blocks->next;
+        free(arena->blocks);
+        arena->blocks = next;
+    }
+    free(arena->spare);
+
+    if(freectx == CIRCUITC_arena_free_ctx) free(arena);
+}
+
+size_t CIRCUITC_arena_align(const size_t size){
+    return (size + CIRCUITC_ARENA_ALIGNMENT - 1) &~(size_t)(CIRCUITC_ARENA_ALIGNMENT - 1);
+}
+
+// returns size bytes aligned to CIRCUITC_ARENA_ALIGNMENT, which stay valid until the arena is reset or destroyed
+void* CIRCUITC_arena_alloc(CIRCUITC_arena_t* arena, size_t size){
+    CIRCUITC_arena_block_t* block = arena->blocks;
+    size = CIRCUITC_arena_align(size);
+
+    if(!block || block->capacity - block->size < size){
+        if(size <= CIRCUITC_ARENA_BLOCK_SIZE && arena->spare){
+            block = arena->spare;
+            arena->spare = NULL;
+        }
+        else{
+            const size_t capacity = size > CIRCUITC_ARENA_BLOCK_SIZE? size: CIRCUITC_ARENA_BLOCK_SIZE;
+            block = malloc(sizeof(*block) + capacity);
+            block->capacity = capacity;
+            arena->stats.blocks++;
+        }
+        block->size = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void* allocation = block->bytes + block->size;
+    block->size += size;
+
+    arena->stats.allocations++;
+    arena->stats.bytes += size;
+    return allocation;
+}
+
+// resizes allocation of old_size bytes to new_size bytes, as realloc does. the allocation grows in place if nothing was allocated after it
+// and its block has room; otherwise it's copied, and the old copy is only given back along with the rest of the arena.
+void* CIRCUITC_arena_realloc(CIRCUITC_arena_t* arena, void* allocation, const size_t old_size, const size_t new_size){
+    if(!allocation) return CIRCUITC_arena_alloc(arena, new_size);
+
+    CIRCUITC_arena_block_t* block = arena->blocks;
+    const size_t old_aligned_size = CIRCUITC_arena_align(old_size), new_aligned_size = CIRCUITC_arena_align(new_size);
+
+    if((char*)allocation + old_aligned_size == block->bytes + block->size && block->capacity - (block->size - old_aligned_size) >= new_aligned_size){
+        block->size = block->size - old_aligned_size + new_aligned_size;
+
+        arena->stats.allocations++;
+        arena->stats.grown_in_place++;
+        if(new_aligned_size > old_aligned_size) arena->stats.bytes += new_aligned_size - old_aligned_size;
+        return allocation;
+    }
+    if(new_size <= old_size) return allocation;
+
+    void* moved = CIRCUITC_arena_alloc(arena, new_size);
+    memcpy(moved, allocation, old_size);
+    return moved;
+}
+
+CIRCUITC_arena_mark_t CIRCUITC_arena_mark(const CIRCUITC_arena_t* arena){
+    return (CIRCUITC_arena_mark_t){ arena->blocks, arena->blocks? arena->blocks->size: 0 };
+}
+
+// gives back everything allocated from arena; the newest block is kept, so an arena that is reset and filled again doesn't go back to malloc
+void CIRCUITC_arena_reset(CIRCUITC_arena_t* arena){
+    if(!arena->blocks) return;
+
+    CIRCUITC_arena_block_t* block = arena->blocks->next;
+    while(block){
+        CIRCUITC_arena_block_t* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->blocks->next = NULL;
+    arena->blocks->size = 0;
+    arena->stats.resets++;
+}
+
+// gives back everything allocated from arena since mark was taken; blocks made since then are freed, save for one that is kept as a spare,
+// so that a phase that's marked and rewound over and over (say, once per value) doesn't go back to malloc every time it needs a new block.
+// a mark taken on an empty arena rewinds it as CIRCUITC_arena_reset does.
+void CIRCUITC_arena_rewind(CIRCUITC_arena_t* arena, const CIRCUITC_arena_mark_t mark){
+    if(!mark.block){
+        CIRCUITC_arena_reset(arena);
+        return;
+    }
+
+    while(arena->blocks != mark.block){
+        CIRCUITC_arena_block_t* next = arena->blocks->next;
+        if(!arena->spare && arena->blocks->capacity == CIRCUITC_ARENA_BLOCK_SIZE) arena->spare = arena->blocks;
+        else free(arena->blocks);
+        arena->blocks = next;
+    }
+
+    arena->blocks->size = mark.size;
+    arena->stats.resets++;
+}
+
+// calls to malloc and realloc that going through arena saved
+uint64_t CIRCUITC_arena_mallocs_saved(const CIRCUITC_arena_t* arena){
+    return arena->stats.allocations - arena->stats.blocks;
+}
+
+#endif
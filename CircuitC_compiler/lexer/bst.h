@@ -4,9 +4,18 @@
 #include "stdlib.h"             // dynamic memory operations
 #include "stdint.h"             // types
 #include "string.h"             // strcmp
+#include "arena.h"              // node allocation
 
 // all I need is an opaque type that I can use to search for values, and from which I can get values.
 // more to it if it's fast, but CIRCUITC has very few keywords, so speed isn't that important.
+// the tree will back the interpreter's symbol tables too though, and those hold far more entries; and keyword tables are put in sorted order,
+// which turns a plain binary search tree into a linked list. so the tree is an AVL tree: it stays balanced no matter what order keys are put in.
+//
+// rotations swap the contents of nodes rather than relinking them, so the root node stays the root node (callers hold on to it, and CIRCUITC_tree_del takes it by value).
+// this means a node returned by a search may hold another key once the tree is changed.
+// nodes are malloc'd one by one, or taken from an arena if the root was made through CIRCUITC_tree_node_make_from, in which case they go away along with said arena.
+
+#define CIRCUITC_TREE_MAX_HEIGHT                    96                  // AVL trees are at most ~1.44*log2(n) tall, which stays under this for any n that fits in memory
 
 typedef uint64_t CIRCUITC_value_t;
 
@@ -15,38 +24,110 @@ typedef struct CIRCUITC_tree{
     struct CIRCUITC_tree* gt;
     char* key;
     CIRCUITC_value_t value;
+    CIRCUITC_arena_t* arena;            // arena nodes of tree are taken from, or NULL if they're malloc'd
+    uint8_t height;                     // height of subtree rooted at node, 1 for leaves
 } CIRCUITC_tree_t;
 
 typedef enum{ CIRCUITC_tree_keep_key, CIRCUITC_tree_free_key } CIRCUITC_tree_options_t;
 typedef enum{ CIRCUITC_tree_no_error, CIRCUITC_tree_error } CIRCUITC_tree_error_code_t;
 
+void CIRCUITC_tree_node_destroy(CIRCUITC_tree_t* node, CIRCUITC_tree_options_t freekey){
+    if(freekey == CIRCUITC_tree_free_key) free(node->key);
+    if(!node->arena) free(node);
+}
+
 void CIRCUITC_tree_destroy(CIRCUITC_tree_t* tree, CIRCUITC_tree_options_t freekey){
     if(!tree) return;
 
     if(tree->lt) CIRCUITC_tree_destroy(tree->lt, freekey);
     if(tree->gt) CIRCUITC_tree_destroy(tree->gt, freekey);
 
-    if(freekey == CIRCUITC_tree_free_key) free(tree->key);
-    free(tree);
+    CIRCUITC_tree_node_destroy(tree, freekey);
 }
 
-CIRCUITC_tree_t* CIRCUITC_tree_node_make(char* key, CIRCUITC_value_t value){
-    CIRCUITC_tree_t* node = calloc(1, sizeof(CIRCUITC_tree_t));
+// makes node out of arena, or through malloc if arena is NULL; a tree whose root is made from an arena takes all of its nodes from said arena
+CIRCUITC_tree_t* CIRCUITC_tree_node_make_from(CIRCUITC_arena_t* arena, char* key, CIRCUITC_value_t value){
+    CIRCUITC_tree_t* node = arena? CIRCUITC_arena_alloc(arena, sizeof(*node)): malloc(sizeof(*node));
 
+    node->lt = NULL;
+    node->gt = NULL;
     node->key = key;
     node->value = value;
+    node->arena = arena;
+    node->height = 1;
 
     return node;
 }
 
-void CIRCUITC_tree_node_destroy(CIRCUITC_tree_t* node, CIRCUITC_tree_options_t freekey){
-    if(freekey == CIRCUITC_tree_free_key) free(node->key);
-    free(node);
+CIRCUITC_tree_t* CIRCUITC_tree_node_make(char* key, CIRCUITC_value_t value){
+    return CIRCUITC_tree_node_make_from(NULL, key, value);
+}
+
+uint8_t CIRCUITC_tree_height(const CIRCUITC_tree_t* tree){
+    return tree? tree->height: 0;
+}
+
+void CIRCUITC_tree_update_height(CIRCUITC_tree_t* node){
+    const uint8_t height_lt = CIRCUITC_tree_height(node->lt), height_gt = CIRCUITC_tree_height(node->gt);
+    node->height = 1 + (height_lt > height_gt? height_lt: height_gt);
+}
+
+void CIRCUITC_tree_swap_contents(CIRCUITC_tree_t* a, CIRCUITC_tree_t* b){
+    char* key = a->key;
+    a->key = b->key;
+    b->key = key;
+
+    const CIRCUITC_value_t value = a->value;
+    a->value = b->value;
+    b->value = value;
+}
+
+// node(x) with lt = lt(y) with lt = A, gt = B; gt = C  ~>  node(y) with lt = A; gt = lt(x) with lt = B, gt = C
+void CIRCUITC_tree_rotate_gt(CIRCUITC_tree_t* node){
+    CIRCUITC_tree_t* moved = node->lt;
+    CIRCUITC_tree_swap_contents(node, moved);
+
+    node->lt = moved->lt;
+    moved->lt = moved->gt;
+    moved->gt = node->gt;
+    node->gt = moved;
+
+    CIRCUITC_tree_update_height(moved);
+    CIRCUITC_tree_update_height(node);
+}
+
+// mirror image of CIRCUITC_tree_rotate_gt
+void CIRCUITC_tree_rotate_lt(CIRCUITC_tree_t* node){
+    CIRCUITC_tree_t* moved = node->gt;
+    CIRCUITC_tree_swap_contents(node, moved);
+
+    node->gt = moved->gt;
+    moved->gt = moved->lt;
+    moved->lt = node->lt;
+    node->lt = moved;
+
+    CIRCUITC_tree_update_height(moved);
+    CIRCUITC_tree_update_height(node);
+}
+
+// restores the AVL property at node, given that it holds for both its subtrees and that their heights differ by at most 2
+void CIRCUITC_tree_rebalance(CIRCUITC_tree_t* node){
+    const int balance = CIRCUITC_tree_height(node->lt) - CIRCUITC_tree_height(node->gt);
+
+    if(balance > 1){
+        if(CIRCUITC_tree_height(node->lt->lt) < CIRCUITC_tree_height(node->lt->gt)) CIRCUITC_tree_rotate_lt(node->lt);
+        CIRCUITC_tree_rotate_gt(node);
+    }
+    else if(balance < -1){
+        if(CIRCUITC_tree_height(node->gt->gt) < CIRCUITC_tree_height(node->gt->lt)) CIRCUITC_tree_rotate_gt(node->gt);
+        CIRCUITC_tree_rotate_lt(node);
+    }
+    else CIRCUITC_tree_update_height(node);
 }
 
 CIRCUITC_value_t CIRCUITC_tree_search(CIRCUITC_tree_t* tree, char* key, const size_t keylen, CIRCUITC_tree_error_code_t* error_code){
     int result;
-    while((result = strncmp(key, tree->key, keylen))){ 
+    while((result = strncmp(key, tree->key, keylen))){
         if(result < 0 && tree->lt) tree = tree->lt;
         else if(result > 0 && tree->gt) tree = tree->gt;
         else{
@@ -59,12 +140,38 @@ CIRCUITC_value_t CIRCUITC_tree_search(CIRCUITC_tree_t* tree, char* key, const si
     return tree->value;
 }
 
+// puts key in tree if it isn't already there, and sets its value; returns whether key was put in
+int CIRCUITC_tree_insert(CIRCUITC_tree_t* tree, char* key, CIRCUITC_value_t value){
+    CIRCUITC_tree_t* path[CIRCUITC_TREE_MAX_HEIGHT];
+    size_t depth = 0;
+
+    int result;
+    while((result = strcmp(key, tree->key))){
+        path[depth++] = tree;
+
+        if(result < 0 && tree->lt) tree = tree->lt;
+        else if(result > 0 && tree->gt) tree = tree->gt;
+        else{
+            if(result < 0) tree->lt = CIRCUITC_tree_node_make_from(tree->arena, key, value);
+            else tree->gt = CIRCUITC_tree_node_make_from(tree->arena, key, value);
+
+            while(depth) CIRCUITC_tree_rebalance(path[--depth]);
+            return 1;
+        }
+    }
+
+    tree->value = value;
+    return 0;
+}
+
 // returns tree node that holds key if said key is present within tree, otherwise the tree node that would have held key newly allocated (if alloc_new_node is set), or NULL otherwise.
 // if alloc_new_node is set, it never returns NULL.
-// father ~ holds father to said node, AKA node that points to said node. if said node is root, father will be NULL. 
+// father ~ holds father to said node, AKA node that points to said node. if said node is root, father will be NULL.
 // father may not be passed, I.E. NULL may be passed in its place if one does not care for it.
 // father_path ~ whether node is lt (-1) or gt (1) field of father. must be present if father is present, undefined value if node to search is root.
 CIRCUITC_tree_t* CIRCUITC_tree_search_for_node(CIRCUITC_tree_t* tree, char* key, CIRCUITC_tree_t** father, int* father_path, int alloc_new_node){
+    CIRCUITC_tree_t* const root = tree;
+
     if(father) *father = NULL;
 
     int result;
@@ -75,8 +182,9 @@ CIRCUITC_tree_t* CIRCUITC_tree_search_for_node(CIRCUITC_tree_t* tree, char* key,
         else if(result > 0 && tree->gt) tree = tree->gt;
         else if(!alloc_new_node) return NULL;
         else{
-            if(result < 0){ tree->lt = CIRCUITC_tree_node_make(key, 0); return tree->lt; }
-            else{ tree->gt = CIRCUITC_tree_node_make(key, 0); return tree->gt; }
+// rebalancing may move key to another node, so it's looked up again once it's in
+            CIRCUITC_tree_insert(root, key, 0);
+            return CIRCUITC_tree_search_for_node(root, key, father, father_path, 0);
         }
     }
     return tree;
@@ -86,48 +194,68 @@ CIRCUITC_tree_t* CIRCUITC_tree_search_for_node(CIRCUITC_tree_t* tree, char* key,
 CIRCUITC_tree_t* CIRCUITC_tree_search_largest(CIRCUITC_tree_t* tree, CIRCUITC_tree_t** father){
     if(father) *father = NULL;
     while(tree->gt){
-        if(father) *father = tree; 
+        if(father) *father = tree;
         tree = tree->gt;
-    } 
+    }
     return tree;
 }
 
-void CIRCUITC_tree_put(CIRCUITC_tree_t** tree, char* key, CIRCUITC_value_t value){
+// puts key in tree, making its root out of arena (or through malloc if arena is NULL) if tree is empty
+void CIRCUITC_tree_put_from(CIRCUITC_arena_t* arena, CIRCUITC_tree_t** tree, char* key, CIRCUITC_value_t value){
     if(!*tree){
-        *tree = CIRCUITC_tree_node_make(key, value);
+        *tree = CIRCUITC_tree_node_make_from(arena, key, value);
         return;
     }
-    
-    CIRCUITC_tree_t* new_node = CIRCUITC_tree_search_for_node(*tree, key, NULL, NULL, 1);
-    new_node->value = value;
+
+    CIRCUITC_tree_insert(*tree, key, value);
+}
+
+void CIRCUITC_tree_put(CIRCUITC_tree_t** tree, char* key, CIRCUITC_value_t value){
+    CIRCUITC_tree_put_from(NULL, tree, key, value);
 }
 
 // replaces replaced with replacer; basically moves everything from replacer to replaced, and frees replacer & replaced's key (if freekey is set)
 void CIRCUITC_tree_node_replace(CIRCUITC_tree_t* replaced, CIRCUITC_tree_t* replacer, CIRCUITC_tree_options_t freekey){
     replaced->value = replacer->value;
-    
+
     char* replaced_original_key = replaced->key;
     replaced->key = replacer->key;
     replacer->key = replaced_original_key;
 
     replaced->lt = replacer->lt;
     replaced->gt = replacer->gt;
+    replaced->height = replacer->height;
 
     CIRCUITC_tree_node_destroy(replacer, freekey);
 }
 
 // instead of deleting root, does nothing.
 void CIRCUITC_tree_del(CIRCUITC_tree_t* tree, char* key, CIRCUITC_tree_options_t freekey){
-    int father_path;
-    CIRCUITC_tree_t *father, *node_to_delete = CIRCUITC_tree_search_for_node(tree, key, &father, &father_path, 0);
+    CIRCUITC_tree_t* path[CIRCUITC_TREE_MAX_HEIGHT];                    // nodes whose subtree changes, and thus may have to be rebalanced
+    size_t depth = 0;
+
+    CIRCUITC_tree_t* node_to_delete = tree;
+    int result;
+    while(node_to_delete && (result = strcmp(key, node_to_delete->key))){
+        path[depth++] = node_to_delete;
+        node_to_delete = result < 0? node_to_delete->lt: node_to_delete->gt;
+    }
     if(!node_to_delete) return;             // node does not exist
 
-    if(node_to_delete->lt && node_to_delete->gt){           // replace node_to_delete with largest node in lt 
-        CIRCUITC_tree_t *father_replacing_node, *replacing_node = CIRCUITC_tree_search_largest(node_to_delete->lt, &father_replacing_node);
+    if(node_to_delete->lt && node_to_delete->gt){           // replace node_to_delete with largest node in lt
+        path[depth++] = node_to_delete;
 
-        father_replacing_node->gt = replacing_node->lt;
-        replacing_node->lt = NULL;
-        CIRCUITC_tree_node_replace(node_to_delete, replacing_node, freekey);
+        CIRCUITC_tree_t* replacing_node = node_to_delete->lt;
+        while(replacing_node->gt){
+            path[depth++] = replacing_node;
+            replacing_node = replacing_node->gt;
+        }
+
+        if(path[depth - 1] == node_to_delete) node_to_delete->lt = replacing_node->lt;
+        else path[depth - 1]->gt = replacing_node->lt;
+
+        CIRCUITC_tree_swap_contents(node_to_delete, replacing_node);
+        CIRCUITC_tree_node_destroy(replacing_node, freekey);
     }
     else if(node_to_delete->lt || node_to_delete->gt){      // replace node_to_delete with one of the two child nodes
         CIRCUITC_tree_t* replacing_node;
@@ -135,13 +263,51 @@ void CIRCUITC_tree_del(CIRCUITC_tree_t* tree, char* key, CIRCUITC_tree_options_t
         else replacing_node = node_to_delete->gt;
 
         CIRCUITC_tree_node_replace(node_to_delete, replacing_node, freekey);
-    }  
-    else if(father){                                        // deletes node_to_delete only if it isn't root, by setting its reference in father to NULL
-        if(father_path > 0) father->gt = NULL;
+    }
+    else if(depth){                                         // deletes node_to_delete only if it isn't root, by setting its reference in father to NULL
+        CIRCUITC_tree_t* father = path[depth - 1];
+        if(father->gt == node_to_delete) father->gt = NULL;
         else father->lt = NULL;
 
         CIRCUITC_tree_node_destroy(node_to_delete, freekey);
     }
+
+    while(depth) CIRCUITC_tree_rebalance(path[--depth]);
+}
+
+// in-order iteration: nodes come out sorted by key. the tree must not be changed while it's iterated over.
+typedef struct{
+    CIRCUITC_tree_t* stack[CIRCUITC_TREE_MAX_HEIGHT];                   // nodes whose key hasn't come out yet, but whose lt subtree is being gone through
+    size_t depth;
+} CIRCUITC_tree_iterator_t;
+
+typedef enum{ CIRCUITC_tree_iterator_keep_ctx, CIRCUITC_tree_iterator_free_ctx } CIRCUITC_tree_iterator_options_t;
+
+void CIRCUITC_tree_iterator_push(CIRCUITC_tree_iterator_t* iterator, CIRCUITC_tree_t* tree){
+    for(; tree; tree = tree->lt) iterator->stack[iterator->depth++] = tree;
+}
+
+CIRCUITC_tree_iterator_t* CIRCUITC_tree_iterator_init(CIRCUITC_tree_iterator_t* iterator, CIRCUITC_tree_t* tree){
+    if(!iterator) iterator = malloc(sizeof(*iterator));
+
+    iterator->depth = 0;
+    CIRCUITC_tree_iterator_push(iterator, tree);
+
+    return iterator;
+}
+
+void CIRCUITC_tree_iterator_destroy(CIRCUITC_tree_iterator_t* iterator, CIRCUITC_tree_iterator_options_t freectx){
+    if(freectx == CIRCUITC_tree_iterator_free_ctx) free(iterator);
+}
+
+// returns node holding next key, or NULL once all nodes have been returned
+CIRCUITC_tree_t* CIRCUITC_tree_iterator_next(CIRCUITC_tree_iterator_t* iterator){
+    if(!iterator->depth) return NULL;
+
+    CIRCUITC_tree_t* node = iterator->stack[--iterator->depth];
+    CIRCUITC_tree_iterator_push(iterator, node->gt);
+
+    return node;
 }
 
 #endif
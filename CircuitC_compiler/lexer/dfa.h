@@ -0,0 +1,199 @@
+#ifndef CIRCUITC_dfa_included
+#define CIRCUITC_dfa_included
+
+#include "stdbool.h"            // boolean type
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "string.h"             // strlen, memset
+#include "tokens.h"             // token definitions the automaton is built from
+#include "keyword_table.h"      // keywords that are left to the keyword table
+
+// transition-table tokeniser.
+// the definitions in tokens.h (keywords, comment openers, whitespaces) are compiled once into a trie-shaped DFA, to which the two
+// regexes the tokeniser knows about ([a-zA-Z][a-zA-Z0-9]* for names and [0-9][a-zA-Z0-9]* for values) are then merged.
+// classifying the next symbol of the input is thus a single walk over its bytes, one table lookup per byte, taking the longest match.
+// once built, bytes that no state tells apart are merged into classes so that the table the lexer walks stays small enough for L1.
+// keywords that look like names are left out, and read as names; the tokeniser tells them apart through the keyword table.
+
+typedef uint16_t CIRCUITC_dfa_state_t;
+// what a state accepts: the high byte holds the kind of symbol, the low byte the token it is turned into
+typedef uint16_t CIRCUITC_dfa_accept_t;
+
+#define CIRCUITC_DFA_STATE_DEAD                     0x00U               // state 0 has no way out; entering it halts the automaton
+#define CIRCUITC_DFA_STATE_START                    0x01U
+
+#define CIRCUITC_DFA_ACCEPT_NONE                    0x0000U
+#define CIRCUITC_DFA_ACCEPT_KEYWORD                 0x0100U
+#define CIRCUITC_DFA_ACCEPT_COMMENT                 0x0200U             // token holds index of closing symbol in CIRCUITC_comments_end
+#define CIRCUITC_DFA_ACCEPT_WHITESPACE              0x0300U
+#define CIRCUITC_DFA_ACCEPT_NAME                    0x0400U
+#define CIRCUITC_DFA_ACCEPT_VALUE                   0x0500U
+// set on states that loop over [a-zA-Z0-9] with nothing left to decide; the automaton stops there and lets the caller scan the rest of the run
+#define CIRCUITC_DFA_ACCEPT_RUN                     0x8000U
+
+#define CIRCUITC_DFA_ACCEPT_KIND(accept)            ((accept)&0x7F00U)
+#define CIRCUITC_DFA_ACCEPT_TOKEN(accept)           ((CIRCUITC_token_t)((accept)&0x00FFU))
+
+#define CIRCUITC_DFA_ALPHABET_SIZE                  256
+
+typedef struct{
+    CIRCUITC_dfa_state_t (*transitions)[CIRCUITC_DFA_ALPHABET_SIZE];   // transitions[state][byte] ~ next state, only used while building
+    CIRCUITC_dfa_accept_t* accept;                                      // accept[state] ~ what reaching said state accepts
+    size_t states;
+    size_t capacity;
+
+    uint8_t classes[CIRCUITC_DFA_ALPHABET_SIZE];                        // classes[byte] ~ equivalence class of byte
+    size_t number_of_classes;
+    CIRCUITC_dfa_state_t* table;                                        // table[state*number_of_classes + class] ~ next state
+} CIRCUITC_dfa_t;
+
+typedef enum{ CIRCUITC_dfa_keep_ctx, CIRCUITC_dfa_free_ctx } CIRCUITC_dfa_options_t;
+
+CIRCUITC_dfa_state_t CIRCUITC_dfa_state_make(CIRCUITC_dfa_t* dfa, const CIRCUITC_dfa_accept_t accept){
+    if(dfa->states == dfa->capacity){
+        dfa->capacity = dfa->capacity*3/2 + 1;
+        dfa->transitions = realloc(dfa->transitions, dfa->capacity*sizeof(*dfa->transitions));
+        dfa->accept = realloc(dfa->accept, dfa->capacity*sizeof(*dfa->accept));
+    }
+
+    memset(dfa->transitions[dfa->states], 0, sizeof(*dfa->transitions));
+    dfa->accept[dfa->states] = accept;
+
+    return dfa->states++;
+}
+
+// adds symbol to the trie; symbols hold at least one byte, so that "\x00" (EOF) is a valid symbol.
+void CIRCUITC_dfa_put(CIRCUITC_dfa_t* dfa, const char* symbol, const CIRCUITC_dfa_accept_t accept){
+    const uint8_t* bytes = (const uint8_t*)symbol;
+    size_t length = strlen(symbol);
+    if(!length) length = 1;
+
+    CIRCUITC_dfa_state_t state = CIRCUITC_DFA_STATE_START;
+    for(size_t i = 0; i < length; i++){
+        if(dfa->transitions[state][bytes[i]] == CIRCUITC_DFA_STATE_DEAD){
+// done in two steps as CIRCUITC_dfa_state_make may move the transition table
+            const CIRCUITC_dfa_state_t new_state = CIRCUITC_dfa_state_make(dfa, CIRCUITC_DFA_ACCEPT_NONE);
+            dfa->transitions[state][bytes[i]] = new_state;
+        }
+        state = dfa->transitions[state][bytes[i]];
+    }
+
+    dfa->accept[state] = accept;
+}
+
+void CIRCUITC_dfa_put_definitions(CIRCUITC_dfa_t* dfa, const CIRCUITC_token_definition_t* definition, const uint64_t definition_size, const CIRCUITC_dfa_accept_t kind){
+    for(uint64_t i = 0; i < definition_size; i++){
+        if(kind == CIRCUITC_DFA_ACCEPT_KEYWORD && CIRCUITC_keyword_table_is_name(definition[i].symbol)) continue;
+        CIRCUITC_dfa_put(dfa, definition[i].symbol, kind | definition[i].value);
+    }
+}
+
+bool CIRCUITC_dfa_is_alphanumeric(const uint8_t character){
+    return ('0' <= character && character <= '9') || ('A' <= (character &~0x20) && (character &~0x20) <= 'Z');
+}
+
+// merges the regex [a-zA-Z0-9]* into the subtrie rooted at state: every alphanumeric byte the trie has no transition for leads to loop_state,
+// and every state reached through alphanumeric bytes that doesn't accept a keyword accepts what loop_state accepts.
+void CIRCUITC_dfa_merge_regex(CIRCUITC_dfa_t* dfa, const CIRCUITC_dfa_state_t state, const CIRCUITC_dfa_state_t loop_state){
+    if(dfa->accept[state] == CIRCUITC_DFA_ACCEPT_NONE) dfa->accept[state] = dfa->accept[loop_state] &~CIRCUITC_DFA_ACCEPT_RUN;
+
+    for(uint16_t character = 0; character < CIRCUITC_DFA_ALPHABET_SIZE; character++){
+        if(!CIRCUITC_dfa_is_alphanumeric(character)) continue;
+
+        const CIRCUITC_dfa_state_t next_state = dfa->transitions[state][character];
+        if(next_state == CIRCUITC_DFA_STATE_DEAD) dfa->transitions[state][character] = loop_state;
+        else if(next_state != loop_state) CIRCUITC_dfa_merge_regex(dfa, next_state, loop_state);
+    }
+}
+
+// groups bytes whose column in the transition table is the same across all states into one class, then builds the compact table out of the classes
+void CIRCUITC_dfa_compress(CIRCUITC_dfa_t* dfa){
+    int16_t representative[CIRCUITC_DFA_ALPHABET_SIZE];                // byte that first had the column of each class
+    dfa->number_of_classes = 0;
+
+    for(uint16_t character = 0; character < CIRCUITC_DFA_ALPHABET_SIZE; character++){
+        size_t class = 0;
+        for(; class < dfa->number_of_classes; class++){
+            size_t state = 0;
+            while(state < dfa->states && dfa->transitions[state][character] == dfa->transitions[state][representative[class]]) state++;
+            if(state == dfa->states) break;
+        }
+
+        if(class == dfa->number_of_classes) representative[dfa->number_of_classes++] = character;
+        dfa->classes[character] = class;
+    }
+
+    dfa->table = malloc(dfa->states*dfa->number_of_classes*sizeof(*dfa->table));
+    for(size_t state = 0; state < dfa->states; state++)
+        for(size_t class = 0; class < dfa->number_of_classes; class++)
+            dfa->table[state*dfa->number_of_classes + class] = dfa->transitions[state][representative[class]];
+// the byte-indexed table is no longer needed
+    free(dfa->transitions);
+    dfa->transitions = NULL;
+}
+
+// builds automaton that recognises every symbol in tokens.h, names and values
+CIRCUITC_dfa_t* CIRCUITC_dfa_init(CIRCUITC_dfa_t* dfa){
+    if(!dfa) dfa = malloc(sizeof(*dfa));
+
+    dfa->transitions = NULL;
+    dfa->accept = NULL;
+    dfa->states = 0;
+    dfa->capacity = 0;
+    dfa->table = NULL;
+
+    CIRCUITC_dfa_state_make(dfa, CIRCUITC_DFA_ACCEPT_NONE);            // dead state
+    CIRCUITC_dfa_state_make(dfa, CIRCUITC_DFA_ACCEPT_NONE);            // start state
+
+    CIRCUITC_dfa_put_definitions(dfa, CIRCUITC_keywords,       sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords),             CIRCUITC_DFA_ACCEPT_KEYWORD);
+    CIRCUITC_dfa_put_definitions(dfa, CIRCUITC_comments_begin, sizeof(CIRCUITC_comments_begin)/sizeof(*CIRCUITC_comments_begin), CIRCUITC_DFA_ACCEPT_COMMENT);
+    CIRCUITC_dfa_put_definitions(dfa, CIRCUITC_whitespaces,    sizeof(CIRCUITC_whitespaces)/sizeof(*CIRCUITC_whitespaces),       CIRCUITC_DFA_ACCEPT_WHITESPACE);
+// states that loop over the remainder of a name or a value once no keyword can match anymore
+    const CIRCUITC_dfa_state_t name_state  = CIRCUITC_dfa_state_make(dfa, CIRCUITC_DFA_ACCEPT_RUN | CIRCUITC_DFA_ACCEPT_NAME  | CIRCUITC_TOKEN_NAME);
+    const CIRCUITC_dfa_state_t value_state = CIRCUITC_dfa_state_make(dfa, CIRCUITC_DFA_ACCEPT_RUN | CIRCUITC_DFA_ACCEPT_VALUE | CIRCUITC_TOKEN_VALUE);
+    CIRCUITC_dfa_merge_regex(dfa, name_state,  name_state);
+    CIRCUITC_dfa_merge_regex(dfa, value_state, value_state);
+
+    for(uint16_t character = 0; character < CIRCUITC_DFA_ALPHABET_SIZE; character++){
+        if(!CIRCUITC_dfa_is_alphanumeric(character)) continue;
+
+        const CIRCUITC_dfa_state_t loop_state = '0' <= character && character <= '9'? value_state: name_state;
+        const CIRCUITC_dfa_state_t next_state = dfa->transitions[CIRCUITC_DFA_STATE_START][character];
+        if(next_state == CIRCUITC_DFA_STATE_DEAD) dfa->transitions[CIRCUITC_DFA_STATE_START][character] = loop_state;
+        else CIRCUITC_dfa_merge_regex(dfa, next_state, loop_state);
+    }
+
+    CIRCUITC_dfa_compress(dfa);
+    return dfa;
+}
+
+void CIRCUITC_dfa_destroy(CIRCUITC_dfa_t* dfa, CIRCUITC_dfa_options_t freectx){
+    free(dfa->transitions);
+    free(dfa->accept);
+    free(dfa->table);
+
+    if(freectx == CIRCUITC_dfa_free_ctx) free(dfa);
+}
+
+// runs automaton on string until it dies, returns what the longest accepted prefix of string accepts and stores its length in 'length'.
+// returns CIRCUITC_DFA_ACCEPT_NONE (and sets length to 0) if no prefix is accepted. never reads past the \x00 that terminates string.
+// if the returned value has CIRCUITC_DFA_ACCEPT_RUN set, the automaton stopped on entering a run, which goes on for as long as the input is alphanumeric.
+CIRCUITC_dfa_accept_t CIRCUITC_dfa_run(const CIRCUITC_dfa_t* dfa, const char* string, size_t* length){
+    const uint8_t* input = (const uint8_t*)string;
+    CIRCUITC_dfa_state_t state = CIRCUITC_DFA_STATE_START;
+    CIRCUITC_dfa_accept_t accept = CIRCUITC_DFA_ACCEPT_NONE;
+
+    *length = 0;
+    for(size_t i = 0; (state = dfa->table[state*dfa->number_of_classes + dfa->classes[input[i]]]) != CIRCUITC_DFA_STATE_DEAD;){
+        if(dfa->accept[state] != CIRCUITC_DFA_ACCEPT_NONE){
+            accept = dfa->accept[state];
+            *length = i + 1;
+            if(accept & CIRCUITC_DFA_ACCEPT_RUN) break;
+        }
+        if(!input[i++]) break;
+    }
+
+    return accept;
+}
+
+#endif
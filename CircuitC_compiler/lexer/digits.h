@@ -0,0 +1,165 @@
+#ifndef CIRCUITC_digits_included
+#define CIRCUITC_digits_included
+
+#include "stdbool.h"            // boolean type
+#include "stdint.h"             // types
+#include "string.h"             // memcpy
+#include "NOAHZK_bigint_lib/ops/definitions.h"     // limb type
+#include "scan.h"               // byte range checks
+
+// kernels that decode a run of hexadecimal or binary digits, most significant first, into the limbs of the value they spell,
+// least significant first (the layout of the arr of a NOAHZK_variable_width_t); the limbs are written as bytes, so dst needn't be aligned.
+// digits are taken from the end of the run, so that a limb is always made of whole digits: every limb but the most significant one is full,
+// and the most significant one only has what's left over at the start of the run.
+// every kernel has a scalar version and, on x86, SSSE3 and AVX2 versions working on blocks of 16 or 32 digits, which only ever load digits of the run.
+// a run is checked as it's decoded: the kernels return false if it has anything but digits of its base in it, dst then holding garbage.
+
+#define CIRCUITC_DIGITS_HEX_IN_LIMB                 (BITS_IN_NOAHZK_LIMB/4)
+#define CIRCUITC_DIGITS_BINARY_IN_LIMB              BITS_IN_NOAHZK_LIMB
+#define CIRCUITC_DIGITS_HEX_WIDTH(length)           NOAHZK_SIZE_AS_ARR_OF_TYPE(length, CIRCUITC_DIGITS_HEX_IN_LIMB)        // limbs a run of length hex digits is decoded into
+#define CIRCUITC_DIGITS_BINARY_WIDTH(length)        NOAHZK_SIZE_AS_ARR_OF_TYPE(length, CIRCUITC_DIGITS_BINARY_IN_LIMB)     // limbs a run of length binary digits is decoded into
+
+// value of hex digit character, or something greater than 15 if it's not one
+uint8_t CIRCUITC_digits_hex_value(const char character){
+    const uint8_t digit = (uint8_t)(character - '0'), letter = (uint8_t)((character | 0x20) - 'a');
+    return digit <= 9? digit: letter <= 5? letter + 10: 0xff;
+}
+
+// decodes the length hex digits at string into dst, CIRCUITC_DIGITS_HEX_WIDTH(length) limbs wide
+bool CIRCUITC_digits_hex_scalar(void* dst, const char* string, const size_t length){
+    uint8_t invalid = 0;
+
+    for(size_t end = length, i = 0; end > 0; end -= NOAHZK_MIN(end, CIRCUITC_DIGITS_HEX_IN_LIMB), i++){
+        NOAHZK_limb_t limb = 0;
+        for(size_t j = end - NOAHZK_MIN(end, CIRCUITC_DIGITS_HEX_IN_LIMB); j < end; j++){
+            const uint8_t digit = CIRCUITC_digits_hex_value(string[j]);
+            invalid |= digit >> 4;
+            limb = limb << 4 | (digit & 0xf);
+        }
+        memcpy((uint8_t*)dst + i*sizeof(limb), &limb, sizeof(limb));
+    }
+
+    return !invalid;
+}
+
+// decodes the length binary digits at string into dst, CIRCUITC_DIGITS_BINARY_WIDTH(length) limbs wide
+bool CIRCUITC_digits_binary_scalar(void* dst, const char* string, const size_t length){
+    uint8_t invalid = 0;
+
+    for(size_t end = length, i = 0; end > 0; end -= NOAHZK_MIN(end, CIRCUITC_DIGITS_BINARY_IN_LIMB), i++){
+        NOAHZK_limb_t limb = 0;
+        for(size_t j = end - NOAHZK_MIN(end, CIRCUITC_DIGITS_BINARY_IN_LIMB); j < end; j++){
+            const uint8_t digit = (uint8_t)(string[j] - '0');
+            invalid |= digit >> 1;
+            limb = limb << 1 | (digit & 1);
+        }
+        memcpy((uint8_t*)dst + i*sizeof(limb), &limb, sizeof(limb));
+    }
+
+    return !invalid;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CIRCUITC_DIGITS_X86
+
+// the vector kernels decode the whole blocks at the end of the run into the limbs at the start of dst, and return how many digits are left
+// at the start of the run for the scalar kernels to decode. *invalid has a bit set for every character of the blocks that isn't a digit
+
+// 16 hex characters into the nibbles they stand for, bytes that aren't hex digits getting their bit in *invalid set
+__attribute__((target("ssse3"))) __m128i CIRCUITC_digits_hex_nibbles_ssse3(const __m128i block, uint32_t* invalid){
+    const __m128i lowercase = _mm_or_si128(block, _mm_set1_epi8(0x20));
+    const __m128i digit = CIRCUITC_scan_in_range_sse2(block, '0', '9'), letter = CIRCUITC_scan_in_range_sse2(lowercase, 'a', 'f');
+
+    *invalid |= ~(uint32_t)_mm_movemask_epi8(_mm_or_si128(digit, letter)) & 0xffff;
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(block, _mm_set1_epi8('0'))), _mm_and_si128(letter, _mm_sub_epi8(lowercase, _mm_set1_epi8('a' - 10))));
+}
+
+// every 16 digits make 8 bytes: pairs of nibbles are put together by a multiply-add (the first of each pair, the more significant one,
+// times 16), and the low bytes of the pairs taken in reverse, as the last pair is the least significant
+__attribute__((target("ssse3"))) size_t CIRCUITC_digits_hex_ssse3(void* dst, const char* string, size_t length, uint32_t* invalid){
+    const __m128i reverse = _mm_setr_epi8(14, 12, 10, 8, 6, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    for(uint8_t* out = dst; length >= 16; length -= 16, out += 8){
+        const __m128i nibbles = CIRCUITC_digits_hex_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(string + length - 16)), invalid);
+        _mm_storel_epi64((__m128i*)out, _mm_shuffle_epi8(_mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110)), reverse));
+    }
+
+    return length;
+}
+
+// the nibbles' bytes are reversed, so that the first of the 16 digits lands in the top bit of the movemask; 32 digits are two of those
+__attribute__((target("ssse3"))) size_t CIRCUITC_digits_binary_ssse3(void* dst, const char* string, size_t length, uint32_t* invalid){
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+    for(uint8_t* out = dst; length >= 32; length -= 32, out += 4){
+        const __m128i high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(string + length - 32)), reverse);
+        const __m128i low  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(string + length - 16)), reverse);
+        *invalid |= ~((uint32_t)_mm_movemask_epi8(CIRCUITC_scan_in_range_sse2(high, '0', '1')) << 16 | (uint32_t)_mm_movemask_epi8(CIRCUITC_scan_in_range_sse2(low, '0', '1')));
+// '1' is 0x31, so shifting it left by 7 puts its low bit in the sign bit of the byte; '0' leaves it clear
+        const uint32_t limb = (uint32_t)_mm_movemask_epi8(_mm_slli_epi16(high, 7)) << 16 | (uint32_t)_mm_movemask_epi8(_mm_slli_epi16(low, 7));
+        memcpy(out, &limb, sizeof(limb));
+    }
+
+    return length;
+}
+
+// same as the SSSE3 versions, but with 32 digits a block: each lane of 16 hex digits makes 8 bytes, the lane holding the less significant digits
+// going first; 32 binary digits make a limb in one go, the bytes being reversed within lanes and the lanes swapped
+__attribute__((target("avx2"))) size_t CIRCUITC_digits_hex_avx2(void* dst, const char* string, size_t length, uint32_t* invalid){
+    const __m256i reverse = _mm256_setr_epi8(14, 12, 10, 8, 6, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1, 14, 12, 10, 8, 6, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    for(uint8_t* out = dst; length >= 32; length -= 32, out += 16){
+        const __m256i block = _mm256_loadu_si256((const __m256i*)(string + length - 32));
+        const __m256i lowercase = _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+        const __m256i digit = CIRCUITC_scan_in_range_avx2(block, '0', '9'), letter = CIRCUITC_scan_in_range_avx2(lowercase, 'a', 'f');
+        *invalid |= ~(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(digit, letter));
+
+        const __m256i nibbles = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(block, _mm256_set1_epi8('0'))), _mm256_and_si256(letter, _mm256_sub_epi8(lowercase, _mm256_set1_epi8('a' - 10))));
+        const __m256i bytes = _mm256_shuffle_epi8(_mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110)), reverse);
+        _mm_storeu_si128((__m128i*)out, _mm256_castsi256_si128(_mm256_permute4x64_epi64(bytes, 2)));
+    }
+
+    return length;
+}
+
+__attribute__((target("avx2"))) size_t CIRCUITC_digits_binary_avx2(void* dst, const char* string, size_t length, uint32_t* invalid){
+    const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+    for(uint8_t* out = dst; length >= 32; length -= 32, out += 4){
+        const __m256i block = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(string + length - 32)), reverse), 0x4e);
+        *invalid |= ~(uint32_t)_mm256_movemask_epi8(CIRCUITC_scan_in_range_avx2(block, '0', '1'));
+
+        const uint32_t limb = (uint32_t)_mm256_movemask_epi8(_mm256_slli_epi16(block, 7));
+        memcpy(out, &limb, sizeof(limb));
+    }
+
+    return length;
+}
+#endif
+
+// decodes the length hex digits at string into dst, CIRCUITC_DIGITS_HEX_WIDTH(length) limbs wide, through the fastest kernel the CPU supports
+bool CIRCUITC_digits_hex(void* dst, const char* string, const size_t length){
+    uint32_t invalid = 0;
+    size_t left = length;
+
+#ifdef CIRCUITC_DIGITS_X86
+    if(length >= 32 && __builtin_cpu_supports("avx2")) left = CIRCUITC_digits_hex_avx2(dst, string, length, &invalid);
+    else if(length >= 16 && __builtin_cpu_supports("ssse3")) left = CIRCUITC_digits_hex_ssse3(dst, string, length, &invalid);
+#endif
+// the blocks decoded are a whole number of limbs
+    return CIRCUITC_digits_hex_scalar((uint8_t*)dst + (length - left)/CIRCUITC_DIGITS_HEX_IN_LIMB*sizeof(NOAHZK_limb_t), string, left) && !invalid;
+}
+
+// decodes the length binary digits at string into dst, CIRCUITC_DIGITS_BINARY_WIDTH(length) limbs wide, through the fastest kernel the CPU supports
+bool CIRCUITC_digits_binary(void* dst, const char* string, const size_t length){
+    uint32_t invalid = 0;
+    size_t left = length;
+
+#ifdef CIRCUITC_DIGITS_X86
+    if(length >= 32 && __builtin_cpu_supports("avx2")) left = CIRCUITC_digits_binary_avx2(dst, string, length, &invalid);
+    else if(length >= 32 && __builtin_cpu_supports("ssse3")) left = CIRCUITC_digits_binary_ssse3(dst, string, length, &invalid);
+#endif
+    return CIRCUITC_digits_binary_scalar((uint8_t*)dst + (length - left)/CIRCUITC_DIGITS_BINARY_IN_LIMB*sizeof(NOAHZK_limb_t), string, left) && !invalid;
+}
+
+#endif
@@ -1,38 +1,49 @@
-#ifndef CIRUCITC_dynamic_arrays_included
+#ifndef CIRCUITC_dynamic_arrays_included
 #define CIRCUITC_dynamic_arrays_included
 
 #include "stdlib.h"             // dynamic memory operations
 #include "stdint.h"             // types
-#include "string.h"             // memcpy
+#include "string.h"             // memcpy, memset
+#include "arena.h"              // arena-backed arrays
 
 // dynamic array library so that we don't have to handle that stuff ourselves
+// arrays either own their memory, or take it from an arena (through CIRCUITC_array_init_from), in which case it goes away along with said arena
 
 typedef struct{
     char* arr;
     size_t size;                // bytes used
     size_t capacity;            // bytes allocated
+    CIRCUITC_arena_t* arena;    // arena arr is taken from, or NULL if it's malloc'd
 } CIRCUITC_array_t;
 
 typedef enum{ CIRCUITC_array_keep_ctx, CIRCUITC_array_free_ctx } CIRCUITC_array_options_t;
 
-CIRCUITC_array_t* CIRCUITC_array_init(CIRCUITC_array_t* array){
+// makes array out of arena, or through malloc if arena is NULL. the array struct itself is always malloc'd if NULL is passed
+CIRCUITC_array_t* CIRCUITC_array_init_from(CIRCUITC_array_t* array, CIRCUITC_arena_t* arena){
     const size_t initial_capacity = 256;
     
     if(!array) array = malloc(sizeof(*array));
 
     array->size = 0;
     array->capacity = initial_capacity;
-    array->arr = calloc(1, array->capacity);
+    array->arena = arena;
+    if(arena) array->arr = memset(CIRCUITC_arena_alloc(arena, array->capacity), 0, array->capacity);
+    else array->arr = calloc(1, array->capacity);
 
     return array;
 }
 
+CIRCUITC_array_t* CIRCUITC_array_init(CIRCUITC_array_t* array){
+    return CIRCUITC_array_init_from(array, NULL);
+}
+
 void CIRCUITC_array_destroy(CIRCUITC_array_t* array, CIRCUITC_array_options_t freectx){
-    if(array->arr) free(array->arr);
+    if(array->arr && !array->arena) free(array->arr);
     if(freectx == CIRCUITC_array_free_ctx) free(array);
 }
 
 
+// the array returned belongs to the arena if array was made from one, and mustn't be freed then
 void* CIRCUITC_array_extract_array(CIRCUITC_array_t* array){
     char* arr = array->arr;
     array->arr = NULL;
@@ -41,11 +52,18 @@ void* CIRCUITC_array_extract_array(CIRCUITC_array_t* array){
 
 // growth factor of 1.5
 void CIRCUITC_array_expand(CIRCUITC_array_t* array, size_t new_size){
+    const size_t old_capacity = array->capacity;
     size_t new_capacity = array->capacity*3/2;                          // if one tries pushing something larger than what the new capacity would be on the array,
     if(new_size > new_capacity) new_capacity = new_size*3/2;            // we can either iteratively increase capacity until it is larger than what the new array size would be
     array->capacity = new_capacity;                                     // or we can set the new capacity to the new size times some constant. I chose the latter approach.
     
-    array->arr = realloc(array->arr, array->capacity);
+    if(array->arena) array->arr = CIRCUITC_arena_realloc(array->arena, array->arr, old_capacity, array->capacity);
+    else array->arr = realloc(array->arr, array->capacity);
+}
+
+// makes room for length_string more bytes, so that pushing them won't move arr
+void CIRCUITC_array_reserve(CIRCUITC_array_t* array, const size_t length_string){
+    if(array->size + length_string >= array->capacity) CIRCUITC_array_expand(array, array->size + length_string);
 }
 
 // pushes element to top of array
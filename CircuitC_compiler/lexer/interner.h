@@ -0,0 +1,147 @@
+#ifndef CIRCUITC_interner_included
+#define CIRCUITC_interner_included
+
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "string.h"             // memcpy, memcmp
+#include "dynamic_arrays.h"     // dynamic array type & operations
+#include "arena.h"              // strings and entries
+
+// string interner: hands out a 32-bit ID for every distinct string it's given, the same ID every time the same string comes back.
+// the strings themselves are copied once into the interner's arena, whose blocks never move, so the pointers handed out stay valid for as long as the interner lives;
+// the string, length and hash of every ID are kept in arrays taken from the same arena, so that it all goes away in a few calls to free.
+// IDs are looked up through an open-addressing hash table (linear probing, kept at most half full) holding ID + 1, 0 being an empty slot;
+// the hash of every string is kept alongside it so that growing the table doesn't rehash any string, and probes only compare strings whose hash matches.
+
+typedef uint32_t CIRCUITC_symbol_t;
+
+typedef struct{
+    CIRCUITC_arena_t arena;             // strings, and the arrays below
+
+    CIRCUITC_array_t strings;           // char* of every ID, \x00 terminated
+    CIRCUITC_array_t lengths;           // uint32_t length of every ID
+    CIRCUITC_array_t hashes;            // uint64_t hash of every ID
+    CIRCUITC_symbol_t size;             // IDs handed out
+
+    CIRCUITC_symbol_t* slots;           // ID + 1 of string hashing to slot, or 0; malloc'd, as the old table is given back every time it doubles
+    size_t capacity;                    // slots, a power of two
+} CIRCUITC_interner_t;
+
+typedef enum{ CIRCUITC_interner_keep_ctx, CIRCUITC_interner_free_ctx } CIRCUITC_interner_options_t;
+
+// hashes string; names are short, so what matters is how few loads and multiplications a short string takes, not how well they mix.
+// strings of up to 16 bytes are read as two words that may overlap (the first and last 8, 4 or 1 bytes), which along with the length tell them apart.
+uint64_t CIRCUITC_interner_hash(const char* string, const size_t length, const uint64_t seed){
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    uint64_t first = 0, last = 0, hash = seed ^ (length*multiplier);
+
+    if(length > 16){
+        size_t i = 0;
+        for(; i + sizeof(uint64_t) < length; i += sizeof(uint64_t)){
+            memcpy(&first, string + i, sizeof(first));
+            hash = (hash ^ first)*multiplier;
+            hash ^= hash >> 29;
+        }
+        memcpy(&first, string + length - sizeof(uint64_t), sizeof(first));
+    }
+    else if(length >= sizeof(uint64_t)){
+        memcpy(&first, string, sizeof(uint64_t));
+        memcpy(&last, string + length - sizeof(uint64_t), sizeof(uint64_t));
+    }
+    else if(length >= sizeof(uint32_t)){
+        uint32_t first_half, last_half;
+        memcpy(&first_half, string, sizeof(uint32_t));
+        memcpy(&last_half, string + length - sizeof(uint32_t), sizeof(uint32_t));
+        first = first_half;
+        last = last_half;
+    }
+    else if(length) first = (uint64_t)(uint8_t)string[0] << 16 | (uint64_t)(uint8_t)string[length/2] << 8 | (uint8_t)string[length - 1];
+
+    hash = (hash ^ first)*multiplier;
+    hash = (hash ^ last ^ hash >> 29)*multiplier;
+    return hash ^ hash >> 32;
+}
+
+CIRCUITC_interner_t* CIRCUITC_interner_init(CIRCUITC_interner_t* interner){
+    const size_t initial_capacity = 1024;
+
+    if(!interner) interner = malloc(sizeof(*interner));
+
+    CIRCUITC_arena_init(&interner->arena);
+    CIRCUITC_array_init_from(&interner->strings, &interner->arena);
+    CIRCUITC_array_init_from(&interner->lengths, &interner->arena);
+    CIRCUITC_array_init_from(&interner->hashes, &interner->arena);
+    interner->size = 0;
+
+    interner->capacity = initial_capacity;
+    interner->slots = calloc(interner->capacity, sizeof(*interner->slots));
+
+    return interner;
+}
+
+void CIRCUITC_interner_destroy(CIRCUITC_interner_t* interner, CIRCUITC_interner_options_t freectx){
+    CIRCUITC_arena_destroy(&interner->arena, CIRCUITC_arena_keep_ctx);
+    free(interner->slots);
+
+    if(freectx == CIRCUITC_interner_free_ctx) free(interner);
+}
+
+// copies string into the arena, \x00 terminated
+char* CIRCUITC_interner_copy(CIRCUITC_interner_t* interner, const char* string, const size_t length){
+    char* copy = CIRCUITC_arena_alloc(&interner->arena, length + 1);
+    memcpy(copy, string, length);
+    copy[length] = '\x00';
+
+    return copy;
+}
+
+// doubles the number of slots and puts every ID back in, from the hashes that were kept
+void CIRCUITC_interner_expand(CIRCUITC_interner_t* interner){
+    const uint64_t* hashes = (uint64_t*)interner->hashes.arr;
+
+    free(interner->slots);
+    interner->capacity *= 2;
+    interner->slots = calloc(interner->capacity, sizeof(*interner->slots));
+
+    for(CIRCUITC_symbol_t id = 0; id < interner->size; id++){
+        size_t slot = hashes[id] & (interner->capacity - 1);
+        while(interner->slots[slot]) slot = (slot + 1) & (interner->capacity - 1);
+        interner->slots[slot] = id + 1;
+    }
+}
+
+// returns ID of string, giving it a new one if it's never been seen before
+CIRCUITC_symbol_t CIRCUITC_interner_intern(CIRCUITC_interner_t* interner, const char* string, const size_t length){
+    const uint64_t hash = CIRCUITC_interner_hash(string, length, 0);
+    size_t slot = hash & (interner->capacity - 1);
+
+    for(CIRCUITC_symbol_t id; (id = interner->slots[slot]); slot = (slot + 1) & (interner->capacity - 1)){
+        id--;
+        if(((uint64_t*)interner->hashes.arr)[id] == hash && ((uint32_t*)interner->lengths.arr)[id] == length
+           && memcmp(((char**)interner->strings.arr)[id], string, length) == 0) return id;
+    }
+// new string; it goes in the empty slot the probe ended on, unless that would make the table more than half full
+    const CIRCUITC_symbol_t id = interner->size++;
+    const uint32_t length_id = length;
+    char* copy = CIRCUITC_interner_copy(interner, string, length);
+
+    CIRCUITC_array_push_string(&interner->strings, &copy, sizeof(copy));
+    CIRCUITC_array_push_string(&interner->lengths, (void*)&length_id, sizeof(length_id));
+    CIRCUITC_array_push_string(&interner->hashes, (void*)&hash, sizeof(hash));
+
+    if(2*interner->size > interner->capacity) CIRCUITC_interner_expand(interner);
+    else interner->slots[slot] = id + 1;
+
+    return id;
+}
+
+// returns string with given ID, \x00 terminated
+const char* CIRCUITC_interner_string(const CIRCUITC_interner_t* interner, const CIRCUITC_symbol_t id){
+    return ((char**)interner->strings.arr)[id];
+}
+
+uint32_t CIRCUITC_interner_length(const CIRCUITC_interner_t* interner, const CIRCUITC_symbol_t id){
+    return ((uint32_t*)interner->lengths.arr)[id];
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef CIRCUITC_keyword_table_included
+#define CIRCUITC_keyword_table_included
+
+#include "stdbool.h"            // boolean type
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "string.h"             // strlen, memcmp
+#include "tokens.h"             // keywords
+#include "interner.h"           // string hash
+
+// perfect hash of the keywords that look like names ([a-zA-Z][a-zA-Z0-9]*), such as "w".
+// these keywords aren't part of the DFA: the DFA reads them as names, and the tokeniser then looks each name up here, which takes a single probe
+// no matter how many keywords there are, and keeps the DFA from growing a state per byte of every keyword.
+// the keyword set is fixed, so the table is built once when the tokeniser is: seeds are tried until one sends every keyword to a different slot,
+// growing the table if none of them does. a slot holds the index of its keyword in CIRCUITC_keywords (or -1) and the keyword's hash,
+// so that a name is only compared with a keyword when both hash the same, which save for keywords themselves hardly ever happens.
+
+#define CIRCUITC_KEYWORD_TABLE_SEEDS_PER_SIZE       1024                // seeds tried before the table is grown
+
+typedef struct{
+    uint64_t hash;
+    int16_t keyword;
+} CIRCUITC_keyword_slot_t;
+
+typedef struct{
+    CIRCUITC_keyword_slot_t* slots;
+    size_t capacity;                    // slots, a power of two
+    uint64_t seed;
+} CIRCUITC_keyword_table_t;
+
+typedef enum{ CIRCUITC_keyword_table_keep_ctx, CIRCUITC_keyword_table_free_ctx } CIRCUITC_keyword_table_options_t;
+
+// whether symbol would be read as a name
+bool CIRCUITC_keyword_table_is_name(const char* symbol){
+    if(!(('A' <= (*symbol &~0x20) && (*symbol &~0x20) <= 'Z'))) return false;
+
+    while(*++symbol)
+        if(!(('0' <= *symbol && *symbol <= '9') || ('A' <= (*symbol &~0x20) && (*symbol &~0x20) <= 'Z'))) return false;
+
+    return true;
+}
+
+// tries to place every keyword that looks like a name with seed; returns false on the first collision
+bool CIRCUITC_keyword_table_place(CIRCUITC_keyword_table_t* table){
+    for(size_t slot = 0; slot < table->capacity; slot++) table->slots[slot] = (CIRCUITC_keyword_slot_t){ 0, -1 };
+
+    for(size_t i = 0; i < sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords); i++){
+        if(!CIRCUITC_keyword_table_is_name(CIRCUITC_keywords[i].symbol)) continue;
+
+        const uint64_t hash = CIRCUITC_interner_hash(CIRCUITC_keywords[i].symbol, strlen(CIRCUITC_keywords[i].symbol), table->seed);
+        const size_t slot = hash & (table->capacity - 1);
+        if(table->slots[slot].keyword >= 0) return false;
+        table->slots[slot] = (CIRCUITC_keyword_slot_t){ hash, i };
+    }
+
+    return true;
+}
+
+CIRCUITC_keyword_table_t* CIRCUITC_keyword_table_init(CIRCUITC_keyword_table_t* table){
+    if(!table) table = malloc(sizeof(*table));
+// starts at twice as many slots as there are keywords, which lets a random seed work often enough
+    table->capacity = 1;
+    while(table->capacity < 2*sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords)) table->capacity *= 2;
+    table->slots = malloc(table->capacity*sizeof(*table->slots));
+
+    for(table->seed = 0; !CIRCUITC_keyword_table_place(table); table->seed++){
+        if(table->seed % CIRCUITC_KEYWORD_TABLE_SEEDS_PER_SIZE == CIRCUITC_KEYWORD_TABLE_SEEDS_PER_SIZE - 1){
+            table->capacity *= 2;
+            table->slots = realloc(table->slots, table->capacity*sizeof(*table->slots));
+        }
+    }
+
+    return table;
+}
+
+void CIRCUITC_keyword_table_destroy(CIRCUITC_keyword_table_t* table, CIRCUITC_keyword_table_options_t freectx){
+    free(table->slots);
+
+    if(freectx == CIRCUITC_keyword_table_free_ctx) free(table);
+}
+
+// if name is a keyword, stores its token in 'token' and returns true
+bool CIRCUITC_keyword_table_lookup(const CIRCUITC_keyword_table_t* table, const char* name, const size_t name_length, CIRCUITC_token_t* token){
+    const uint64_t hash = CIRCUITC_interner_hash(name, name_length, table->seed);
+    const CIRCUITC_keyword_slot_t* slot = &table->slots[hash & (table->capacity - 1)];
+    if(slot->keyword < 0 || slot->hash != hash) return false;
+
+    const char* symbol = CIRCUITC_keywords[slot->keyword].symbol;
+    if(strlen(symbol) != name_length || memcmp(symbol, name, name_length) != 0) return false;
+
+    *token = CIRCUITC_keywords[slot->keyword].value;
+    return true;
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include "lexer_error_handling.h"               // error handling
 #include "dynamic_arrays.h"                     // dynamic array type & operations
 #include "tokeniser.h"                          // getting token from a string
+#include "source.h"                             // memory-mapped source files
+#include "digits.h"                             // hex and binary digits into limbs
 
 // a lexer converts human-readable CircuitC code into a computer-readable representation of said code, encoded in TOKENS.
 // example CircuitC code:
@@ -19,7 +21,8 @@
 // tokens and the piece of syntax they define are held in tokens.h
 // "preprocessor directives" are handled by the lexer.
 // 
-// the lexer returns a specialised error struct when it errors out;
+// the lexer returns a specialised error struct when it errors out; it only keeps track of where it is in bytes, the line and offset of the error being worked out once there is one.
+// source files can be lexed in place through CIRCUITC_lexer_file, which maps them instead of reading them and makes name tokens refer to the mapping.
 // the lexer was also designed to be as general-purpose as possible. this means that it can be retargeted from one language onto another very easily.
 
 void CIRCUITC_lexer_put_name(CIRCUITC_array_t* array, char** string, size_t name_token_length){
@@ -29,70 +32,169 @@ void CIRCUITC_lexer_put_name(CIRCUITC_array_t* array, char** string, size_t name
     *string += name_token_length;                                                       // advances string by however long the name is
 }
 
-typedef enum{ CIRCUITC_LEXER_ERROR_NONE, CIRCUITC_LEXER_ERROR_WRONG_FORMAT, CIRCUITC_LEXER_ERROR_WRONG_PREFIX } CIRCUITC_lexer_error_t;
+void CIRCUITC_lexer_put_name_reference(CIRCUITC_array_t* array, char** string, const char* source, size_t name_token_length){
+// a name token that refers to its source is followed by a size_t holding the offset of said name from the start of the source, and a size_t holding its length.
+    size_t name_token_offset = *string - source;
+    CIRCUITC_array_push_string(array, &name_token_offset, sizeof(name_token_offset));   // name offset
+    CIRCUITC_array_push_string(array, &name_token_length, sizeof(name_token_length));   // name length
+    *string += name_token_length;
+}
+
+// a value token is followed by a size_t holding the width of the value in limbs, and the value itself, as that many limbs least significant first
+// (the layout of the arr of a NOAHZK_variable_width_t) whatever base it was written in. pushes the width and makes room for the limbs after it,
+// returning where they go; they're pushed by adding their size to array's
+char* CIRCUITC_lexer_put_value_width(CIRCUITC_array_t* array, size_t width){
+    CIRCUITC_array_reserve(array, sizeof(width) + NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width));
+    CIRCUITC_array_push_string(array, &width, sizeof(width));
+    return array->arr + array->size;
+}
+
+// whether the bytes of names are copied into the tokens, or the tokens only hold where the names are in the source (which must then outlive them)
+typedef enum{ CIRCUITC_lexer_copy_names, CIRCUITC_lexer_reference_names } CIRCUITC_lexer_names_t;
+
+typedef enum{ CIRCUITC_LEXER_ERROR_NONE, CIRCUITC_LEXER_ERROR_WRONG_FORMAT, CIRCUITC_LEXER_ERROR_WRONG_PREFIX, CIRCUITC_LEXER_ERROR_FILE } CIRCUITC_lexer_error_t;
+
+#define CIRCUITC_LEXER_DECIMAL_CHUNK_DIGITS         9                   // digits that always fit in a limb, as 10^9 < 2^32
+#define CIRCUITC_LEXER_DECIMAL_CHUNK                1000000000U         // 10^CIRCUITC_LEXER_DECIMAL_CHUNK_DIGITS
+#define CIRCUITC_LEXER_DECIMAL_WORD_DIGITS          (sizeof(NOAHZK_word_t) == sizeof(uint64_t)? 19: 9)      // digits that always fit in a word, as 10^19 < 2^64
+// below ~37k digits, chunk by chunk multiply-adds keep up with the Karatsuba/Toom-3 products splitting takes (and the powers of 10 it has to build)
+#define CIRCUITC_LEXER_DECIMAL_SPLIT_CHUNKS         4096                // values of more chunks than this are split in two, and their halves converted separately
+#define CIRCUITC_LEXER_DECIMAL_STACK_WIDTH          32                  // values that fit in this many limbs are converted on the stack
+
+// limbs enough for any value of length decimal digits, as a digit takes less than 3.321928095 bits
+uint64_t CIRCUITC_lexer_decimal_width(const size_t length){
+    return NOAHZK_SIZE_AS_ARR_OF_TYPE(length*3321928095ULL/1000000000ULL + 1, BITS_IN_NOAHZK_LIMB);
+}
+
+// value of the (at most CIRCUITC_LEXER_DECIMAL_WORD_DIGITS) digits at string
+NOAHZK_word_t CIRCUITC_lexer_decimal_chunk(const char* string, const size_t length){
+    NOAHZK_word_t chunk = 0;
+    size_t i = 0;
+// two digits at a time, which halves the chain of multiplications each digit waits on
+    for(; i + 1 < length; i += 2) chunk = chunk*100 + (uint8_t)(string[i] - 0x30)*10 + (uint8_t)(string[i + 1] - 0x30);
+    if(i < length) chunk = chunk*10 + (uint8_t)(string[i] - 0x30);
+    return chunk;
+}
+
+// converts the length digits at string into integer, which is width limbs wide (at least CIRCUITC_lexer_decimal_width(length)).
+// digits are gathered into a word a chunk at a time, so integer = integer*10^19 + chunk is done once every 19 digits (9 where words are 32 bits)
+// rather than integer = integer*10 + digit every digit, and only over the words that aren't 0 yet. the chunk goes in as the carry of a fused
+// multiply by a word, which works on integer in place
+void CIRCUITC_lexer_decimal_to_limbs(NOAHZK_limb_t* integer, const uint64_t width, const char* string, const size_t length){
+    const uint64_t width_in_bytes = NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width);
+    memset(integer, 0, width_in_bytes);
+    uint64_t used_width = 0;
+
+    NOAHZK_word_t chunk_power = 1;
+    for(size_t i = 0; i < CIRCUITC_LEXER_DECIMAL_WORD_DIGITS; i++) chunk_power *= 10;
+// the first chunk takes the digits that are left over, so that all the others are full
+    size_t chunk_length = length % CIRCUITC_LEXER_DECIMAL_WORD_DIGITS? length % CIRCUITC_LEXER_DECIMAL_WORD_DIGITS: CIRCUITC_LEXER_DECIMAL_WORD_DIGITS;
+
+// the words in use may run past width by part of a word, which the value never reaches as it fits in width limbs
+    for(size_t i = 0; i < length; i += chunk_length, chunk_length = CIRCUITC_LEXER_DECIMAL_WORD_DIGITS){
+        const NOAHZK_word_t chunk = CIRCUITC_lexer_decimal_chunk(string + i, chunk_length);
+        const NOAHZK_word_t carry = NOAHZK_variable_width_mul_1_byte(integer, integer, chunk_power, chunk, NOAHZK_MIN(NOAHZK_GET_WIDTH_FROM_WORD_WIDTH(used_width), width_in_bytes));
+        if(carry) NOAHZK_word_store_byte(integer, width_in_bytes, used_width++, carry);
+    }
+}
+
+// as CIRCUITC_lexer_decimal_to_limbs, but long values are split into a high part and a low part of 9*2^k digits, which are converted separately
+// and put back together as high*10^(9*2^k) + low. this turns the conversion into a few multiplications of large halves rather than many multiplications by a word,
+// and keeps up with however fast the multiplication is. powers[k] = 10^(9*2^k), which is 2^k limbs wide; temporaries are taken from scratch.
+void CIRCUITC_lexer_decimal_split(NOAHZK_limb_t* integer, const uint64_t width, const char* string, const size_t length, NOAHZK_limb_t** powers, CIRCUITC_arena_t* scratch){
+    const size_t chunks = NOAHZK_SIZE_AS_ARR_OF_TYPE(length, CIRCUITC_LEXER_DECIMAL_CHUNK_DIGITS);
+    if(chunks <= CIRCUITC_LEXER_DECIMAL_SPLIT_CHUNKS){
+        CIRCUITC_lexer_decimal_to_limbs(integer, width, string, length);
+        return;
+    }
+// largest k such that the low part, 2^k chunks, is shorter than the value
+    uint64_t k = 0;
+    while(((size_t)2 << k) < chunks) k++;
+
+    const size_t length_low = (size_t)CIRCUITC_LEXER_DECIMAL_CHUNK_DIGITS << k, length_high = length - length_low;
+    const uint64_t width_power = (uint64_t)1 << k, width_high = CIRCUITC_lexer_decimal_width(length_high);
+
+    const CIRCUITC_arena_mark_t mark = CIRCUITC_arena_mark(scratch);
+    NOAHZK_variable_width_t high = { .width = width_high, .arr = CIRCUITC_arena_alloc(scratch, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_high)) };
+    NOAHZK_variable_width_t product = { .width = width_high + width_power, .arr = CIRCUITC_arena_alloc(scratch, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_high + width_power)) };
+    NOAHZK_variable_width_t result = { .width = width, .arr = integer };
+
+    CIRCUITC_lexer_decimal_split(high.arr, high.width, string, length_high, powers, scratch);
+    CIRCUITC_lexer_decimal_split(integer, width, string + length_high, length_low, powers, scratch);
+// the limbs of product past width are 0, since the value fits in width limbs
+    NOAHZK_variable_width_mul_byte(product.arr, high.arr, powers[k], NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE(high), NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_power));
+    NOAHZK_variable_width_add(&result, &result, &product);
+
+    CIRCUITC_arena_rewind(scratch, mark);
+}
 
+// the integer is sized once, up front, for the largest value that many digits can hold. short values are converted on the stack;
+// long ones take the integer and the temporaries of CIRCUITC_lexer_decimal_split from the arena array is made from, or from an arena of their own if there's none,
+// and give them back once the integer is pushed.
 CIRCUITC_lexer_error_t CIRCUITC_lexer_string_decimal_to_integer(CIRCUITC_array_t* array, char* string, const size_t value_token_length){
-    NOAHZK_variable_width_t integer = NOAHZK_variable_width_var_INITIALIZER; 
     const uint8_t digit_max = 9;
 
-    for(size_t i = 0; i < value_token_length; i++){
-        const char ascii_digit = *string++;
-        const uint8_t digit = ascii_digit - 0x30;
-        if(digit > digit_max) return CIRCUITC_LEXER_ERROR_WRONG_FORMAT;
+    for(size_t i = 0; i < value_token_length; i++)
+        if((uint8_t)(string[i] - 0x30) > digit_max) return CIRCUITC_LEXER_ERROR_WRONG_FORMAT;
 
-        NOAHZK_variable_width_mul_constant(&integer, &integer, 10);
-        NOAHZK_variable_width_add_constant(&integer, &integer, digit);
+    const uint64_t width = CIRCUITC_lexer_decimal_width(value_token_length);
+// array grows before the integer is taken from the arena, so that pushing the integer onto array doesn't move array past it (which rewinding would then give back)
+    CIRCUITC_lexer_put_value_width(array, width);
+
+    if(width <= CIRCUITC_LEXER_DECIMAL_STACK_WIDTH){
+        NOAHZK_limb_t integer[CIRCUITC_LEXER_DECIMAL_STACK_WIDTH];
+        CIRCUITC_lexer_decimal_to_limbs(integer, width, string, value_token_length);
+        CIRCUITC_array_push_string(array, integer, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width));
+        return CIRCUITC_LEXER_ERROR_NONE;
     }
 
-    CIRCUITC_array_push_string(array, integer.arr, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE(integer));
-    NOAHZK_variable_width_destroy(&integer, NOAHZK_variable_width_keep_ptr);
-    return CIRCUITC_LEXER_ERROR_NONE;
-}
+    CIRCUITC_arena_t own_scratch;
+    CIRCUITC_arena_t* scratch = array->arena? array->arena: CIRCUITC_arena_init(&own_scratch);
+    const CIRCUITC_arena_mark_t mark = CIRCUITC_arena_mark(scratch);
 
-uint8_t CIRCUITC_lexer_character_hex_to_integer(const char ascii_digit){
-// if it's a numeric character, return it converted properly; otherwise convert ascii digit to uppercase and subtract and add or subtract opportune values
-    return CIRCUITC_tokeniser_REGEX_is_numeric(ascii_digit)? ascii_digit - 0x30: CIRCUITC_character_toupper(ascii_digit) - 0x41 + 10;
-}
+    NOAHZK_limb_t* integer = CIRCUITC_arena_alloc(scratch, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width));
+// every power of 10^(9*2^k) the split may need, each the square of the one before it
+    NOAHZK_limb_t* powers[BITS_IN_UINT64_T];
+    const size_t chunks = NOAHZK_SIZE_AS_ARR_OF_TYPE(value_token_length, CIRCUITC_LEXER_DECIMAL_CHUNK_DIGITS);
+    powers[0] = CIRCUITC_arena_alloc(scratch, sizeof(NOAHZK_limb_t));
+    powers[0][0] = CIRCUITC_LEXER_DECIMAL_CHUNK;
+    for(uint64_t k = 1; chunks > CIRCUITC_LEXER_DECIMAL_SPLIT_CHUNKS && ((size_t)1 << k) < chunks; k++){
+        const uint64_t width_power = (uint64_t)1 << (k - 1);
+        powers[k] = CIRCUITC_arena_alloc(scratch, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(2*width_power));
+        NOAHZK_variable_width_square_byte(powers[k], powers[k - 1], NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width_power));
+    }
 
-CIRCUITC_lexer_error_t CIRCUITC_lexer_string_hex_to_integer(CIRCUITC_array_t* array, char* string, const size_t value_token_length){
-    uint8_t integer = 0;
-    const uint8_t digit_max = 15;
-    const size_t digits_in_integer = 2;
+    CIRCUITC_lexer_decimal_split(integer, width, string, value_token_length, powers, scratch);
+    CIRCUITC_array_push_string(array, integer, NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width));
 
-    for(size_t i = 0; i < value_token_length; i++){
-        const char ascii_digit = *string++;
-        const uint8_t digit = CIRCUITC_lexer_character_hex_to_integer(ascii_digit);
-        if(digit > digit_max) return CIRCUITC_LEXER_ERROR_WRONG_FORMAT;
+    if(array->arena) CIRCUITC_arena_rewind(scratch, mark);
+    else CIRCUITC_arena_destroy(scratch, CIRCUITC_arena_keep_ctx);
+    return CIRCUITC_LEXER_ERROR_NONE;
+}
 
-        integer = integer << 4 | digit;
+CIRCUITC_lexer_error_t CIRCUITC_lexer_string_hex_to_integer(CIRCUITC_array_t* array, char* string, const size_t value_token_length){
+    const size_t mark = array->size, width = CIRCUITC_DIGITS_HEX_WIDTH(value_token_length);
+    char* integer = CIRCUITC_lexer_put_value_width(array, width);
 
-        if(i % digits_in_integer == digits_in_integer - 1 || i == value_token_length - 1){
-            CIRCUITC_array_push(array, integer);
-            integer = 0;
-        }
+    if(!CIRCUITC_digits_hex(integer, string, value_token_length)){
+        array->size = mark;
+        return CIRCUITC_LEXER_ERROR_WRONG_FORMAT;
     }
 
+    array->size += NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width);
     return CIRCUITC_LEXER_ERROR_NONE;
 }
 
 CIRCUITC_lexer_error_t CIRCUITC_lexer_string_binary_to_integer(CIRCUITC_array_t* array, char* string, const size_t value_token_length){
-    uint8_t integer = 0;
-    const uint8_t digit_max = 1;
-    const size_t digits_in_integer = 8;
-    
-    for(size_t i = 0; i < value_token_length; i++){
-        const char ascii_digit = *string++;
-        const uint8_t digit = ascii_digit - 0x30;
-        if(digit > digit_max) return CIRCUITC_LEXER_ERROR_WRONG_FORMAT;
-
-        integer = integer << 1 | digit;
-// integer is full or it's the last iter
-        if(i % digits_in_integer == digits_in_integer - 1 || i == value_token_length - 1){
-            CIRCUITC_array_push(array, integer);
-            integer = 0;
-        }
+    const size_t mark = array->size, width = CIRCUITC_DIGITS_BINARY_WIDTH(value_token_length);
+    char* integer = CIRCUITC_lexer_put_value_width(array, width);
+
+    if(!CIRCUITC_digits_binary(integer, string, value_token_length)){
+        array->size = mark;
+        return CIRCUITC_LEXER_ERROR_WRONG_FORMAT;
     }
 
+    array->size += NOAHZK_GET_WIDTH_FROM_VAR_WIDTH_TYPE_INT(width);
     return CIRCUITC_LEXER_ERROR_NONE;
 }
 
@@ -101,11 +203,12 @@ CIRCUITC_lexer_error_t CIRCUITC_lexer_string_binary_to_integer(CIRCUITC_array_t*
 // 2      binary (such as 0b00011011)
 // 10     decimal (such as 01234567)
 // 16     hexadecimal (such ax 0x0123ABCD)
-// hexadecimal values always start with 0x; all encoding formats but decimal must start with a prefix
+// hexadecimal values always start with 0x; all encoding formats but decimal must start with a prefix, which decimal values (being all digits) can't be mistaken for
+// whatever the base, the value is pushed as its width in limbs followed by its limbs (see CIRCUITC_lexer_put_value_width)
 CIRCUITC_lexer_error_t CIRCUITC_lexer_put_value(CIRCUITC_array_t* array, char** string, const size_t value_token_length){ 
     CIRCUITC_lexer_error_t return_value;
 // checks for all prefixes
-    if(value_token_length > 2){
+    if(value_token_length > 2 && !CIRCUITC_tokeniser_REGEX_is_numeric((*string)[1])){
 // why use an array of structs like these instead of comparing and calling the function outright? so adding new prefixes is easier.
 // still this is a pretty ugly approach.
         struct {
@@ -136,39 +239,74 @@ CIRCUITC_lexer_error_t CIRCUITC_lexer_put_value(CIRCUITC_array_t* array, char**
     return return_value;
 }
 
-// given string of CircuitC code, converts it to string of tokens that has to be freed by user
-void* CIRCUITC_lexer(char* string, CIRCUITC_lexer_error_t* error_code){
+// lexes a single token off string, pushing it (and the name or value following it) onto array and advancing string past it.
+// source ~ start of the string being lexed, which name references are relative to
+// on error, the value that caused it starts where string was before the call.
+CIRCUITC_lexer_error_t CIRCUITC_lexer_step(CIRCUITC_array_t* array, char** string, const char* source, const CIRCUITC_lexer_names_t names, CIRCUITC_tokeniser_t* tokeniser, CIRCUITC_token_t* token){
+    size_t nameval_token_length = 0;
+    *token = CIRCUITC_token_get(string, tokeniser, &nameval_token_length);
+
+    CIRCUITC_array_push(array, *token);
+// adds name or value to tokens
+    if(*token == CIRCUITC_TOKEN_NAME){
+        if(names == CIRCUITC_lexer_reference_names) CIRCUITC_lexer_put_name_reference(array, string, source, nameval_token_length);
+        else CIRCUITC_lexer_put_name(array, string, nameval_token_length);
+    }
+    else if(*token == CIRCUITC_TOKEN_VALUE){
+        const CIRCUITC_lexer_error_t error_code = CIRCUITC_lexer_put_value(array, string, nameval_token_length);
+        if(error_code != CIRCUITC_LEXER_ERROR_NONE) return error_code;
+    }
+
+    return CIRCUITC_LEXER_ERROR_NONE;
+}
+
+// given string of CircuitC code, converts it to string of tokens; names are handled as set by 'names'.
+// the tokens, and everything the lexer needs along the way, are taken from arena, so that they go away along with it; if arena is NULL, they're malloc'd
+// and the string of tokens has to be freed by user. error specifics are always malloc'd.
+void* CIRCUITC_lexer_with_arena(char* string, const CIRCUITC_lexer_names_t names, CIRCUITC_arena_t* arena, CIRCUITC_lexer_error_t* error_code){
 // static initialization? it doesn't really matter which one I use in the end.
+    char* const source = string;
     CIRCUITC_tokeniser_t tokeniser; CIRCUITC_tokeniser_init(&tokeniser);
-    CIRCUITC_array_t array; CIRCUITC_array_init(&array);
+    CIRCUITC_array_t array; CIRCUITC_array_init_from(&array, arena);
     CIRCUITC_token_t token;
 
-    *error_code = CIRCUITC_LEXER_ERROR_NONE;
-    size_t current_line = 0, current_offset = 0;
-
     do{
-        size_t nameval_token_length = 0, lines_skipped;
-        token = CIRCUITC_token_get(&string, &tokeniser, &lines_skipped, &current_offset, &nameval_token_length);
-
-        CIRCUITC_array_push(&array, token);
-// adds name or value to tokens
-        if(token == CIRCUITC_TOKEN_NAME) CIRCUITC_lexer_put_name(&array, &string, nameval_token_length);
-        else if(token == CIRCUITC_TOKEN_VALUE){
-            *error_code = CIRCUITC_lexer_put_value(&array, &string, nameval_token_length);
-            if(*error_code != CIRCUITC_LEXER_ERROR_NONE){
-                CIRCUITC_array_destroy(&array, CIRCUITC_array_keep_ctx);
-                current_offset -= nameval_token_length;
-                return CIRCUITC_lexer_error_specifics_init(NULL, current_line, current_offset);
-            }
-        } 
-
-        current_line += lines_skipped;
+        char* const token_start = string;
+        *error_code = CIRCUITC_lexer_step(&array, &string, source, names, &tokeniser, &token);
+        if(*error_code != CIRCUITC_LEXER_ERROR_NONE){
+            CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
+            CIRCUITC_array_destroy(&array, CIRCUITC_array_keep_ctx);
+            return CIRCUITC_lexer_error_specifics_init(NULL, source, token_start - source);
+        }
     } while(token != CIRCUITC_TOKEN_EOF);
 
     char* tokenised_string = CIRCUITC_array_extract_array(&array);
     CIRCUITC_array_destroy(&array, CIRCUITC_array_keep_ctx);
+    CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
 
     return tokenised_string;
 }
 
+// given string of CircuitC code, converts it to string of tokens that has to be freed by user; names are handled as set by 'names'
+void* CIRCUITC_lexer_with_names(char* string, const CIRCUITC_lexer_names_t names, CIRCUITC_lexer_error_t* error_code){
+    return CIRCUITC_lexer_with_arena(string, names, NULL, error_code);
+}
+
+// given string of CircuitC code, converts it to string of tokens that has to be freed by user
+void* CIRCUITC_lexer(char* string, CIRCUITC_lexer_error_t* error_code){
+    return CIRCUITC_lexer_with_names(string, CIRCUITC_lexer_copy_names, error_code);
+}
+
+// maps file at path into source and lexes it in place. name tokens refer to source, which the user has to unmap (through CIRCUITC_source_unmap) once done with them.
+// source can't be NULL, as the mapping would then be lost along with the struct CIRCUITC_source_map allocates for it.
+// returns NULL and sets error_code to CIRCUITC_LEXER_ERROR_FILE if source is NULL or the file can't be mapped.
+void* CIRCUITC_lexer_file(const char* path, CIRCUITC_source_t* source, CIRCUITC_lexer_error_t* error_code){
+    if(!source || !(source = CIRCUITC_source_map(source, path))){
+        *error_code = CIRCUITC_LEXER_ERROR_FILE;
+        return NULL;
+    }
+
+    return CIRCUITC_lexer_with_names(source->string, CIRCUITC_lexer_reference_names, error_code);
+}
+
 #endif
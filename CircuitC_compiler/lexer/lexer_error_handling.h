@@ -3,17 +3,24 @@
 
 #include "stdint.h"
 #include "stdlib.h"
+#include "lines.h"              // positions into lines
 
 typedef struct{
     uint64_t line;
-    uint64_t offset;
+    uint64_t offset;            // bytes since last newline
+    uint64_t position;          // bytes since start of source
 } CIRCUITC_lexer_error_specifics_t;
 
-CIRCUITC_lexer_error_specifics_t* CIRCUITC_lexer_error_specifics_init(CIRCUITC_lexer_error_specifics_t* error_specifics, const uint64_t line, const uint64_t offset){
+// error at position bytes into source; its line and offset are only worked out here, by going through the newlines before it
+CIRCUITC_lexer_error_specifics_t* CIRCUITC_lexer_error_specifics_init(CIRCUITC_lexer_error_specifics_t* error_specifics, const char* source, const uint64_t position){
+    size_t line = 0, offset = 0;
+    CIRCUITC_lines_advance(source, position, &line, &offset);
+
     if(!error_specifics) error_specifics = malloc(sizeof(*error_specifics));
 
-    error_specifics->line   = line;
-    error_specifics->offset = offset;
+    error_specifics->line     = line;
+    error_specifics->offset   = offset;
+    error_specifics->position = position;
 
     return error_specifics;
 }
@@ -0,0 +1,220 @@
+#ifndef CIRCUITC_lexer_parallel_included
+#define CIRCUITC_lexer_parallel_included
+
+#include "stdbool.h"            // boolean type
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "string.h"             // strncmp, memchr
+#include "pthread.h"            // threads
+#include "dynamic_arrays.h"     // dynamic array type & operations
+#include "lexer.h"              // lexing single tokens
+
+// parallel version of CIRCUITC_lexer: source is split into pieces, pieces are lexed by a pool of threads, and the tokens of all pieces are then stitched together.
+// the result is byte-for-byte what CIRCUITC_lexer would have returned.
+//
+// pieces may only start where a token would start no matter what came before, and where no token that started before could go on.
+// said places are the first non-whitespace character after a newline that isn't within a comment:
+//      - the whitespaces before it are tokens of one character each, and the comment that the newline closes (if any) ends there
+//      - no token holds a newline, save for comments; as the newline is not within a comment, nothing before it carries over
+// finding out whether a newline is within a comment takes a pass over the source that skips comments the way the tokeniser does,
+// jumping from one comment opener to the next with the run-scanning kernels.
+// this relies on all comment openers starting with the same byte, and on no other symbol starting with a comment opener; if this isn't the case,
+// the source is lexed as a single piece.
+//
+// pieces don't keep track of lines: a piece that errors out only remembers where the token that caused it starts, and the line of the first error in the source
+// is worked out from that once all pieces are done.
+//
+// whether this is any faster than CIRCUITC_lexer is unproven: it has only been benchmarked on a single core (benchmarks/bench_lexer_parallel.c),
+// where there is nothing for extra threads to win and it runs at 0.85-1.02x the speed of CIRCUITC_lexer, i.e. what splitting costs.
+// run said benchmark on a multi-core machine before relying on it to scale.
+
+#define CIRCUITC_LEXER_PARALLEL_PIECES_PER_THREAD   4                   // more pieces than threads, so that threads that are done early take on more work
+#define CIRCUITC_LEXER_PARALLEL_MIN_PIECE_LENGTH    (64*1024)           // smaller pieces aren't worth a thread
+
+typedef struct{
+    char* start;
+    char* end;                          // start of next piece, or the \x00 that ends the source for the last piece
+    char* error_token;                  // start of token that caused error_code
+
+    CIRCUITC_array_t array;             // tokens of piece
+    CIRCUITC_lexer_error_t error_code;
+} CIRCUITC_lexer_piece_t;
+
+typedef struct{
+    CIRCUITC_lexer_piece_t* pieces;
+    size_t number_of_pieces;
+    size_t next_piece;                  // taken atomically by the threads
+
+    char* source;
+    CIRCUITC_lexer_names_t names;
+    CIRCUITC_tokeniser_t* tokeniser;    // only ever read while lexing, so shared by all threads
+} CIRCUITC_lexer_pool_t;
+
+// whether pieces can be found by looking for the one byte that begins every comment
+bool CIRCUITC_lexer_parallel_can_split(CIRCUITC_tokeniser_t* tokeniser){
+    const size_t number_of_comments = sizeof(CIRCUITC_comments_begin)/sizeof(*CIRCUITC_comments_begin);
+    const uint8_t comment_first_byte = CIRCUITC_comments_begin[0].symbol[0];
+
+    for(size_t i = 0; i < number_of_comments; i++)
+        if((uint8_t)CIRCUITC_comments_begin[i].symbol[0] != comment_first_byte) return false;
+// a symbol that starts with comment_first_byte but isn't a comment may only be one byte long, or it might hold the start of a comment that isn't one
+    for(size_t i = 0; i < sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords); i++)
+        if((uint8_t)CIRCUITC_keywords[i].symbol[0] == comment_first_byte && strlen(CIRCUITC_keywords[i].symbol) > 1) return false;
+
+    return tokeniser->longest_symbol != 0;
+}
+
+// if string starts with a comment, skips it and returns true
+bool CIRCUITC_lexer_parallel_comment_skip(char** string, CIRCUITC_tokeniser_t* tokeniser){
+    const size_t number_of_comments = sizeof(CIRCUITC_comments_begin)/sizeof(*CIRCUITC_comments_begin);
+
+    for(size_t i = 0; i < number_of_comments; i++){
+        const size_t length_comment_symbol = strlen(CIRCUITC_comments_begin[i].symbol);
+        if(strncmp(*string, CIRCUITC_comments_begin[i].symbol, length_comment_symbol) == 0){
+            *string = CIRCUITC_tokeniser_comment_skip(*string + length_comment_symbol, tokeniser, CIRCUITC_comments_begin[i].value);
+            return true;
+        }
+    }
+    return false;
+}
+
+// given that string is right after a newline that is not within a comment, returns where the piece that starts there starts, or the \x00 that ends the source
+char* CIRCUITC_lexer_parallel_piece_start(char* string, CIRCUITC_tokeniser_t* tokeniser){
+    bool newline = false;
+    return string + tokeniser->scan.whitespace(string, &newline);
+}
+
+// finds where pieces start in one pass over source: piece i > 0 starts at the first place where a piece may start that comes after a newline
+// at or after string + length*i/number_of_pieces. returns number of pieces found, which is less than number_of_pieces if source runs out of such places.
+size_t CIRCUITC_lexer_parallel_split(char* string, const size_t length, char** starts, const size_t number_of_pieces, CIRCUITC_tokeniser_t* tokeniser){
+    const char comment_first_byte = CIRCUITC_comments_begin[0].symbol[0];
+    char* const source = string;
+    size_t pieces_found = 1;
+
+    starts[0] = string;
+    while(pieces_found < number_of_pieces){
+        char* target = source + length*pieces_found/number_of_pieces;
+// there's no comment between string and next_comment, so any newline in there that comes at or after target will do
+        char* const next_comment = string + tokeniser->scan.until(string, comment_first_byte);
+
+        for(;;){
+            char* const from = string < target? target: string;
+            char* const newline = from < next_comment? memchr(from, '\n', next_comment - from): NULL;
+            if(!newline) break;
+// whitespaces never hold comment_first_byte, so the piece starts at or before next_comment
+            string = CIRCUITC_lexer_parallel_piece_start(newline + 1, tokeniser);
+            if(*string == '\x00') return pieces_found;
+
+            starts[pieces_found++] = string;
+            if(pieces_found == number_of_pieces) return pieces_found;
+            target = source + length*pieces_found/number_of_pieces;
+        }
+        if(*next_comment == '\x00') break;
+
+        string = next_comment;
+        if(!CIRCUITC_lexer_parallel_comment_skip(&string, tokeniser)) string++;
+// comments closed by a newline end where a piece may start
+        else if(string >= target && string[-1] == '\n'){
+            string = CIRCUITC_lexer_parallel_piece_start(string, tokeniser);
+            if(*string == '\x00') break;
+
+            starts[pieces_found++] = string;
+        }
+    }
+
+    return pieces_found;
+}
+
+void CIRCUITC_lexer_parallel_piece_lex(CIRCUITC_lexer_pool_t* pool, CIRCUITC_lexer_piece_t* piece){
+    const bool last_piece = *piece->end == '\x00';
+    char* string = piece->start;
+    CIRCUITC_token_t token;
+
+    CIRCUITC_array_init(&piece->array);
+    piece->error_code = CIRCUITC_LEXER_ERROR_NONE;
+// only the last piece gets to the \x00 that ends the source, and thus to CIRCUITC_TOKEN_EOF
+    while(last_piece || string < piece->end){
+        char* const token_start = string;
+        piece->error_code = CIRCUITC_lexer_step(&piece->array, &string, pool->source, pool->names, pool->tokeniser, &token);
+        if(piece->error_code != CIRCUITC_LEXER_ERROR_NONE){
+            piece->error_token = token_start;
+            break;
+        }
+        if(token == CIRCUITC_TOKEN_EOF) break;
+    }
+}
+
+void* CIRCUITC_lexer_parallel_worker(void* real_pool){
+    CIRCUITC_lexer_pool_t* pool = real_pool;
+
+    for(size_t i; (i = __atomic_fetch_add(&pool->next_piece, 1, __ATOMIC_RELAXED)) < pool->number_of_pieces;)
+        CIRCUITC_lexer_parallel_piece_lex(pool, &pool->pieces[i]);
+// long decimal values are multiplied in a workspace that belongs to the thread, and would otherwise outlive it
+    NOAHZK_variable_width_mul_workspace_free();
+
+    return NULL;
+}
+
+// given string of CircuitC code, converts it to string of tokens that has to be freed by user, using up to 'threads' threads.
+// names are handled as set by 'names'; errors are reported exactly as CIRCUITC_lexer reports them, that is, the first one in the source is returned.
+void* CIRCUITC_lexer_parallel(char* string, const CIRCUITC_lexer_names_t names, const size_t threads, CIRCUITC_lexer_error_t* error_code){
+    CIRCUITC_tokeniser_t tokeniser; CIRCUITC_tokeniser_init(&tokeniser);
+    const size_t length = strlen(string);
+
+    size_t number_of_pieces = threads*CIRCUITC_LEXER_PARALLEL_PIECES_PER_THREAD;
+    if(number_of_pieces > length/CIRCUITC_LEXER_PARALLEL_MIN_PIECE_LENGTH) number_of_pieces = length/CIRCUITC_LEXER_PARALLEL_MIN_PIECE_LENGTH;
+    if(threads <= 1 || number_of_pieces == 0 || !CIRCUITC_lexer_parallel_can_split(&tokeniser)) number_of_pieces = 1;
+// splits source; stops early if it runs out of places where pieces may start
+    CIRCUITC_lexer_piece_t* pieces = malloc(number_of_pieces*sizeof(*pieces));
+    char** starts = malloc(number_of_pieces*sizeof(*starts));
+    const size_t pieces_found = CIRCUITC_lexer_parallel_split(string, length, starts, number_of_pieces, &tokeniser);
+
+    for(size_t i = 0; i < pieces_found; i++){
+        pieces[i].start = starts[i];
+        pieces[i].end = i + 1 < pieces_found? starts[i + 1]: string + length;
+    }
+    free(starts);
+// lexes pieces; the calling thread is one of the threads
+    CIRCUITC_lexer_pool_t pool = { pieces, pieces_found, 0, string, names, &tokeniser };
+    const size_t number_of_threads = NOAHZK_MIN(threads, pieces_found);
+    pthread_t* thread_ids = malloc(number_of_threads*sizeof(*thread_ids));
+    size_t threads_started = 0;
+
+    for(size_t i = 1; i < number_of_threads; i++)
+        if(pthread_create(&thread_ids[threads_started], NULL, CIRCUITC_lexer_parallel_worker, &pool) == 0) threads_started++;
+    CIRCUITC_lexer_parallel_worker(&pool);
+    for(size_t i = 0; i < threads_started; i++) pthread_join(thread_ids[i], NULL);
+    free(thread_ids);
+// the first error in the source is the one of the first piece that errored out
+    size_t piece_with_error = 0;
+    while(piece_with_error < pieces_found && pieces[piece_with_error].error_code == CIRCUITC_LEXER_ERROR_NONE) piece_with_error++;
+
+    void* result;
+    if(piece_with_error < pieces_found){
+        *error_code = pieces[piece_with_error].error_code;
+        result = CIRCUITC_lexer_error_specifics_init(NULL, string, pieces[piece_with_error].error_token - string);
+
+        for(size_t i = 0; i < pieces_found; i++) CIRCUITC_array_destroy(&pieces[i].array, CIRCUITC_array_keep_ctx);
+    }
+    else{
+        *error_code = CIRCUITC_LEXER_ERROR_NONE;
+// stitches tokens of all pieces onto those of the first piece, which is grown only once
+        size_t size = 0;
+        for(size_t i = 0; i < pieces_found; i++) size += pieces[i].array.size;
+        if(size >= pieces[0].array.capacity) CIRCUITC_array_expand(&pieces[0].array, size);
+
+        for(size_t i = 1; i < pieces_found; i++){
+            CIRCUITC_array_push_string(&pieces[0].array, pieces[i].array.arr, pieces[i].array.size);
+            CIRCUITC_array_destroy(&pieces[i].array, CIRCUITC_array_keep_ctx);
+        }
+
+        result = CIRCUITC_array_extract_array(&pieces[0].array);
+        CIRCUITC_array_destroy(&pieces[0].array, CIRCUITC_array_keep_ctx);
+    }
+
+    free(pieces);
+    CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
+    return result;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef CIRCUITC_lexer_stream_included
+#define CIRCUITC_lexer_stream_included
+
+#include "stdbool.h"            // boolean type
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "string.h"             // memmove
+#include "dynamic_arrays.h"     // dynamic array type & operations
+#include "lexer.h"              // lexing single tokens
+#include "tokeniser.h"          // resuming the scan of a partial token
+#include "lines.h"              // lines of source dropped
+
+// streaming version of CIRCUITC_lexer: source is pushed in chunks of any size, tokens are pulled in batches of bounded size.
+// only the part of the source that hasn't been turned into tokens yet is kept around, so memory use depends on the size of the chunks and of the longest token,
+// not on the size of the source; whoever consumes the tokens can run alongside the lexer.
+//
+// a token that touches the end of what has been pushed so far may still change once more source comes in (a name may go on, a comment may not be closed yet,
+// an operator may turn out to be a longer one), so it's only lexed once enough source follows it, or once the stream is finished.
+// such a token is usually short, and lexing it again on the next pull costs little; comments, names and values can run on for any number of chunks, though,
+// so for those the pull saves how far the scan for their end got, and later pulls carry on from there. the token is lexed from its start only once that scan
+// ends before what has been pushed does, which keeps a long token to a single pass over it rather than one per chunk.
+// tokens are laid out exactly as CIRCUITC_lexer lays them out; names are always copied, since chunks don't outlive the call that pushes them.
+// lines aren't kept track of token by token: the newlines of source that's dropped are counted once, when it's dropped, and the line of an error is worked out
+// from there once there is one.
+//
+// usage:
+//      while(there's source) push chunk, then pull until 0 tokens are returned
+//      finish, then pull until 0 tokens are returned; the last batch ends with CIRCUITC_TOKEN_EOF
+
+typedef struct{
+    CIRCUITC_tokeniser_t tokeniser;
+    CIRCUITC_array_t pending;           // source pushed but not lexed yet, always followed by \x00
+    size_t consumed;                    // bytes of pending already lexed
+    size_t scanned;                     // bytes of the partial token at consumed whose end has been looked for already, or 0 if there's no scan to resume
+    CIRCUITC_dfa_accept_t scan;         // what the partial token is: a comment, along with the index of its closing symbol, a name or a value
+    size_t pending_line;                // line pending source starts on
+    size_t pending_offset;              // offset from last newline pending source starts at
+    size_t current_line;                // line of token that caused the last error
+    size_t current_offset;
+    bool finished;                      // no more source will be pushed
+    bool done;                          // CIRCUITC_TOKEN_EOF has been pulled
+} CIRCUITC_lexer_stream_t;
+
+typedef enum{ CIRCUITC_lexer_stream_keep_ctx, CIRCUITC_lexer_stream_free_ctx } CIRCUITC_lexer_stream_options_t;
+
+// terminates pending source with \x00 without counting it as pushed
+void CIRCUITC_lexer_stream_terminate(CIRCUITC_lexer_stream_t* stream){
+    CIRCUITC_array_reserve(&stream->pending, 1);
+    stream->pending.arr[stream->pending.size] = '\x00';
+}
+
+CIRCUITC_lexer_stream_t* CIRCUITC_lexer_stream_init(CIRCUITC_lexer_stream_t* stream){
+    if(!stream) stream = malloc(sizeof(*stream));
+
+    CIRCUITC_tokeniser_init(&stream->tokeniser);
+    CIRCUITC_array_init(&stream->pending);
+    CIRCUITC_lexer_stream_terminate(stream);
+
+    stream->consumed = 0;
+    stream->scanned = 0;
+    stream->pending_line = 0;
+    stream->pending_offset = 0;
+    stream->current_line = 0;
+    stream->current_offset = 0;
+    stream->finished = false;
+    stream->done = false;
+
+    return stream;
+}
+
+void CIRCUITC_lexer_stream_destroy(CIRCUITC_lexer_stream_t* stream, CIRCUITC_lexer_stream_options_t freectx){
+    CIRCUITC_tokeniser_destroy(&stream->tokeniser, CIRCUITC_tokeniser_keep_ctx);
+    CIRCUITC_array_destroy(&stream->pending, CIRCUITC_array_keep_ctx);
+
+    if(freectx == CIRCUITC_lexer_stream_free_ctx) free(stream);
+}
+
+// adds chunk of source to stream; source that has already been lexed is dropped first.
+// a \x00 within chunk ends the source just as it does for CIRCUITC_lexer.
+void CIRCUITC_lexer_stream_push(CIRCUITC_lexer_stream_t* stream, const void* chunk, const size_t length_chunk){
+    CIRCUITC_lines_advance(stream->pending.arr, stream->consumed, &stream->pending_line, &stream->pending_offset);
+    stream->pending.size -= stream->consumed;
+    memmove(stream->pending.arr, stream->pending.arr + stream->consumed, stream->pending.size);
+    stream->consumed = 0;
+
+    CIRCUITC_array_push_string(&stream->pending, (void*)chunk, length_chunk);
+    CIRCUITC_lexer_stream_terminate(stream);
+}
+
+// signals that no more source will be pushed; the \x00 that follows the pending source becomes the end of the source
+void CIRCUITC_lexer_stream_finish(CIRCUITC_lexer_stream_t* stream){
+    stream->finished = true;
+}
+
+// the token at start runs into end, which is followed by more source yet to be pushed. a comment or a name or value that's longer than any symbol
+// (so that what it is is settled, and only where it ends isn't) saves where the next pull starts looking for its end; other tokens are lexed over again
+void CIRCUITC_lexer_stream_save_scan(CIRCUITC_lexer_stream_t* stream, const char* start, const char* end){
+    size_t length;
+    stream->scan = CIRCUITC_dfa_run(&stream->tokeniser.dfa, start, &length);
+    stream->scanned = 0;
+    if((size_t)(end - start) <= stream->tokeniser.longest_symbol) return;
+
+    switch(CIRCUITC_DFA_ACCEPT_KIND(stream->scan)){
+        case CIRCUITC_DFA_ACCEPT_COMMENT:{
+// a closing symbol cut in two by end starts within its length - 1 bytes of it; the scan goes back over those
+            const size_t length_closing_comment_symbol = strlen(CIRCUITC_comments_end[CIRCUITC_DFA_ACCEPT_TOKEN(stream->scan)]);
+            stream->scanned = NOAHZK_MAX(length, (size_t)(end - start) - (length_closing_comment_symbol - 1));
+            break;
+        }
+        case CIRCUITC_DFA_ACCEPT_NAME:
+        case CIRCUITC_DFA_ACCEPT_VALUE:
+            stream->scanned = end - start;
+            break;
+        default:
+            break;
+    }
+}
+
+// carries on with the scan saved for the partial token at start; returns whether it still runs into end, saving where the scan got to if so.
+// the scan only decides when the token is lexed, which is always from its start, so where a token ends never depends on where a chunk did
+bool CIRCUITC_lexer_stream_resume_scan(CIRCUITC_lexer_stream_t* stream, char* start, const char* end){
+    char* string = start + stream->scanned;
+
+    if(CIRCUITC_DFA_ACCEPT_KIND(stream->scan) == CIRCUITC_DFA_ACCEPT_COMMENT) string = CIRCUITC_tokeniser_comment_skip(string, &stream->tokeniser, CIRCUITC_DFA_ACCEPT_TOKEN(stream->scan));
+    else string += stream->tokeniser.scan.alphanumeric(string);
+    if(string < end) return false;
+
+    CIRCUITC_lexer_stream_save_scan(stream, start, end);
+    return true;
+}
+
+// lexes up to max_tokens tokens of what has been pushed so far, appending them to batch. returns number of tokens appended;
+// 0 means more source has to be pushed (or the stream has to be finished), or that CIRCUITC_TOKEN_EOF has already been pulled.
+// on error, returns tokens appended before the one that caused it, sets error_code, and leaves current_line and current_offset of stream pointing at said token.
+size_t CIRCUITC_lexer_stream_pull(CIRCUITC_lexer_stream_t* stream, CIRCUITC_array_t* batch, const size_t max_tokens, CIRCUITC_lexer_error_t* error_code){
+    char* const end = stream->pending.arr + stream->pending.size;
+    size_t tokens = 0;
+
+    *error_code = CIRCUITC_LEXER_ERROR_NONE;
+    while(tokens < max_tokens && !stream->done){
+        char* const start = stream->pending.arr + stream->consumed;
+        char* string = start;
+        const size_t batch_size = batch->size;
+        CIRCUITC_token_t token;
+
+        if(stream->scanned && !stream->finished && CIRCUITC_lexer_stream_resume_scan(stream, start, end)) break;
+        stream->scanned = 0;
+
+        const CIRCUITC_lexer_error_t step_error_code = CIRCUITC_lexer_step(batch, &string, stream->pending.arr, CIRCUITC_lexer_copy_names, &stream->tokeniser, &token);
+// the token is final only if the bytes the tokeniser looked at to decide on it are all source rather than the \x00 that ends what has been pushed so far
+        if(!stream->finished && (string >= end || (size_t)(end - start) <= stream->tokeniser.longest_symbol)){
+            batch->size = batch_size;
+            if(string >= end) CIRCUITC_lexer_stream_save_scan(stream, start, end);
+            break;
+        }
+        if(step_error_code != CIRCUITC_LEXER_ERROR_NONE){
+            batch->size = batch_size;
+            *error_code = step_error_code;
+
+            stream->current_line = stream->pending_line;
+            stream->current_offset = stream->pending_offset;
+            CIRCUITC_lines_advance(stream->pending.arr, start - stream->pending.arr, &stream->current_line, &stream->current_offset);
+            break;
+        }
+
+        stream->consumed = string - stream->pending.arr;
+        stream->done = token == CIRCUITC_TOKEN_EOF;
+        tokens++;
+    }
+
+    return tokens;
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef CIRCUITC_lines_included
+#define CIRCUITC_lines_included
+
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+
+// line index of a source: where every newline in it is, so that an offset into the source can be turned into the line it's on and its offset from the last newline
+// (both counted from 0, as the lexer reports them) by a binary search over the newlines.
+// the lexer only ever keeps track of where it is in bytes from the start of the source; lines are only needed once something has to be reported to a human,
+// so they're only worked out then: through CIRCUITC_lines_advance for a single position, or through an index for tools that look up many.
+// newlines are found 16 or 32 bytes at a time on x86, through the fastest kernels the CPU supports; the kernels never load past the length they're given,
+// so the source needn't be terminated, and just a prefix of it can be looked at.
+
+typedef struct{
+    size_t* newlines;                   // offset of every '\n' in source, in order
+    size_t size;                        // newlines in source
+    size_t capacity;                    // newlines allocated
+} CIRCUITC_lines_t;
+
+typedef enum{ CIRCUITC_lines_keep_ctx, CIRCUITC_lines_free_ctx } CIRCUITC_lines_options_t;
+
+#define CIRCUITC_LINES_NEWLINE '\n'
+
+// growth factor of 1.5, as for dynamic arrays
+void CIRCUITC_lines_push(CIRCUITC_lines_t* lines, const size_t newline){
+    if(lines->size == lines->capacity){
+        lines->capacity = lines->capacity*3/2;
+        lines->newlines = realloc(lines->newlines, lines->capacity*sizeof(*lines->newlines));
+    }
+
+    lines->newlines[lines->size++] = newline;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CIRCUITC_LINES_X86
+#include "immintrin.h"          // SSE2, AVX2 intrinsics
+
+// the vector kernels work on the whole blocks at the start of string and return how many bytes they went through, the rest being left to the scalar loops.
+// count kernels add the newlines they find to *newlines and, if there's any, set *line_start to the offset right after the last one
+
+__attribute__((target("sse2"))) size_t CIRCUITC_lines_index_sse2(CIRCUITC_lines_t* lines, const char* source, const size_t length){
+    size_t done = 0;
+
+    for(; length - done >= 16; done += 16){
+        uint32_t newline_mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(source + done)), _mm_set1_epi8(CIRCUITC_LINES_NEWLINE)));
+        for(; newline_mask; newline_mask &= newline_mask - 1) CIRCUITC_lines_push(lines, done + __builtin_ctz(newline_mask));
+    }
+
+    return done;
+}
+
+__attribute__((target("sse2"))) size_t CIRCUITC_lines_count_sse2(const char* string, const size_t length, size_t* newlines, size_t* line_start){
+    size_t done = 0;
+
+    for(; length - done >= 16; done += 16){
+        const uint32_t newline_mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(string + done)), _mm_set1_epi8(CIRCUITC_LINES_NEWLINE)));
+        if(newline_mask){
+            *newlines += __builtin_popcount(newline_mask);
+            *line_start = done + (31 - __builtin_clz(newline_mask)) + 1;
+        }
+    }
+
+    return done;
+}
+
+__attribute__((target("avx2"))) size_t CIRCUITC_lines_index_avx2(CIRCUITC_lines_t* lines, const char* source, const size_t length){
+    size_t done = 0;
+
+    for(; length - done >= 32; done += 32){
+        uint32_t newline_mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(source + done)), _mm256_set1_epi8(CIRCUITC_LINES_NEWLINE)));
+        for(; newline_mask; newline_mask &= newline_mask - 1) CIRCUITC_lines_push(lines, done + __builtin_ctz(newline_mask));
+    }
+
+    return done;
+}
+
+__attribute__((target("avx2"))) size_t CIRCUITC_lines_count_avx2(const char* string, const size_t length, size_t* newlines, size_t* line_start){
+    size_t done = 0;
+
+    for(; length - done >= 32; done += 32){
+        const uint32_t newline_mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(string + done)), _mm256_set1_epi8(CIRCUITC_LINES_NEWLINE)));
+        if(newline_mask){
+            *newlines += __builtin_popcount(newline_mask);
+            *line_start = done + (31 - __builtin_clz(newline_mask)) + 1;
+        }
+    }
+
+    return done;
+}
+#endif
+
+// indexes the newlines in the length bytes at source; the index has to be destroyed by user
+CIRCUITC_lines_t* CIRCUITC_lines_init(CIRCUITC_lines_t* lines, const char* source, const size_t length){
+    const size_t initial_capacity = 256;
+    size_t done = 0;
+
+    if(!lines) lines = malloc(sizeof(*lines));
+
+    lines->size = 0;
+    lines->capacity = initial_capacity;
+    lines->newlines = malloc(lines->capacity*sizeof(*lines->newlines));
+
+#ifdef CIRCUITC_LINES_X86
+    if(__builtin_cpu_supports("avx2")) done = CIRCUITC_lines_index_avx2(lines, source, length);
+    else if(__builtin_cpu_supports("sse2")) done = CIRCUITC_lines_index_sse2(lines, source, length);
+#endif
+    for(; done < length; done++)
+        if(source[done] == CIRCUITC_LINES_NEWLINE) CIRCUITC_lines_push(lines, done);
+
+    return lines;
+}
+
+void CIRCUITC_lines_destroy(CIRCUITC_lines_t* lines, CIRCUITC_lines_options_t freectx){
+    free(lines->newlines);
+
+    if(freectx == CIRCUITC_lines_free_ctx) free(lines);
+}
+
+// line the byte at offset is on, that is, how many newlines come before it; a newline is on the line it ends
+size_t CIRCUITC_lines_line(const CIRCUITC_lines_t* lines, const size_t offset){
+    size_t low = 0, high = lines->size;
+
+    while(low < high){
+        const size_t middle = low + (high - low)/2;
+        if(lines->newlines[middle] < offset) low = middle + 1;
+        else high = middle;
+    }
+
+    return low;
+}
+
+// line the byte at offset is on, and its offset from the last newline before it
+void CIRCUITC_lines_position(const CIRCUITC_lines_t* lines, const size_t offset, size_t* line, size_t* line_offset){
+    *line = CIRCUITC_lines_line(lines, offset);
+    *line_offset = *line? offset - lines->newlines[*line - 1] - 1: offset;
+}
+
+// given the line string starts on and its offset from the last newline, moves both past the length bytes of string, without indexing anything.
+// this is what a one-off lookup takes, as well as what keeps track of lines across source that isn't kept around
+void CIRCUITC_lines_advance(const char* string, const size_t length, size_t* line, size_t* line_offset){
+    size_t newlines = 0, line_start = 0, done = 0;
+
+#ifdef CIRCUITC_LINES_X86
+    if(__builtin_cpu_supports("avx2")) done = CIRCUITC_lines_count_avx2(string, length, &newlines, &line_start);
+    else if(__builtin_cpu_supports("sse2")) done = CIRCUITC_lines_count_sse2(string, length, &newlines, &line_start);
+#endif
+    for(; done < length; done++)
+        if(string[done] == CIRCUITC_LINES_NEWLINE){
+            newlines++;
+            line_start = done + 1;
+        }
+
+    *line += newlines;
+    *line_offset = newlines? length - line_start: *line_offset + length;
+}
+
+#endif
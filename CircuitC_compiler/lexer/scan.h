@@ -0,0 +1,236 @@
+#ifndef CIRCUITC_scan_included
+#define CIRCUITC_scan_included
+
+#include "stdbool.h"            // boolean type
+#include "stdint.h"             // types
+#include "stdlib.h"             // malloc
+#include "tokens.h"             // whitespace definitions
+
+// kernels that find where a run of bytes of the same kind ends.
+// the tokeniser spends most of its time in whitespace, comments and names, all of which are long runs of bytes that the DFA has nothing to decide about.
+// every kernel has a scalar version and, on x86, SSE2 and AVX2 versions working on 16 or 32 bytes at a time; CIRCUITC_scan_init picks the best one the CPU supports.
+//
+// the vector kernels only ever load aligned blocks, so they may read past the \x00 that terminates string but never past the page it lies in.
+// none of the kernels count the \x00 as part of any run.
+//
+// the kernels don't keep track of lines: the lexer only keeps track of where it is in bytes, and lines are worked out from those when needed (see lines.h).
+// newline ~ set if the run of whitespaces holds a '\n'
+
+typedef struct{
+    size_t (*whitespace)(const char* string, bool* newline);            // length of run of whitespaces in CIRCUITC_whitespaces
+    size_t (*alphanumeric)(const char* string);                         // length of run of [a-zA-Z0-9]
+    size_t (*until)(const char* string, const char character);          // length of run that doesn't hold character nor \x00
+} CIRCUITC_scan_t;
+
+#define CIRCUITC_SCAN_NEWLINE '\n'
+
+// number of whitespaces other than \x00 (which ends a string rather than being part of a run); \x00 is always the last whitespace
+#define CIRCUITC_SCAN_WHITESPACES (sizeof(CIRCUITC_whitespaces)/sizeof(*CIRCUITC_whitespaces) - 1)
+
+bool CIRCUITC_scan_is_whitespace(const char character){
+    for(size_t i = 0; i < CIRCUITC_SCAN_WHITESPACES; i++)
+        if(character == CIRCUITC_whitespaces[i].symbol[0]) return true;
+    return false;
+}
+
+size_t CIRCUITC_scan_whitespace_scalar(const char* string, bool* newline){
+    size_t length = 0;
+    for(; CIRCUITC_scan_is_whitespace(string[length]); length++) *newline |= string[length] == CIRCUITC_SCAN_NEWLINE;
+    return length;
+}
+
+size_t CIRCUITC_scan_alphanumeric_scalar(const char* string){
+    size_t length = 0;
+    while(('0' <= string[length] && string[length] <= '9') || ('A' <= (string[length] &~0x20) && (string[length] &~0x20) <= 'Z')) length++;
+    return length;
+}
+
+size_t CIRCUITC_scan_until_scalar(const char* string, const char character){
+    size_t length = 0;
+    while(string[length] && string[length] != character) length++;
+    return length;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "immintrin.h"          // SSE2, AVX2 intrinsics
+
+// the aligned loads past \x00 are fine as far as the page is concerned, but not as far as AddressSanitizer is concerned
+#define CIRCUITC_SCAN_OVERREADS __attribute__((no_sanitize_address))
+
+// every block is 16-byte aligned; the bytes of the first block that come before string are masked off
+#define CIRCUITC_SCAN_BLOCK_SSE2 16
+
+__attribute__((target("sse2"))) __m128i CIRCUITC_scan_whitespace_block_sse2(const __m128i block){
+    __m128i mask = _mm_setzero_si128();
+    for(size_t i = 0; i < CIRCUITC_SCAN_WHITESPACES; i++) mask = _mm_or_si128(mask, _mm_cmpeq_epi8(block, _mm_set1_epi8(CIRCUITC_whitespaces[i].symbol[0])));
+    return mask;
+}
+
+// x in [lo, hi] as an unsigned range check done through a signed compare
+__attribute__((target("sse2"))) __m128i CIRCUITC_scan_in_range_sse2(const __m128i block, const char lo, const char hi){
+    const __m128i biased = _mm_add_epi8(block, _mm_set1_epi8((char)(0x80 - lo)));
+    return _mm_cmplt_epi8(biased, _mm_set1_epi8((char)(0x80 + hi - lo + 1)));
+}
+
+__attribute__((target("sse2"))) __m128i CIRCUITC_scan_alphanumeric_block_sse2(const __m128i block){
+    const __m128i lowercase = _mm_or_si128(block, _mm_set1_epi8(0x20));
+    return _mm_or_si128(CIRCUITC_scan_in_range_sse2(block, '0', '9'), CIRCUITC_scan_in_range_sse2(lowercase, 'a', 'z'));
+}
+
+CIRCUITC_SCAN_OVERREADS __attribute__((target("sse2"))) size_t CIRCUITC_scan_whitespace_sse2(const char* string, bool* newline){
+    const size_t misalignment = (uintptr_t)string % CIRCUITC_SCAN_BLOCK_SSE2;
+    const char* block_start = string - misalignment;
+    uint32_t skipped = (1U << misalignment) - 1;                       // bits of bytes before string
+    uint32_t newlines = 0;                                              // bits of newlines in run
+    size_t length = 0;
+
+    for(;; block_start += CIRCUITC_SCAN_BLOCK_SSE2, skipped = 0){
+        const __m128i block = _mm_load_si128((const __m128i*)block_start);
+        const uint32_t in_run = (uint32_t)_mm_movemask_epi8(CIRCUITC_scan_whitespace_block_sse2(block)) | skipped;
+        const uint32_t newline_mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(CIRCUITC_SCAN_NEWLINE)));
+// first byte not in run; the extra bit above the block stops __builtin_ctz from being passed 0
+        const uint32_t end = __builtin_ctz(~in_run | 1U << CIRCUITC_SCAN_BLOCK_SSE2);
+
+        newlines |= newline_mask & ((1U << end) - 1) & ~skipped;
+        length += end - __builtin_popcount(skipped);
+        if(end != CIRCUITC_SCAN_BLOCK_SSE2) break;
+    }
+
+    *newline |= newlines != 0;
+    return length;
+}
+
+CIRCUITC_SCAN_OVERREADS __attribute__((target("sse2"))) size_t CIRCUITC_scan_alphanumeric_sse2(const char* string){
+    const size_t misalignment = (uintptr_t)string % CIRCUITC_SCAN_BLOCK_SSE2;
+    const char* block_start = string - misalignment;
+    uint32_t skipped = (1U << misalignment) - 1;
+    size_t length = 0;
+
+    for(;; block_start += CIRCUITC_SCAN_BLOCK_SSE2, skipped = 0){
+        const __m128i block = _mm_load_si128((const __m128i*)block_start);
+        const uint32_t in_run = (uint32_t)_mm_movemask_epi8(CIRCUITC_scan_alphanumeric_block_sse2(block)) | skipped;
+        const uint32_t end = __builtin_ctz(~in_run | 1U << CIRCUITC_SCAN_BLOCK_SSE2);
+
+        length += end - __builtin_popcount(skipped);
+        if(end != CIRCUITC_SCAN_BLOCK_SSE2) return length;
+    }
+}
+
+CIRCUITC_SCAN_OVERREADS __attribute__((target("sse2"))) size_t CIRCUITC_scan_until_sse2(const char* string, const char character){
+    const size_t misalignment = (uintptr_t)string % CIRCUITC_SCAN_BLOCK_SSE2;
+    const char* block_start = string - misalignment;
+    uint32_t skipped = (1U << misalignment) - 1;
+    size_t length = 0;
+
+    for(;; block_start += CIRCUITC_SCAN_BLOCK_SSE2, skipped = 0){
+        const __m128i block = _mm_load_si128((const __m128i*)block_start);
+        const __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(character)), _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+        const uint32_t in_run = ~(uint32_t)_mm_movemask_epi8(stop) | skipped;
+        const uint32_t end = __builtin_ctz(~in_run | 1U << CIRCUITC_SCAN_BLOCK_SSE2);
+
+        length += end - __builtin_popcount(skipped);
+        if(end != CIRCUITC_SCAN_BLOCK_SSE2) return length;
+    }
+}
+
+#define CIRCUITC_SCAN_BLOCK_AVX2 32
+
+__attribute__((target("avx2"))) __m256i CIRCUITC_scan_whitespace_block_avx2(const __m256i block){
+    __m256i mask = _mm256_setzero_si256();
+    for(size_t i = 0; i < CIRCUITC_SCAN_WHITESPACES; i++) mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(CIRCUITC_whitespaces[i].symbol[0])));
+    return mask;
+}
+
+__attribute__((target("avx2"))) __m256i CIRCUITC_scan_in_range_avx2(const __m256i block, const char lo, const char hi){
+    const __m256i biased = _mm256_add_epi8(block, _mm256_set1_epi8((char)(0x80 - lo)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + hi - lo + 1)), biased);
+}
+
+__attribute__((target("avx2"))) __m256i CIRCUITC_scan_alphanumeric_block_avx2(const __m256i block){
+    const __m256i lowercase = _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+    return _mm256_or_si256(CIRCUITC_scan_in_range_avx2(block, '0', '9'), CIRCUITC_scan_in_range_avx2(lowercase, 'a', 'z'));
+}
+
+// same as the SSE2 versions, but with 32-byte blocks; 64-bit masks are used so that the bit above the block can be set
+CIRCUITC_SCAN_OVERREADS __attribute__((target("avx2"))) size_t CIRCUITC_scan_whitespace_avx2(const char* string, bool* newline){
+    const size_t misalignment = (uintptr_t)string % CIRCUITC_SCAN_BLOCK_AVX2;
+    const char* block_start = string - misalignment;
+    uint32_t skipped = (uint32_t)((1ULL << misalignment) - 1);
+    uint32_t newlines = 0;                                              // bits of newlines in run
+    size_t length = 0;
+
+    for(;; block_start += CIRCUITC_SCAN_BLOCK_AVX2, skipped = 0){
+        const __m256i block = _mm256_load_si256((const __m256i*)block_start);
+        const uint32_t in_run = (uint32_t)_mm256_movemask_epi8(CIRCUITC_scan_whitespace_block_avx2(block)) | skipped;
+        const uint32_t newline_mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(CIRCUITC_SCAN_NEWLINE)));
+        const uint32_t end = __builtin_ctzll(~(uint64_t)in_run);
+
+        newlines |= newline_mask & (uint32_t)((1ULL << end) - 1) & ~skipped;
+        length += end - __builtin_popcount(skipped);
+        if(end != CIRCUITC_SCAN_BLOCK_AVX2) break;
+    }
+
+    *newline |= newlines != 0;
+    return length;
+}
+
+CIRCUITC_SCAN_OVERREADS __attribute__((target("avx2"))) size_t CIRCUITC_scan_alphanumeric_avx2(const char* string){
+    const size_t misalignment = (uintptr_t)string % CIRCUITC_SCAN_BLOCK_AVX2;
+    const char* block_start = string - misalignment;
+    uint32_t skipped = (uint32_t)((1ULL << misalignment) - 1);
+    size_t length = 0;
+
+    for(;; block_start += CIRCUITC_SCAN_BLOCK_AVX2, skipped = 0){
+        const __m256i block = _mm256_load_si256((const __m256i*)block_start);
+        const uint32_t in_run = (uint32_t)_mm256_movemask_epi8(CIRCUITC_scan_alphanumeric_block_avx2(block)) | skipped;
+        const uint32_t end = __builtin_ctzll(~(uint64_t)in_run);
+
+        length += end - __builtin_popcount(skipped);
+        if(end != CIRCUITC_SCAN_BLOCK_AVX2) return length;
+    }
+}
+
+CIRCUITC_SCAN_OVERREADS __attribute__((target("avx2"))) size_t CIRCUITC_scan_until_avx2(const char* string, const char character){
+    const size_t misalignment = (uintptr_t)string % CIRCUITC_SCAN_BLOCK_AVX2;
+    const char* block_start = string - misalignment;
+    uint32_t skipped = (uint32_t)((1ULL << misalignment) - 1);
+    size_t length = 0;
+
+    for(;; block_start += CIRCUITC_SCAN_BLOCK_AVX2, skipped = 0){
+        const __m256i block = _mm256_load_si256((const __m256i*)block_start);
+        const __m256i stop = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(character)), _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+        const uint32_t in_run = ~(uint32_t)_mm256_movemask_epi8(stop) | skipped;
+        const uint32_t end = __builtin_ctzll(~(uint64_t)in_run);
+
+        length += end - __builtin_popcount(skipped);
+        if(end != CIRCUITC_SCAN_BLOCK_AVX2) return length;
+    }
+}
+#endif
+
+// picks fastest kernels supported by the CPU that's running this
+CIRCUITC_scan_t* CIRCUITC_scan_init(CIRCUITC_scan_t* scan){
+    if(!scan) scan = malloc(sizeof(*scan));
+
+    scan->whitespace   = CIRCUITC_scan_whitespace_scalar;
+    scan->alphanumeric = CIRCUITC_scan_alphanumeric_scalar;
+    scan->until        = CIRCUITC_scan_until_scalar;
+
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        scan->whitespace   = CIRCUITC_scan_whitespace_avx2;
+        scan->alphanumeric = CIRCUITC_scan_alphanumeric_avx2;
+        scan->until        = CIRCUITC_scan_until_avx2;
+    }
+    else if(__builtin_cpu_supports("sse2")){
+        scan->whitespace   = CIRCUITC_scan_whitespace_sse2;
+        scan->alphanumeric = CIRCUITC_scan_alphanumeric_sse2;
+        scan->until        = CIRCUITC_scan_until_sse2;
+    }
+#endif
+
+    return scan;
+}
+
+#endif
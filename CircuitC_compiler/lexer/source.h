@@ -0,0 +1,67 @@
+#ifndef CIRCUITC_source_included
+#define CIRCUITC_source_included
+
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "fcntl.h"              // open
+#include "unistd.h"             // close
+#include "sys/mman.h"           // mmap
+#include "sys/stat.h"           // fstat
+
+// CircuitC source file mapped into memory instead of read into a heap buffer.
+// the lexer needs its input to end with \x00, so the mapping is one byte longer than the file:
+// an anonymous zero-filled mapping is reserved first and the file is then mapped over it. the byte past the end of the file is either
+// in the zero-filled tail of the file's last page or in the anonymous page that follows it, so the string is terminated without copying anything,
+// and the page holding \x00 is always mapped (which the vector scanning kernels rely on).
+
+typedef struct{
+    char* string;               // contents of file, followed by \x00
+    size_t length;              // bytes in file
+    size_t mapping_length;      // bytes mapped
+} CIRCUITC_source_t;
+
+typedef enum{ CIRCUITC_source_keep_ctx, CIRCUITC_source_free_ctx } CIRCUITC_source_options_t;
+
+// maps file at path into source; returns NULL if it can't be opened or mapped
+CIRCUITC_source_t* CIRCUITC_source_map(CIRCUITC_source_t* source, const char* path){
+    const int file = open(path, O_RDONLY);
+    if(file < 0) return NULL;
+
+    struct stat file_status;
+    if(fstat(file, &file_status) < 0){
+        close(file);
+        return NULL;
+    }
+
+    const size_t length = file_status.st_size;
+    const size_t mapping_length = length + 1;
+
+    char* string = mmap(NULL, mapping_length, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(string == MAP_FAILED){
+        close(file);
+        return NULL;
+    }
+// mmap doesn't accept empty mappings; an empty file is just the \x00
+    if(length && mmap(string, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, file, 0) == MAP_FAILED){
+        munmap(string, mapping_length);
+        close(file);
+        return NULL;
+    }
+    close(file);                // the mapping keeps the file alive
+    madvise(string, mapping_length, MADV_SEQUENTIAL);
+
+    if(!source) source = malloc(sizeof(*source));
+    source->string = string;
+    source->length = length;
+    source->mapping_length = mapping_length;
+
+    return source;
+}
+
+void CIRCUITC_source_unmap(CIRCUITC_source_t* source, CIRCUITC_source_options_t freectx){
+    munmap(source->string, source->mapping_length);
+
+    if(freectx == CIRCUITC_source_free_ctx) free(source);
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef CIRCUITC_token_table_included
+#define CIRCUITC_token_table_included
+
+#include "stdlib.h"             // dynamic memory operations
+#include "stdint.h"             // types
+#include "interner.h"           // name IDs
+#include "dynamic_arrays.h"     // dynamic array type & operations
+#include "lexer.h"              // lexing single tokens
+#include "lines.h"              // token offsets into lines
+
+// token table: the lexer's output as a struct of arrays rather than as a string of tokens.
+// token i is kinds[i], spans source[starts[i] .. starts[i] + lengths[i]), and has payload payloads[i]:
+//      - names: ID the interner gave the name; every occurrence of the same name gets the same ID, and the name itself is stored only once
+//      - values: index of the value in the literal pool, which holds the bytes CIRCUITC_lexer_put_value produces for it
+//      - anything else: 0
+// every token is the same size, so tokens can be indexed and skipped without decoding the ones before them,
+// and passes that only look at (say) kinds only ever touch the kinds column.
+//
+// whitespaces and comments carry no meaning past the lexer and aren't stored; newlines are, as they're needed to tell where a statement ends.
+// the table ends with CIRCUITC_TOKEN_EOF just as the string of tokens does.
+// tokens only know where they start in bytes; the line a token is on is looked up through a line index of the source, built the first time one is asked for.
+
+typedef struct{
+    CIRCUITC_token_t* kinds;
+    size_t* starts;                     // offset of token from start of source
+    uint32_t* lengths;                  // bytes of source the token spans
+    uint32_t* payloads;
+    size_t size;                        // tokens stored
+    size_t capacity;                    // tokens allocated
+
+    CIRCUITC_interner_t names;
+
+    CIRCUITC_array_t literals;          // bytes of all values, one after the other
+    CIRCUITC_array_t literal_ends;      // size_t past end of every value within literals
+    uint32_t number_of_literals;
+
+    CIRCUITC_lines_t lines;             // line index of source, built by CIRCUITC_token_table_position; newlines is NULL until then
+} CIRCUITC_token_table_t;
+
+typedef enum{ CIRCUITC_token_table_keep_ctx, CIRCUITC_token_table_free_ctx } CIRCUITC_token_table_options_t;
+
+CIRCUITC_token_table_t* CIRCUITC_token_table_init(CIRCUITC_token_table_t* table){
+    const size_t initial_capacity = 256;
+
+    if(!table) table = malloc(sizeof(*table));
+
+    table->size = 0;
+    table->capacity = initial_capacity;
+    table->kinds    = malloc(table->capacity*sizeof(*table->kinds));
+    table->starts   = malloc(table->capacity*sizeof(*table->starts));
+    table->lengths  = malloc(table->capacity*sizeof(*table->lengths));
+    table->payloads = malloc(table->capacity*sizeof(*table->payloads));
+
+    CIRCUITC_interner_init(&table->names);
+
+    CIRCUITC_array_init(&table->literals);
+    CIRCUITC_array_init(&table->literal_ends);
+    table->number_of_literals = 0;
+
+    table->lines.newlines = NULL;
+
+    return table;
+}
+
+void CIRCUITC_token_table_destroy(CIRCUITC_token_table_t* table, CIRCUITC_token_table_options_t freectx){
+    free(table->kinds);
+    free(table->starts);
+    free(table->lengths);
+    free(table->payloads);
+    CIRCUITC_interner_destroy(&table->names, CIRCUITC_interner_keep_ctx);
+
+    CIRCUITC_array_destroy(&table->literals, CIRCUITC_array_keep_ctx);
+    CIRCUITC_array_destroy(&table->literal_ends, CIRCUITC_array_keep_ctx);
+    if(table->lines.newlines) CIRCUITC_lines_destroy(&table->lines, CIRCUITC_lines_keep_ctx);
+
+    if(freectx == CIRCUITC_token_table_free_ctx) free(table);
+}
+
+// growth factor of 1.5, as for dynamic arrays
+void CIRCUITC_token_table_push(CIRCUITC_token_table_t* table, const CIRCUITC_token_t kind, const size_t start, const uint32_t length, const uint32_t payload){
+    if(table->size == table->capacity){
+        table->capacity = table->capacity*3/2;
+        table->kinds    = realloc(table->kinds,    table->capacity*sizeof(*table->kinds));
+        table->starts   = realloc(table->starts,   table->capacity*sizeof(*table->starts));
+        table->lengths  = realloc(table->lengths,  table->capacity*sizeof(*table->lengths));
+        table->payloads = realloc(table->payloads, table->capacity*sizeof(*table->payloads));
+    }
+
+    table->kinds[table->size]    = kind;
+    table->starts[table->size]   = start;
+    table->lengths[table->size]  = length;
+    table->payloads[table->size] = payload;
+    table->size++;
+}
+
+// returns name with given ID, \x00 terminated
+const char* CIRCUITC_token_table_name(const CIRCUITC_token_table_t* table, const CIRCUITC_symbol_t name_id){
+    return CIRCUITC_interner_string(&table->names, name_id);
+}
+
+// returns bytes of literal with given index, and sets literal_length to how many there are
+const void* CIRCUITC_token_table_literal(const CIRCUITC_token_table_t* table, const uint32_t literal_index, size_t* literal_length){
+    const size_t* ends = (size_t*)table->literal_ends.arr;
+    const size_t start = literal_index? ends[literal_index - 1]: 0;
+
+    *literal_length = ends[literal_index] - start;
+    return table->literals.arr + start;
+}
+
+// line token is on, and its offset from the last newline before it. source is the one table was lexed from;
+// the first call indexes the lines of all of it (up to CIRCUITC_TOKEN_EOF), which every call after that does a binary search through
+void CIRCUITC_token_table_position(CIRCUITC_token_table_t* table, const char* source, const size_t token, size_t* line, size_t* offset){
+    if(!table->lines.newlines) CIRCUITC_lines_init(&table->lines, source, table->starts[table->size - 1]);
+    CIRCUITC_lines_position(&table->lines, table->starts[token], line, offset);
+}
+
+// lexes a single token off string into table, advancing string past it; see CIRCUITC_lexer_step
+CIRCUITC_lexer_error_t CIRCUITC_lexer_table_step(CIRCUITC_token_table_t* table, char** string, const char* source, CIRCUITC_tokeniser_t* tokeniser, CIRCUITC_token_t* token){
+    const size_t start = *string - source;
+    size_t nameval_token_length = 0;
+    *token = CIRCUITC_token_get(string, tokeniser, &nameval_token_length);
+
+    if(*token == CIRCUITC_TOKEN_NAME){
+        CIRCUITC_token_table_push(table, *token, start, nameval_token_length, CIRCUITC_interner_intern(&table->names, *string, nameval_token_length));
+        *string += nameval_token_length;
+    }
+    else if(*token == CIRCUITC_TOKEN_VALUE){
+        const CIRCUITC_lexer_error_t error_code = CIRCUITC_lexer_put_value(&table->literals, string, nameval_token_length);
+        if(error_code != CIRCUITC_LEXER_ERROR_NONE) return error_code;
+
+        CIRCUITC_array_push_string(&table->literal_ends, &table->literals.size, sizeof(table->literals.size));
+        CIRCUITC_token_table_push(table, *token, start, nameval_token_length, table->number_of_literals++);
+    }
+// CIRCUITC_TOKEN_EOF spans no source, even though the tokeniser steps past the \x00
+    else if(*token == CIRCUITC_TOKEN_EOF) CIRCUITC_token_table_push(table, *token, start, 0, 0);
+    else if(*token != CIRCUITC_TOKEN_WHITESPACE) CIRCUITC_token_table_push(table, *token, start, *string - source - start, 0);
+
+    return CIRCUITC_LEXER_ERROR_NONE;
+}
+
+// given string of CircuitC code, lexes it into table (which is initialised here, allocated if NULL, and has to be destroyed by user) and returns table.
+// on error, table is destroyed and the error specifics are returned instead, as for CIRCUITC_lexer.
+void* CIRCUITC_lexer_table(char* string, CIRCUITC_token_table_t* table, CIRCUITC_lexer_error_t* error_code){
+    char* const source = string;
+    CIRCUITC_tokeniser_t tokeniser; CIRCUITC_tokeniser_init(&tokeniser);
+    CIRCUITC_token_t token;
+
+    const CIRCUITC_token_table_options_t freectx = table? CIRCUITC_token_table_keep_ctx: CIRCUITC_token_table_free_ctx;
+    table = CIRCUITC_token_table_init(table);
+
+    do{
+        char* const token_start = string;
+        *error_code = CIRCUITC_lexer_table_step(table, &string, source, &tokeniser, &token);
+        if(*error_code != CIRCUITC_LEXER_ERROR_NONE){
+            CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
+            CIRCUITC_token_table_destroy(table, freectx);
+            return CIRCUITC_lexer_error_specifics_init(NULL, source, token_start - source);
+        }
+    } while(token != CIRCUITC_TOKEN_EOF);
+
+    CIRCUITC_tokeniser_destroy(&tokeniser, CIRCUITC_tokeniser_keep_ctx);
+    return table;
+}
+
+#endif
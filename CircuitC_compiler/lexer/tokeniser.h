@@ -6,62 +6,63 @@
 #include "stdint.h"             // variable-width types
 #include "string.h"             // strstr
 #include "tokens.h"             // token type, tokens themselves
-#include "bst.h"                // binary search tree type & ops
+#include "dfa.h"                // transition table built from tokens
+#include "keyword_table.h"      // keywords that look like names
+#include "scan.h"               // run-scanning kernels
 
 // all tokens
 typedef struct{
-    CIRCUITC_tree_t* keywords;
-    CIRCUITC_tree_t* comments;
-    CIRCUITC_tree_t* whitespaces;
+    CIRCUITC_dfa_t dfa;
+    CIRCUITC_keyword_table_t keywords;
+    CIRCUITC_scan_t scan;
+    size_t longest_symbol;              // bytes in longest symbol; the tokeniser never looks further than this past the start of a symbol, save for runs
 } CIRCUITC_tokeniser_t;
 
 typedef enum{ CIRCUITC_tokeniser_keep_ctx, CIRCUITC_tokeniser_free_ctx } CIRCUITC_tokeniser_options_t;
 
+// bytes in longest symbol of definition; symbols hold at least one byte, so that "\x00" (EOF) counts as one
+size_t CIRCUITC_tokeniser_longest_symbol(const CIRCUITC_token_definition_t* definition, const uint64_t definition_size){
+    size_t longest_symbol = 0;
+    for(uint64_t i = 0; i < definition_size; i++){
+        const size_t length = strlen(definition[i].symbol);
+        if(length > longest_symbol) longest_symbol = length;
+    }
+    return longest_symbol? longest_symbol: 1;
+}
+
 CIRCUITC_tokeniser_t* CIRCUITC_tokeniser_init(CIRCUITC_tokeniser_t* ctx){
     if(!ctx) ctx = malloc(sizeof(*ctx));
 
-    ctx->keywords = CIRCUITC_token_keywords_init();
-    ctx->comments = CIRCUITC_token_comments_init();
-    ctx->whitespaces = CIRCUITC_token_whitespaces_init();
+    CIRCUITC_dfa_init(&ctx->dfa);
+    CIRCUITC_keyword_table_init(&ctx->keywords);
+    CIRCUITC_scan_init(&ctx->scan);
+
+    ctx->longest_symbol = CIRCUITC_tokeniser_longest_symbol(CIRCUITC_keywords, sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords));
+    const size_t longest_comment = CIRCUITC_tokeniser_longest_symbol(CIRCUITC_comments_begin, sizeof(CIRCUITC_comments_begin)/sizeof(*CIRCUITC_comments_begin));
+    if(longest_comment > ctx->longest_symbol) ctx->longest_symbol = longest_comment;
 
     return ctx;
 }
 
 void CIRCUITC_tokeniser_destroy(CIRCUITC_tokeniser_t* ctx, CIRCUITC_tokeniser_options_t freectx){
-    CIRCUITC_tree_destroy(ctx->keywords, CIRCUITC_tree_free_key);
-    CIRCUITC_tree_destroy(ctx->comments, CIRCUITC_tree_free_key);
-    CIRCUITC_tree_destroy(ctx->whitespaces, CIRCUITC_tree_free_key);
+    CIRCUITC_dfa_destroy(&ctx->dfa, CIRCUITC_dfa_keep_ctx);
+    CIRCUITC_keyword_table_destroy(&ctx->keywords, CIRCUITC_keyword_table_keep_ctx);
 
     if(freectx == CIRCUITC_tokeniser_free_ctx) free(ctx);
 }
 
-// counts number of occurrences of the character '\n' in the portion of string 'string' of length 'length_string'
-// also returns offset since newline
-size_t CIRCUITC_tokeniser_count_lines_skipped(char* string, size_t length_string, size_t* offset){
-    const char target = '\n';
-    size_t count = 0;
-
-    while(length_string--){
-        if(*string == target){
-            count++;
-            *offset = 0;
-        }
-        else (*offset)++;
-    }
-
-    return count;
-}
-
-// skips comment
-char* CIRCUITC_tokeniser_comment_skip(char* string, const CIRCUITC_token_t comment, size_t* lines_skipped, size_t* offset){
+// skips comment; string points right after the symbol that opened it.
+char* CIRCUITC_tokeniser_comment_skip(char* string, CIRCUITC_tokeniser_t* tokeniser, const CIRCUITC_token_t comment){
     const char* closing_comment_symbol = CIRCUITC_comments_end[comment];
+    const size_t length_closing_comment_symbol = strlen(closing_comment_symbol);
 
-    char* newstring = strstr(string, closing_comment_symbol);
-    if(newstring == NULL) return string + strlen(string);       // comment is closed by \x00; next call to CIRCUITC_token_get will return CIRCUITC_TOKEN_EOF and lexing will be halted
-// we want to count the number of lines skipped in said comment
-    *lines_skipped = CIRCUITC_tokeniser_count_lines_skipped(string, (size_t)(string - newstring), offset);
+    for(;; string++){
+        string += tokeniser->scan.until(string, closing_comment_symbol[0]);
+        if(*string == '\x00') return string;                   // comment is closed by \x00; next call to CIRCUITC_token_get will return CIRCUITC_TOKEN_EOF and lexing will be halted
+        if(strncmp(string, closing_comment_symbol, length_closing_comment_symbol) == 0) break;
+    }
 
-    return newstring + strlen(closing_comment_symbol);
+    return string + length_closing_comment_symbol;
 }
 
 char CIRCUITC_character_toupper(const char character){
@@ -77,106 +78,42 @@ bool CIRCUITC_tokeniser_REGEX_is_numeric(const char character){
     return 0x30 <= character && character <= 0x39;
 }
 
-// the regex being [a-zA-Z] or [a-zA-Z0-9] if 'position' is nonzero
-bool CIRCUITC_tokeniser_REGEX_alphanumeric_check(const char character, const size_t position){
-    return CIRCUITC_tokeniser_REGEX_is_alphabetic(character) || (CIRCUITC_tokeniser_REGEX_is_numeric(character) && position);
-}
-
-// returns length of largest substring whose start is 'string' that is accepted the following regex: [a-zA-Z][a-zA-Z0-9]*
-// if no string is accepted by said REGEX, it returns 0.
-size_t CIRCUITC_tokeniser_REGEX_alphanumeric_length(char* string){
-    size_t length = 0;
-    while(CIRCUITC_tokeniser_REGEX_alphanumeric_check(string[length], length)) length++;
-    return length;
-}
-
-// the regex being [0-9] or [a-zA-Z0-9] if 'position' is nonzero
-bool CIRCUITC_tokeniser_REGEX_numeric_check(const char character, const size_t position){
-    return (CIRCUITC_tokeniser_REGEX_is_alphabetic(character) && position) || CIRCUITC_tokeniser_REGEX_is_numeric(character);
-}
-
-// returns length of largest substring whose start is 'string' that is accepted the following regex:[0-9][a-zA-Z0-9]*
-// if no string is accepted by said REGEX, it returns 0.
-size_t CIRCUITC_tokeniser_REGEX_numeric_length(char* string){
-    size_t length = 0;
-    while(CIRCUITC_tokeniser_REGEX_numeric_check(string[length], length)) length++;
-    return length;
-}
-
-// parses operator, turns it into token if one exists, returns the value of token if one doesn't.
-CIRCUITC_token_t CIRCUITC_tokeniser_parse_operator(char** string, CIRCUITC_tokeniser_t* tokeniser, CIRCUITC_token_t token){
-    size_t operator_length = 1;
-    CIRCUITC_tree_error_code_t error_code;
-    CIRCUITC_token_t new_token = token;
-// pretty cool algorithm, tokenises arbitrarily-long operators. not that efficient but operators are usually short anyways.
-// by operators we mean any symbol that does not conform to the regex [A-Za-z][A-Za-z0-9]* or [0-9][A-Za-z0-9]*. this is stuff like ++, --, != et cetera
-// say we had three operators: !, != and !==. ! has the CIRCUITC_TOKEN_METADATA_EXTENDED flag set, so does !=.
-// !== doesn't, as there is no operator that is longer than it & that shares the starting sequence of symbols.
-// our algorithm cannot decompose the operator !== into ! and == tokens; this doesn't bother me right now.
-// it would decompose that into a != and an = token. one could define != as a special form of !== and be done with it.
-    do{
-        token = new_token;
-        new_token = CIRCUITC_tree_search(tokeniser->keywords, *string, operator_length++, &error_code);
-    } while(error_code == CIRCUITC_tree_no_error && CIRCUITC_TOKEN_METADATA_GET(new_token) == CIRCUITC_TOKEN_METADATA_EXTENDED);
-// because operator_length is always 2 larger than the effective operator
-    *string += operator_length - 2;
-    return token;
-}
-
-// parses statement
-CIRCUITC_token_t CIRCUITC_tokeniser_parse_statement(char** string, CIRCUITC_tokeniser_t* tokeniser, size_t* nameval_token_length){
-// checks if it is an alphanumeric string
-    size_t length = CIRCUITC_tokeniser_REGEX_alphanumeric_length(*string);
-
-    CIRCUITC_tree_error_code_t error_code; 
-    CIRCUITC_token_t token;
-
-    if(length){
-        token = CIRCUITC_tree_search(tokeniser->keywords, *string, length, &error_code);
-
-        if(error_code == CIRCUITC_tree_no_error){
-            *string += length;
-            return token;                                       // all strings accepted by regex in 'keywords' return the token they're assigned by 'keywords' here
-        } 
-
-        *nameval_token_length = length;                         // handles all function and variable names
-        return CIRCUITC_TOKEN_NAME;
-    } 
-// checks if it is an operator (+ - , et cetera)
-    token = CIRCUITC_tokeniser_parse_operator(string, tokeniser, CIRCUITC_TOKEN_EOF);
-    if(token != CIRCUITC_TOKEN_EOF) return token;               // CIRCUITC_tokeniser_parse_operator does not change the token it is passed if it finds no operator
-// it is therefore a number, and we check for its length
-    length = CIRCUITC_tokeniser_REGEX_numeric_length(*string);
-
-    *nameval_token_length = length;
-    return CIRCUITC_TOKEN_VALUE;
-}
-
 // from string, sees if it can be converted to token, does so if possible, returns new string (advanced).
-// nameval_token_length ~ ptr to size_t variable that holds length of byte string following <name> or <value> token in bytes, limited to 256.
+// nameval_token_length ~ ptr to size_t variable that holds length of byte string following <name> or <value> token in bytes.
 // undefined value if token is not CIRCUITC_TOKEN_NAME or CIRCUITC_TOKEN_VALUE.
-CIRCUITC_token_t CIRCUITC_token_get(char** string, CIRCUITC_tokeniser_t* tokeniser, size_t* lines_skipped, size_t* offset, size_t* nameval_token_length){
-// checks whether character is whitespace (all whitespaces are 1-char long)
-    CIRCUITC_tree_error_code_t error_code;
-    CIRCUITC_token_t cur_token = CIRCUITC_tree_search(tokeniser->whitespaces, *string, 1, &error_code);
-    if(error_code == CIRCUITC_tree_no_error){
-        if(cur_token == CIRCUITC_TOKEN_NEWLINE){ *lines_skipped = 1; *offset = 0; }
-
-        *offset += 1;
-        *string += 1;                                           // all whitespaces have length 1
-        return cur_token;                                       // whitespace -> return CIRCUITC_TOKEN_WHITESPACE, which is always ignored
-    } 
-// checks whether character is comment (all comments are 2-char long)
-    cur_token = CIRCUITC_tree_search(tokeniser->comments, *string, 2, &error_code);
-    if(error_code == CIRCUITC_tree_no_error){
-        *string = CIRCUITC_tokeniser_comment_skip(*string, cur_token, lines_skipped, offset);
-        return CIRCUITC_TOKEN_WHITESPACE;
+// no track is kept of lines: where a token is only matters once something has to be reported about it, and is then worked out from its offset (see lines.h).
+CIRCUITC_token_t CIRCUITC_token_get(char** string, CIRCUITC_tokeniser_t* tokeniser, size_t* nameval_token_length){
+    size_t length;
+    const CIRCUITC_dfa_accept_t accept = CIRCUITC_dfa_run(&tokeniser->dfa, *string, &length);
+    const CIRCUITC_token_t cur_token = CIRCUITC_DFA_ACCEPT_TOKEN(accept);
+
+    switch(CIRCUITC_DFA_ACCEPT_KIND(accept)){
+        case CIRCUITC_DFA_ACCEPT_WHITESPACE:
+            *string += 1;                                       // all whitespaces have length 1
+            return cur_token;                                   // whitespace -> return CIRCUITC_TOKEN_WHITESPACE, which is always ignored
+        case CIRCUITC_DFA_ACCEPT_COMMENT:
+            *string = CIRCUITC_tokeniser_comment_skip(*string + length, tokeniser, cur_token);
+            return CIRCUITC_TOKEN_WHITESPACE;
+        case CIRCUITC_DFA_ACCEPT_KEYWORD:
+            *string += length;
+            return cur_token;                                   // all strings in 'keywords' return the token they're assigned by 'keywords' here
+        case CIRCUITC_DFA_ACCEPT_NAME:
+        case CIRCUITC_DFA_ACCEPT_VALUE:
+            if(accept & CIRCUITC_DFA_ACCEPT_RUN) length += tokeniser->scan.alphanumeric(*string + length);
+// names may turn out to be keywords that look like names
+            CIRCUITC_token_t keyword;
+            if(cur_token == CIRCUITC_TOKEN_NAME && CIRCUITC_keyword_table_lookup(&tokeniser->keywords, *string, length, &keyword)){
+                *string += length;
+                return keyword;
+            }
+
+            *nameval_token_length = length;                     // the lexer advances string past names and values itself
+            return cur_token;
+        default:
+// no symbol starts with this character; it is handed to the lexer as a one-character value, which it rejects as wrongly formatted
+            *nameval_token_length = 1;
+            return CIRCUITC_TOKEN_VALUE;
     }
-// checks for character in keyword bst
-    cur_token = CIRCUITC_tokeniser_parse_statement(string, tokeniser, nameval_token_length);
-    *lines_skipped = 0;                                         // no lines are skipped as '\n' is not valid regex
-    *offset += *nameval_token_length;                           // offset is incremented by nameval_token_length for similar reasons
-    return cur_token;
 }
 
 #endif
@@ -75,25 +75,42 @@ const CIRCUITC_token_definition_t CIRCUITC_whitespaces[] = {
     {"\x00", CIRCUITC_TOKEN_EOF}                                    // end of file/human-readable string 0x00. DO NOT CHANGE!
 };
 
-CIRCUITC_tree_t* CIRCUITC_token_init(const CIRCUITC_token_definition_t* definition, const uint64_t definition_size){
+// builds tree of definitions, whose nodes are taken from arena (or malloc'd if arena is NULL)
+CIRCUITC_tree_t* CIRCUITC_token_init_from(CIRCUITC_arena_t* arena, const CIRCUITC_token_definition_t* definition, const uint64_t definition_size){
     CIRCUITC_tree_t* syntax_tree = NULL;
 // iterates over all syntax
     for(uint64_t i = 0; i < definition_size; i++)
-        CIRCUITC_tree_put(&syntax_tree, definition[i].symbol, definition[i].value);
+        CIRCUITC_tree_put_from(arena, &syntax_tree, definition[i].symbol, definition[i].value);
 
     return syntax_tree;
 }
 
+CIRCUITC_tree_t* CIRCUITC_token_init(const CIRCUITC_token_definition_t* definition, const uint64_t definition_size){
+    return CIRCUITC_token_init_from(NULL, definition, definition_size);
+}
+
+CIRCUITC_tree_t* CIRCUITC_token_keywords_init_from(CIRCUITC_arena_t* arena){
+    return CIRCUITC_token_init_from(arena, CIRCUITC_keywords, sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords));
+}
+
+CIRCUITC_tree_t* CIRCUITC_token_comments_init_from(CIRCUITC_arena_t* arena){
+    return CIRCUITC_token_init_from(arena, CIRCUITC_comments_begin, sizeof(CIRCUITC_comments_begin)/sizeof(*CIRCUITC_comments_begin));
+}
+
+CIRCUITC_tree_t* CIRCUITC_token_whitespaces_init_from(CIRCUITC_arena_t* arena){
+    return CIRCUITC_token_init_from(arena, CIRCUITC_whitespaces, sizeof(CIRCUITC_whitespaces)/sizeof(*CIRCUITC_whitespaces));
+}
+
 CIRCUITC_tree_t* CIRCUITC_token_keywords_init(){
-    return CIRCUITC_token_init(CIRCUITC_keywords, sizeof(CIRCUITC_keywords)/sizeof(*CIRCUITC_keywords));
+    return CIRCUITC_token_keywords_init_from(NULL);
 }
 
 CIRCUITC_tree_t* CIRCUITC_token_comments_init(){
-    return CIRCUITC_token_init(CIRCUITC_comments_begin, sizeof(CIRCUITC_comments_begin)/sizeof(*CIRCUITC_comments_begin));
+    return CIRCUITC_token_comments_init_from(NULL);
 }
 
 CIRCUITC_tree_t* CIRCUITC_token_whitespaces_init(){
-    return CIRCUITC_token_init(CIRCUITC_whitespaces, sizeof(CIRCUITC_whitespaces)/sizeof(*CIRCUITC_whitespaces));
+    return CIRCUITC_token_whitespaces_init_from(NULL);
 }
 
 #endif